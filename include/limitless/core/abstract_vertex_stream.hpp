@@ -1,6 +1,8 @@
 #pragma once
 
 namespace Limitless {
+    class Buffer;
+
     enum class VertexStreamUsage {
         Static,
         Dynamic,
@@ -28,5 +30,14 @@ namespace Limitless {
 
         virtual void draw_instanced(std::size_t count) noexcept = 0;
         virtual void draw_instanced(VertexStreamDraw draw, std::size_t count) noexcept = 0;
+
+        /**
+         * Draws instances with instance count taken from GPU memory
+         *
+         * command holds indirect draw command of 5 uints, stream writes its vertex or index count to the first one,
+         * instance count is read from the second one and usually written by compute shader
+         */
+        virtual void draw_instanced_indirect(Buffer& command) noexcept = 0;
+        virtual void draw_instanced_indirect(VertexStreamDraw draw, Buffer& command) noexcept = 0;
     };
 }
@@ -4,7 +4,9 @@
 
 #include <unordered_map>
 #include <stdexcept>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <memory>
 #include <mutex>
 #include <map>
@@ -20,16 +22,44 @@ namespace Limitless {
     public:
         enum class Type { UniformBuffer = GL_UNIFORM_BLOCK, ShaderStorage = GL_SHADER_STORAGE_BLOCK };
         using Identifier = std::pair<Type, std::string>;
+
+        /**
+         * Index of buffer name interned for the whole process
+         *
+         * programs are compiled on worker contexts and used on others, so the same name has the same handle in every context
+         */
+        using Handle = uint32_t;
     private:
         std::unordered_multimap<std::string, std::shared_ptr<Buffer>> buffers;
         std::unordered_map<Type, GLint> current_bind;
         std::map<Identifier, GLuint> bound;
+
+        /**
+         * Contains single buffer registered by handle name or null if there is none or several of them
+         *
+         * updated on add/remove of this context, so lookup by handle is just an index
+         */
+        std::vector<std::shared_ptr<Buffer>> resolved;
+
+        void resolve(const std::string& name);
     public:
         GLuint getBindingPoint(Type type, std::string_view name) noexcept;
 
         void add(std::string_view name, std::shared_ptr<Buffer> buffer) noexcept;
         void remove(const std::string& name, const std::shared_ptr<Buffer>& buffer);
         std::shared_ptr<Buffer> get(std::string_view name);
+
+        /**
+         * Gets handle of buffer name, buffer itself does not have to be added yet
+         */
+        [[nodiscard]] static Handle getHandle(std::string_view name);
+
+        /**
+         * Finds buffer by handle
+         *
+         * returns nullptr if there is no buffer or it is ambiguous
+         */
+        [[nodiscard]] Buffer* find(Handle handle) const noexcept;
     };
 
     struct IndexedBufferData {
@@ -37,9 +67,10 @@ namespace Limitless {
         std::string name;
         GLuint block_index;
         GLuint bound_point;
+        IndexedBuffer::Handle handle;
         bool index_connected {};
 
-        IndexedBufferData(IndexedBuffer::Type _target, std::string _name, GLuint _block_index, GLuint _bound_point)
-                : target{_target}, name{std::move(_name)}, block_index{_block_index}, bound_point{_bound_point} {}
+        IndexedBufferData(IndexedBuffer::Type _target, std::string _name, GLuint _block_index, GLuint _bound_point, IndexedBuffer::Handle _handle)
+                : target{_target}, name{std::move(_name)}, block_index{_block_index}, bound_point{_bound_point}, handle{_handle} {}
     };
 }
\ No newline at end of file
@@ -24,6 +24,9 @@ namespace Limitless {
         void bindAs(Type target) const noexcept override;
         void bind() const noexcept override;
 
+        TripleBuffer* clone() override;
+        void resize(size_t bytes) noexcept override;
+
         void fence() noexcept override;
         void waitFence() noexcept override;
 
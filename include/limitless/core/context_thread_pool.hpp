@@ -4,6 +4,12 @@
 #include <limitless/core/context.hpp>
 
 namespace Limitless {
+    /**
+     * ThreadPool which workers have hidden contexts shared with specified one
+     *
+     * commands of every task are flushed but not waited for,
+     * task should place Sync fence before objects it created are used by other context
+     */
     class ContextThreadPool : public ThreadPool {
     private:
         std::vector<Context> context_workers;
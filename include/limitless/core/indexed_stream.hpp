@@ -70,6 +70,26 @@ namespace Limitless {
             indices_buffer->fence();
         }
 
+        void draw_instanced_indirect(VertexStreamDraw mode, Buffer& command) noexcept override {
+            if (this->stream.empty()) {
+                return;
+            }
+
+            // DrawElementsIndirectCommand: count, instance count, first index, base vertex, base instance
+            const auto count = static_cast<uint32_t>(indices.size());
+            const std::array<uint32_t, 3> zeros {};
+            command.bufferSubData(0, sizeof(count), &count);
+            command.bufferSubData(2 * sizeof(uint32_t), sizeof(zeros), zeros.data());
+
+            this->vertex_array.bind();
+            command.bindAs(Buffer::Type::IndirectDraw);
+
+            glDrawElementsIndirect(static_cast<GLenum>(mode), GL_UNSIGNED_INT, nullptr);
+
+            this->vertex_buffer->fence();
+            indices_buffer->fence();
+        }
+
         void map() {
             const auto size = indices.size() * sizeof(index_type);
 
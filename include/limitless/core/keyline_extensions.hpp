@@ -14,4 +14,7 @@ namespace Limitless {
 
     constexpr auto explicit_uniform_location = "GL_ARB_explicit_uniform_location";
     constexpr auto extension_explicit_uniform_location = "#extension GL_ARB_explicit_uniform_location : require\n";
-}
\ No newline at end of file
+
+    constexpr auto compute_shader = "GL_ARB_compute_shader";
+    constexpr auto draw_indirect = "GL_ARB_draw_indirect";
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <limitless/core/context_debug.hpp>
+#include <limitless/util/filesystem.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Limitless {
+    class Shader;
+
+    /**
+     * ProgramBinaryCache stores linked shader program binaries on disk to skip compilation on next runs
+     *
+     * binaries are keyed by hash of fully preprocessed shader sources together with driver vendor, renderer and version,
+     * so any change of sources, settings defines or driver falls back to regular compilation
+     */
+    class ProgramBinaryCache final {
+    private:
+        /**
+         * Directory containing cached binaries
+         */
+        fs::path directory;
+
+        /**
+         * Driver identification string binaries are valid for
+         */
+        std::string driver;
+
+        [[nodiscard]] fs::path getPath(uint64_t key) const;
+    public:
+        explicit ProgramBinaryCache(fs::path directory);
+
+        /**
+         * Checks whether current context can retrieve and load program binaries
+         */
+        [[nodiscard]] static bool isSupported() noexcept;
+
+        /**
+         * Makes cache key for program linked from shaders
+         */
+        [[nodiscard]] uint64_t getKey(const std::vector<Shader>& shaders) const noexcept;
+
+        /**
+         * Creates program from cached binary
+         *
+         * @return program id or 0 if there is no binary or driver rejected it
+         */
+        [[nodiscard]] GLuint load(uint64_t key) const;
+
+        /**
+         * Stores binary of linked program
+         *
+         * program should be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set, failures are ignored
+         */
+        void store(uint64_t key, GLuint program_id) const;
+    };
+}
@@ -88,6 +88,8 @@ namespace Limitless {
         /**
          * Reads source code of file specified at @param filepath
          *
+         * Files are read once and then taken from in-memory cache, so includes shared by many shaders do not hit disk
+         *
          * @param filepath - filepath to read a file from
          * @return - file source code
          * @throw shader_file_not_found - if file at @param filepath does not exist
@@ -135,6 +137,7 @@ namespace Limitless {
         Shader& operator=(Shader&&) noexcept;
 
         [[nodiscard]] const auto& getId() const noexcept { return id; }
+        [[nodiscard]] auto getType() const noexcept { return type; }
 
         /**
          * Compiles shader
@@ -154,6 +157,13 @@ namespace Limitless {
         void replaceKey(const std::string& key, const std::string& value) noexcept;
 
         const auto& getSource() const noexcept { return source; }
+
+        /**
+         * Clears in-memory cache of shader files
+         *
+         * should be called before recompilation if shader files were changed on disk
+         */
+        static void clearSourceCache() noexcept;
     };
 
     void swap(Shader& lhs, Shader&rhs) noexcept;
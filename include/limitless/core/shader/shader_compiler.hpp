@@ -5,6 +5,7 @@
 #include <optional>
 
 #include <limitless/core/shader/shader.hpp>
+#include <limitless/core/shader/program_binary_cache.hpp>
 #include <limitless/renderer/renderer_settings.hpp>
 
 namespace Limitless {
@@ -46,6 +47,11 @@ namespace Limitless {
          */
         std::optional<RendererSettings> render_settings;
 
+        /**
+         * Cache of linked programs, present if enabled in RenderSettings and supported by context
+         */
+        std::optional<ProgramBinaryCache> binary_cache;
+
         void replaceCommonDefines(Shader& shader);
     public:
         /**
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <limitless/core/buffer/indexed_buffer.hpp>
+#include <limitless/core/uniform/uniform_name.hpp>
 #include <limitless/core/uniform/uniform.hpp>
 
 #include <vector>
@@ -22,18 +23,57 @@ namespace Limitless {
      * To create ShaderProgram use ShaderCompiler
      */
     class ShaderProgram final {
+    public:
+        /**
+         * Index of active uniform inside the shader program
+         *
+         * resolved once by name and then used to set value without lookups
+         */
+        using UniformHandle = uint32_t;
+
+        /**
+         * Handle of uniform that is not present in program, setting it does nothing
+         */
+        static constexpr UniformHandle INVALID_UNIFORM = 0xFFFFFFFF;
     private:
+        static constexpr UniformHandle UNRESOLVED_UNIFORM = INVALID_UNIFORM - 1;
+
         /**
          * Unique identifier
          */
         GLuint id {};
 
         /**
-         * Contains <uniform name, uniform location> inside the shader program
+         * Contains <uniform name, uniform handle> inside the shader program
+         */
+        std::unordered_map<std::string, UniformHandle> handles;
+
+        /**
+         * Contains uniform names and locations by handle
          *
-         * Used for caching purposes to reduce calls to driver
+         * filled once from introspection to reduce calls to driver
          */
-        std::unordered_map<std::string, GLint> locations;
+        std::vector<std::string> names;
+        std::vector<GLint> locations;
+
+        /**
+         * Contains uniform values by handle, null until uniform is set
+         *
+         * Used to cache values to reduce calls to driver
+         */
+        std::vector<std::unique_ptr<Uniform>> uniforms;
+
+        /**
+         * Contains handles of uniforms that have values
+         *
+         * only these are visited on use, unchanged ones are skipped by uniform itself
+         */
+        std::vector<UniformHandle> active;
+
+        /**
+         * Contains uniform handles by UniformName id
+         */
+        std::vector<UniformHandle> named;
 
         /**
          * Contains buffers data
@@ -41,11 +81,16 @@ namespace Limitless {
         std::vector<IndexedBufferData> indexed_binds;
 
         /**
-         * Contains <uniform name, uniform value> inside the shader program
+         * Index of material buffer inside indexed binds or -1 if there is none
+         */
+        int32_t material_bind {-1};
+
+        /**
+         * Contains names and handles of material samplers in order they were last set
          *
-         * Used to cache values to reduce calls to driver
+         * slot is reused while sampler at the same position has the same name and resolved again otherwise
          */
-        std::map<std::string, std::unique_ptr<Uniform>> uniforms;
+        std::vector<std::pair<std::string, UniformHandle>> material_samplers;
 
         /**
          * Binds buffer objects inside shader to current context state
@@ -57,6 +102,9 @@ namespace Limitless {
          */
         void bindResources();
 
+        template<typename U, typename V>
+        ShaderProgram& setValue(UniformHandle handle, const V& value);
+
         ShaderProgram() noexcept = default;
         explicit ShaderProgram(GLuint id) noexcept;
 
@@ -78,10 +126,34 @@ namespace Limitless {
 
         void use();
 
-        ShaderProgram& setUniform(const std::string& name, std::shared_ptr<Texture> texture);
+        /**
+         * Gets handle of uniform by name or INVALID_UNIFORM if it is not present
+         */
+        [[nodiscard]] UniformHandle getUniformHandle(const std::string& name) const noexcept;
+        [[nodiscard]] UniformHandle getUniformHandle(const UniformName& name) noexcept;
+
+        ShaderProgram& setUniform(UniformHandle handle, std::shared_ptr<Texture> texture);
         ShaderProgram& setMaterial(const ms::Material& material);
 
         template<typename T>
-        ShaderProgram& setUniform(const std::string& name, const T& value);
+        ShaderProgram& setUniform(UniformHandle handle, const T& value);
+
+        ShaderProgram& setUniform(const std::string& name, std::shared_ptr<Texture> texture) {
+            return setUniform(getUniformHandle(name), std::move(texture));
+        }
+
+        ShaderProgram& setUniform(const UniformName& name, std::shared_ptr<Texture> texture) {
+            return setUniform(getUniformHandle(name), std::move(texture));
+        }
+
+        template<typename T>
+        ShaderProgram& setUniform(const std::string& name, const T& value) {
+            return setUniform<T>(getUniformHandle(name), value);
+        }
+
+        template<typename T>
+        ShaderProgram& setUniform(const UniformName& name, const T& value) {
+            return setUniform<T>(getUniformHandle(name), value);
+        }
     };
 }
\ No newline at end of file
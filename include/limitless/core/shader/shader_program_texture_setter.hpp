@@ -2,7 +2,7 @@
 
 #include <string>
 #include <memory>
-#include <map>
+#include <vector>
 
 namespace Limitless {
     class Uniform;
@@ -11,6 +11,6 @@ namespace Limitless {
     private:
 
     public:
-        static void bindTextures(const std::map<std::string, std::unique_ptr<Uniform>>& uniforms);
+        static void bindTextures(const std::vector<std::unique_ptr<Uniform>>& uniforms);
     };
 }
\ No newline at end of file
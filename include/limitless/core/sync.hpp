@@ -27,8 +27,8 @@ namespace Limitless {
         Sync(const Sync&) = delete;
         Sync& operator=(const Sync&) = delete;
 
-        Sync(Sync&&) = default;
-        Sync& operator=(Sync&&) = default;
+        Sync(Sync&& rhs) noexcept;
+        Sync& operator=(Sync&& rhs) noexcept;
 
         void place();
         void remove();
@@ -65,6 +65,7 @@ namespace Limitless {
         BindlessTexture& setWrapS(GLenum target, GLenum wrap) override;
         BindlessTexture& setWrapT(GLenum target, GLenum wrap) override;
         BindlessTexture& setWrapR(GLenum target, GLenum wrap) override;
+        BindlessTexture& setLevelRange(GLenum target, GLint base, GLint max) override;
 
         void accept(TextureVisitor& visitor) noexcept override;
 
@@ -55,6 +55,9 @@ namespace Limitless {
         virtual ExtensionTexture& setWrapT(GLenum target, GLenum wrap) = 0;
         virtual ExtensionTexture& setWrapR(GLenum target, GLenum wrap) = 0;
 
+        // limits mipmap levels that are sampled
+        virtual ExtensionTexture& setLevelRange(GLenum target, GLint base, GLint max) = 0;
+
         virtual void accept(TextureVisitor& visitor) noexcept = 0;
 
         [[nodiscard]] virtual GLuint getId() const noexcept = 0;
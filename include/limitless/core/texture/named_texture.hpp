@@ -37,6 +37,7 @@ namespace Limitless {
         NamedTexture& setWrapS(GLenum target, GLenum wrap) override;
         NamedTexture& setWrapT(GLenum target, GLenum wrap) override;
         NamedTexture& setWrapR(GLenum target, GLenum wrap) override;
+        NamedTexture& setLevelRange(GLenum target, GLint base, GLint max) override;
 
         void accept(TextureVisitor& visitor) noexcept override;
 
@@ -49,6 +49,7 @@ namespace Limitless {
         StateTexture& setWrapS(GLenum target, GLenum wrap) override;
         StateTexture& setWrapT(GLenum target, GLenum wrap) override;
         StateTexture& setWrapR(GLenum target, GLenum wrap) override;
+        StateTexture& setLevelRange(GLenum target, GLint base, GLint max) override;
 
         void accept(TextureVisitor& visitor) noexcept override;
 
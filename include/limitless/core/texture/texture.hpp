@@ -37,6 +37,7 @@ namespace Limitless {
             RGB16F = GL_RGB16F,
             RGBA16F = GL_RGBA16F,
             RGB32F = GL_RGB32F,
+            RGBA32F = GL_RGBA32F,
 
             RG8_SNORM = GL_RG8_SNORM,
 
@@ -64,10 +65,18 @@ namespace Limitless {
             // GL_ARB_texture_compression_bptc
             RGBA_BC7 = GL_COMPRESSED_RGBA_BPTC_UNORM_ARB,
             sRGBA_BC7 = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB,
+            RGB_BC6H_UF = GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB,
+            RGB_BC6H_SF = GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB,
 
             // GL_ARB_texture_compression_rgtc
             R_RGTC = GL_COMPRESSED_RED_RGTC1,
-            RG_RGTC = GL_COMPRESSED_RG_RGTC2
+            RG_RGTC = GL_COMPRESSED_RG_RGTC2,
+            R_RGTC_SNORM = GL_COMPRESSED_SIGNED_RED_RGTC1,
+            RG_RGTC_SNORM = GL_COMPRESSED_SIGNED_RG_RGTC2,
+
+            // GL_KHR_texture_compression_astc_ldr
+            RGBA_ASTC_4x4 = GL_COMPRESSED_RGBA_ASTC_4x4_KHR,
+            sRGBA_ASTC_4x4 = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
         };
 
         enum class Format {
@@ -131,6 +140,8 @@ namespace Limitless {
         bool mipmap {false};
         bool compressed {false};
         bool immutable {false};
+
+        std::shared_ptr<Texture> clone(glm::uvec3 size, uint32_t levels);
     protected:
         Texture() = default;
     public:
@@ -172,6 +183,9 @@ namespace Limitless {
         Texture& setWrapS(Wrap wrap);
         Texture& setWrapT(Wrap wrap);
         Texture& setWrapR(Wrap wrap);
+
+        // limits sampled levels to [base, max]; mutable storage needs it when not all levels are specified
+        Texture& setLevelRange(uint32_t base, uint32_t max);
         void setParameters();
 
         /* ALLOCATION FUNCTIONS */
@@ -215,6 +229,13 @@ namespace Limitless {
         std::shared_ptr<Texture> clone(glm::uvec3 size);
         std::shared_ptr<Texture> clone(glm::uvec2 size);
 
+        /**
+         * Copy of levels starting from base level, top levels are dropped without reading texture back
+         *
+         * only for 2D textures with filled mip chain
+         */
+        std::shared_ptr<Texture> shrink(uint32_t base_level);
+
         void accept(TextureVisitor& visitor);
 
         class Builder;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Limitless {
+    /**
+     * Describes uniform name interned into program-independent id
+     *
+     * ShaderProgram resolves id to its own uniform handle once, so setting uniform by UniformName does not hash strings;
+     * meant to be stored as static constant by code that sets the same uniforms for different programs every draw
+     */
+    class UniformName final {
+    private:
+        std::string name;
+        uint32_t id;
+    public:
+        explicit UniformName(std::string name);
+
+        [[nodiscard]] const auto& getName() const noexcept { return name; }
+        [[nodiscard]] auto getId() const noexcept { return id; }
+    };
+}
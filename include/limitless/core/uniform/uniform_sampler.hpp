@@ -22,5 +22,10 @@ namespace Limitless {
 
         [[nodiscard]] const std::shared_ptr<Texture>& getSampler() const noexcept;
         void setSampler(const std::shared_ptr<Texture>& texture) noexcept;
+
+        /**
+         * Marks uniform changed if storage of texture was replaced, e.g. by streaming
+         */
+        void refresh() noexcept;
     };
 }
@@ -29,5 +29,7 @@ namespace Limitless {
         void add(std::function<void(ShaderProgram&, const Instance& instance)>&& f);
 
         void operator()(ShaderProgram& shader, const Instance& instance) const;
+
+        [[nodiscard]] bool empty() const noexcept { return setters.empty(); }
     };
 }
\ No newline at end of file
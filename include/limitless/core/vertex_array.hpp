@@ -8,6 +8,7 @@
 
 namespace Limitless {
     class Buffer;
+    class ContextState;
 
     class VertexAttribute {
     public:
@@ -22,11 +23,19 @@ namespace Limitless {
         ~VertexAttribute() = default;
     };
 
+    /**
+     * Vertex array objects are not shared between contexts, so object is generated on first bind
+     * and set attributes are replayed in it
+     *
+     * that makes vertex arrays created by shared context workers valid in drawing context
+     */
     class VertexArray {
     private:
         std::unordered_map<GLuint, VertexAttribute> attributes;
         std::shared_ptr<Buffer> element_buffer {};
-        GLuint id {};
+        mutable GLuint id {};
+
+        void generate(ContextState& ctx) const noexcept;
 
         friend void swap(VertexArray& lhs, VertexArray& rhs);
     public:
@@ -4,6 +4,8 @@
 #include <limitless/core/buffer/buffer_builder.hpp>
 #include <limitless/core/abstract_vertex_stream.hpp>
 
+#include <array>
+
 namespace Limitless {
     template <typename Vertex>
     class VertexStream : public AbstractVertexStream {
@@ -117,6 +119,25 @@ namespace Limitless {
             vertex_buffer->fence();
         }
 
+        void draw_instanced_indirect(VertexStreamDraw draw_mode, Buffer& command) noexcept override {
+            if (stream.empty()) {
+                return;
+            }
+
+            // DrawArraysIndirectCommand: count, instance count, first, base instance
+            const auto count = static_cast<uint32_t>(stream.size());
+            const std::array<uint32_t, 2> zeros {};
+            command.bufferSubData(0, sizeof(count), &count);
+            command.bufferSubData(2 * sizeof(uint32_t), sizeof(zeros), zeros.data());
+
+            vertex_array.bind();
+            command.bindAs(Buffer::Type::IndirectDraw);
+
+            glDrawArraysIndirect(static_cast<GLenum>(draw_mode), nullptr);
+
+            vertex_buffer->fence();
+        }
+
         void draw() noexcept override {
             draw(mode);
         }
@@ -124,5 +145,9 @@ namespace Limitless {
         void draw_instanced(std::size_t count) noexcept override {
             draw_instanced(mode, count);
         }
+
+        void draw_instanced_indirect(Buffer& command) noexcept override {
+            draw_instanced_indirect(mode, command);
+        }
     };
 }
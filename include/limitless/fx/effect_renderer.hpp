@@ -2,6 +2,8 @@
 
 #include <limitless/fx/renderers/emitter_renderer.hpp>
 #include <limitless/fx/emitters/unique_emitter.hpp>
+#include <limitless/fx/particle_storage.hpp>
+#include <limitless/fx/particle.hpp>
 
 #include <map>
 #include <memory>
@@ -21,17 +23,25 @@ namespace Limitless {
 
 namespace Limitless::fx {
     class AbstractEmitterRenderer;
+    class EmitterVisitor;
 
     class EffectRenderer final {
     private:
         std::map<UniqueEmitterRenderer, std::unique_ptr<AbstractEmitterRenderer>> renderers;
 
-        void updateRenderers(const Instances& instances) noexcept;
-        static void visitEmitters(const Instances& instances, EmitterVisitor& visitor) noexcept;
+        // particles of all renderers of the same type are written into one storage
+        ParticleStorage<SpriteParticle> sprite_storage;
+        ParticleStorage<MeshParticle> mesh_storage;
+        ParticleStorage<BeamParticleMapping> beam_storage;
+
+        static void visitEmitters(const Instance& instance, EmitterVisitor& visitor) noexcept;
     public:
         ~EffectRenderer() = default;
 
-        void update(const Instances& instances);
+        /**
+         * Writes particles of instances into storages and steps GPU simulated emitters, must be called once per frame before draw
+         */
+        void update(const Assets& assets, const Instances& instances);
         void draw(Context& ctx, const Assets& assets, ShaderType shader, ms::Blending blending, const UniformSetter& setter);
     };
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 namespace Limitless {
     class Context;
     class Camera;
+    class FrameClock;
 }
 
 namespace Limitless::fx {
@@ -21,6 +22,9 @@ namespace Limitless::fx {
     protected:
         Type type;
 
+        // time of frame emitter is updated at, modules take time from here
+        std::chrono::time_point<std::chrono::steady_clock> frame_time {};
+
         explicit AbstractEmitter(Type type) noexcept;
 
         AbstractEmitter(const AbstractEmitter&) = default;
@@ -34,6 +38,7 @@ namespace Limitless::fx {
         virtual ~AbstractEmitter() = default;
 
         [[nodiscard]] auto getType() const noexcept { return type; }
+        [[nodiscard]] auto getFrameTime() const noexcept { return frame_time; }
         [[nodiscard]] virtual const UniqueEmitterShader& getUniqueShaderType() const noexcept = 0;
         [[nodiscard]] virtual UniqueEmitterRenderer getUniqueRendererType() const noexcept = 0;
 
@@ -47,10 +52,11 @@ namespace Limitless::fx {
         virtual void ressurect() noexcept = 0;
 
         [[nodiscard]] virtual AbstractEmitter* clone() const = 0;
-        virtual void update(const Camera &camera) = 0;
+        virtual void update(const Camera &camera, const FrameClock& clock) = 0;
         virtual void accept(EmitterVisitor& visitor) noexcept = 0;
 
         virtual bool& getLocalSpace() noexcept = 0;
+        virtual bool& getGpuSimulation() noexcept = 0;
         virtual EmitterSpawn& getSpawn() noexcept = 0;
         virtual glm::vec3& getLocalPosition() noexcept = 0;
         virtual glm::quat& getLocalRotation() noexcept = 0;
@@ -58,6 +64,7 @@ namespace Limitless::fx {
 
         [[nodiscard]] virtual bool isDone() const noexcept = 0;
         [[nodiscard]] virtual bool getLocalSpace() const noexcept = 0;
+        [[nodiscard]] virtual bool getGpuSimulation() const noexcept = 0;
         [[nodiscard]] virtual const glm::vec3& getLocalPosition() const noexcept = 0;
         [[nodiscard]] virtual const glm::quat& getLocalRotation() const noexcept = 0;
         [[nodiscard]] virtual const EmitterSpawn& getSpawn() const noexcept  = 0;
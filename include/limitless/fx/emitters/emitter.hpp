@@ -2,7 +2,7 @@
 
 #include <limitless/fx/emitters/abstract_emitter.hpp>
 #include <limitless/fx/emitters/emitter_spawn.hpp>
-#include <limitless/fx/particle.hpp>
+#include <limitless/fx/particle_pool.hpp>
 
 #include <glm/gtx/quaternion.hpp>
 
@@ -14,6 +14,7 @@
 
 namespace Limitless::fx {
     template<typename Particle> class Module;
+    template<typename Particle> class ParticleSimulation;
 
     template<typename Particle>
     struct ModuleCompare {
@@ -25,10 +26,21 @@ namespace Limitless::fx {
 
     template<typename Particle = SpriteParticle>
     class Emitter : public AbstractEmitter {
+    public:
+        /**
+         * Particle count from which emitter is updated in parallel
+         */
+        static constexpr size_t PARALLEL_PARTICLE_COUNT = 4096;
+
+        /**
+         * Particle count of one parallel range
+         */
+        static constexpr size_t PARTICLE_RANGE_SIZE = 2048;
     protected:
         // emitter modules determine particles appearance and behavior
         EmitterModules<Particle> modules;
-        std::vector<Particle> particles;
+        // particles stored as attribute arrays
+        ParticlePool<Particle> particles;
 
         // local position of emitter
         glm::vec3 local_position {0.0f};
@@ -41,6 +53,11 @@ namespace Limitless::fx {
         // particles position is relative to emitter
         bool local_space {false};
 
+        // particles are simulated on GPU; reset on update if emitter cannot be simulated there
+        bool gpu_simulation {false};
+        // created on first update when gpu_simulation is set
+        std::unique_ptr<ParticleSimulation<Particle>> simulation;
+
         // spawn properties
         EmitterSpawn spawn;
 
@@ -58,11 +75,18 @@ namespace Limitless::fx {
         void spawnParticles() noexcept;
         void killParticles() noexcept;
 
+        /**
+         * Runs modules in their order and integrates particles
+         *
+         * consecutive splittable modules of large emitters are run over particle ranges in parallel
+         */
+        void updateParticles(const Camera& camera, float dt);
+
         explicit Emitter(Type type);
-        ~Emitter() override = default;
+        ~Emitter() override;
 
         Emitter(const Emitter&);
-        Emitter(Emitter&&) noexcept = default;
+        Emitter(Emitter&&) noexcept;
 
         friend class EffectBuilder;
     public:
@@ -79,10 +103,11 @@ namespace Limitless::fx {
         [[nodiscard]] UniqueEmitterRenderer getUniqueRendererType() const noexcept override { return { type, std::nullopt, nullptr }; }
 
         [[nodiscard]] Emitter* clone() const override;
-        void update(const Camera &camera) override;
+        void update(const Camera &camera, const FrameClock& clock) override;
         void accept(EmitterVisitor& visitor) noexcept override;
 
         bool& getLocalSpace() noexcept override;
+        bool& getGpuSimulation() noexcept override;
         EmitterSpawn& getSpawn() noexcept override;
         glm::vec3& getLocalPosition() noexcept override;
         glm::quat& getLocalRotation() noexcept override;
@@ -100,10 +125,16 @@ namespace Limitless::fx {
 
         [[nodiscard]] bool isDone() const noexcept override;
         [[nodiscard]] bool getLocalSpace() const noexcept override;
+        [[nodiscard]] bool getGpuSimulation() const noexcept override;
         [[nodiscard]] const glm::vec3& getLocalPosition() const noexcept override;
         [[nodiscard]] const glm::quat& getLocalRotation() const noexcept override;
         [[nodiscard]] const EmitterSpawn& getSpawn() const noexcept override;
         [[nodiscard]] const std::chrono::duration<float>& getDuration() const noexcept override;
         [[nodiscard]] const auto& getModules() const noexcept { return modules; }
+
+        /**
+         * Returns GPU simulation of particles or nullptr if emitter is simulated on CPU
+         */
+        [[nodiscard]] ParticleSimulation<Particle>* getSimulation() const noexcept { return simulation.get(); }
     };
 }
@@ -9,36 +9,39 @@
 #include <limitless/fx/emitters/beam_emitter.hpp>
 
 namespace Limitless::fx {
+    /**
+     * Finds renderer of every visited emitter, creates it if there is none, and adds emitter to it
+     */
     class EmitterRendererCreator : public EmitterVisitor {
     private:
         std::map<UniqueEmitterRenderer, std::unique_ptr<AbstractEmitterRenderer>>& renderers;
+
+        template<typename Particle, typename Emitter>
+        void add(const Emitter& emitter) {
+            auto it = renderers.find(emitter.getUniqueRendererType());
+            if (it == renderers.end()) {
+                auto type = emitter.getUniqueRendererType();
+                type.material = std::make_shared<ms::Material>(*type.material);
+                it = renderers.emplace(type, new EmitterRenderer<Particle>(emitter)).first;
+            }
+
+            static_cast<EmitterRenderer<Particle>&>(*it->second).add(emitter);
+        }
     public:
         explicit EmitterRendererCreator(decltype(renderers) renderers) noexcept
             : renderers {renderers} {}
         ~EmitterRendererCreator() override = default;
 
         void visit(const SpriteEmitter& emitter) noexcept override {
-            if (!renderers.count(emitter.getUniqueRendererType())) {
-                auto type = emitter.getUniqueRendererType();
-                type.material = std::make_shared<ms::Material>(*type.material);
-                renderers.emplace(type, new EmitterRenderer<SpriteParticle>(emitter));
-            }
+            add<SpriteParticle>(emitter);
         }
 
         void visit(const MeshEmitter& emitter) noexcept override {
-            if (!renderers.count(emitter.getUniqueRendererType())) {
-                auto type = emitter.getUniqueRendererType();
-                type.material = std::make_shared<ms::Material>(*type.material);
-                renderers.emplace(type, new EmitterRenderer<MeshParticle>(emitter));
-            }
+            add<MeshParticle>(emitter);
         }
 
         void visit(const BeamEmitter& emitter) noexcept override {
-            if (!renderers.count(emitter.getUniqueRendererType())) {
-                auto type = emitter.getUniqueRendererType();
-                type.material = std::make_shared<ms::Material>(*type.material);
-                renderers.emplace(type, new EmitterRenderer<BeamParticle>(emitter));
-            }
+            add<BeamParticle>(emitter);
         }
     };
-}
\ No newline at end of file
+}
@@ -4,6 +4,7 @@
 
 #include <limitless/core/context.hpp>
 #include <limitless/camera.hpp>
+#include <limitless/util/random.hpp>
 
 #include <algorithm>
 
@@ -13,11 +14,12 @@ namespace Limitless::fx {
     private:
         std::vector<BeamParticleMapping> beam_particles;
 
-        void generate(BeamParticle& particle, const Camera& camera) {
+        void generate(const ParticlePool<Particle>& particles, size_t index, const Camera& camera) {
             constexpr auto DOT_PRODUCT_RANGE = glm::vec2(0.2f, 0.8f);
             auto size = Context::getCurrentContext()->getSize();
             const auto resolution = glm::vec2(size.x, size.y);
-            const auto& line = particle.derivative_line;
+            const auto& line = particles.derivative_line[index];
+            const auto particle_size = particles.size[index];
 
             for (uint32_t i = 0; i < 6 * (line.size() - 2 - 1); ++i) {
                 int line_i = i / 6;
@@ -47,8 +49,8 @@ namespace Limitless::fx {
                     auto dot = glm::dot(v_miter, nv_line);
                     dot = glm::min(dot, DOT_PRODUCT_RANGE.y);
                     dot = glm::max(dot, DOT_PRODUCT_RANGE.x);
-                    pos.x += (v_miter * particle.size / pos.w * (tri_i == 1 ? -0.5f : 0.5f) / dot).x;
-                    pos.y += (v_miter * particle.size / pos.w * (tri_i == 1 ? -0.5f : 0.5f) / dot).y;
+                    pos.x += (v_miter * particle_size / pos.w * (tri_i == 1 ? -0.5f : 0.5f) / dot).x;
+                    pos.y += (v_miter * particle_size / pos.w * (tri_i == 1 ? -0.5f : 0.5f) / dot).y;
                 } else {
                     glm::vec2 v_succ = normalize(glm::vec2(va[3]) - glm::vec2(va[2]));
                     glm::vec2 v_miter = normalize(nv_line + glm::vec2(-v_succ.y, v_succ.x));
@@ -57,8 +59,8 @@ namespace Limitless::fx {
                     auto dot = glm::dot(v_miter, nv_line);
                     dot = glm::min(dot, DOT_PRODUCT_RANGE.y);
                     dot = glm::max(dot, DOT_PRODUCT_RANGE.x);
-                    pos.x += (v_miter * particle.size / pos.w * (tri_i == 5 ? 0.5f : -0.5f) / dot).x;
-                    pos.y += (v_miter * particle.size / pos.w * (tri_i == 5 ? 0.5f : -0.5f) / dot).y;
+                    pos.x += (v_miter * particle_size / pos.w * (tri_i == 5 ? 0.5f : -0.5f) / dot).x;
+                    pos.y += (v_miter * particle_size / pos.w * (tri_i == 5 ? 0.5f : -0.5f) / dot).y;
                 }
 
                 pos.x = (glm::vec2(pos) / resolution * 2.0f - 1.0f).x;
@@ -95,30 +97,29 @@ namespace Limitless::fx {
 
                 BeamParticleMapping p;
                 p.position = pos;
-                p.size = particle.size;
-                p.color = particle.color;
-                p.subUV = particle.subUV;
-                p.properties = particle.properties;
-                p.acceleration = particle.acceleration;
-                p.lifetime = particle.lifetime;
-                p.rotation = particle.rotation;
-                p.time = particle.time;
-                p.velocity = particle.velocity;
+                p.size = particle_size;
+                p.color = particles.color[index];
+                p.subUV = particles.subUV[index];
+                p.properties = particles.properties[index];
+                p.acceleration = particles.acceleration[index];
+                p.lifetime = particles.lifetime[index];
+                p.rotation = particles.rotation[index];
+                p.time = particles.time[index];
+                p.velocity = particles.velocity[index];
                 p.uv = uv;
-                p.length = particle.length;
-                p.start = particle.position;
-                p.end = particle.target;
+                p.length = particles.length[index];
+                p.start = particles.position[index];
+                p.end = particles.target[index];
 
                 beam_particles.emplace_back(std::move(p));
             }
         }
 
-        void generate(std::vector<glm::vec3>& line, BeamParticle& particle, glm::vec3 source, glm::vec3 dest, float distance) {
-            std::random_device rd;
-            std::mt19937 generator(rd());
+        void generate(std::vector<glm::vec3>& line, float offset, glm::vec3 source, glm::vec3 dest, float distance) {
+            auto& generator = getRandomEngine();
             auto uni = std::uniform_real_distribution<float>(-distance, distance);
 
-            if (distance < particle.offset) {
+            if (distance < offset) {
                 line.emplace_back(source);
                 line.emplace_back(dest);
             } else {
@@ -127,8 +128,8 @@ namespace Limitless::fx {
 
                 center += random;
 
-                generate(line, particle, source, center, distance * 0.5f);
-                generate(line, particle, dest, center, distance * 0.5f);
+                generate(line, offset, source, center, distance * 0.5f);
+                generate(line, offset, dest, center, distance * 0.5f);
             }
         }
     public:
@@ -144,22 +145,26 @@ namespace Limitless::fx {
             return beam_particles;
         }
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, [[maybe_unused]] float dt, const Camera &camera) noexcept override {
+        // collects beam particles for the whole emitter
+        [[nodiscard]] bool isSplittable() const noexcept override { return false; }
+
+        void update(AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, [[maybe_unused]] float dt, const Camera &camera) noexcept override {
             beam_particles.clear();
 
-            for (auto& particle : particles) {
-                const auto current = std::chrono::steady_clock::now();
-                const auto delta_time = std::chrono::duration_cast<std::chrono::duration<float>>(current - particle.last_rebuild);
+            const auto current = emitter.getFrameTime();
+            for (size_t i = begin; i < end; ++i) {
+                const auto delta_time = std::chrono::duration_cast<std::chrono::duration<float>>(current - particles.last_rebuild[i]);
 
-                if (delta_time > particle.rebuild_delta) {
-                    auto& line = particle.derivative_line;
+                if (delta_time > particles.rebuild_delta[i]) {
+                    const auto& source = particles.position[i];
+                    auto& line = particles.derivative_line[i];
                     line.clear();
-                    generate(particle.derivative_line, particle, particle.position, particle.target, particle.displacement);
+                    generate(line, particles.offset[i], source, particles.target[i], particles.displacement[i]);
 
                     // shitty algorithm requirements
                     {
                         std::sort(line.begin(), line.end(), [&](const auto& a, const auto& b) {
-                            return glm::distance(particle.position, a) < glm::distance(particle.position, b);
+                            return glm::distance(source, a) < glm::distance(source, b);
                         });
                         line.erase(std::unique(line.begin(), line.end()), line.end());
 
@@ -167,10 +172,10 @@ namespace Limitless::fx {
                         line.insert(line.begin(), line[line.size() - 2]);
                     }
 
-                    particle.last_rebuild = current;
+                    particles.last_rebuild[i] = current;
                 }
 
-                generate(particle, camera);
+                generate(particles, i, camera);
             }
         }
 
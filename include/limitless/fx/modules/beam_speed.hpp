@@ -20,24 +20,23 @@ namespace Limitless::fx {
 
         BeamSpeed(const BeamSpeed& module) : Module<Particle>(module.type), distribution {module.distribution->clone()} {}
 
-        void initialize([[maybe_unused]] AbstractEmitter& emitter, Particle& particle, [[maybe_unused]] size_t index) noexcept override {
+        void initialize(AbstractEmitter& emitter, Particle& particle, [[maybe_unused]] size_t index) noexcept override {
             particle.speed = distribution->get();
             particle.length = 0.0f;
-            particle.speed_start = std::chrono::steady_clock::now();
+            particle.speed_start = emitter.getFrameTime();
         }
 
         [[nodiscard]] BeamSpeed* clone() const override {
             return new BeamSpeed(*this);
         }
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, [[maybe_unused]] float dt, [[maybe_unused]] const Camera &camera) noexcept override {
-            using namespace std::chrono;
-            for (auto& particle : particles) {
-                const auto current_time = steady_clock::now();
-                std::chrono::duration<double> mil = current_time - particle.speed_start;
+        void update(AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, [[maybe_unused]] float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+            const auto current_time = emitter.getFrameTime();
+            for (size_t i = begin; i < end; ++i) {
+                std::chrono::duration<double> mil = current_time - particles.speed_start[i];
 
-                particle.length = mil.count() / particle.speed;
-                particle.length = glm::clamp(particle.length, 0.0f, 1.0f);
+                particles.length[i] = mil.count() / particles.speed[i];
+                particles.length[i] = glm::clamp(particles.length[i], 0.0f, 1.0f);
             }
         }
     };
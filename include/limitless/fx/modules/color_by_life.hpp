@@ -18,12 +18,13 @@ namespace Limitless::fx {
             : Module<Particle>(module.type)
             , distribution {module.distribution->clone()} {}
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
-            for (auto& particle : particles) {
-                const auto tick = particle.lifetime / dt;
-                const auto tick_color = (distribution->get() - particle.color) / tick;
-                particle.color += tick_color;
-                particle.color = glm::clamp(particle.color, glm::vec4(0.0f), glm::vec4(std::numeric_limits<float>::max()));
+        void update([[maybe_unused]] AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+            const auto* lifetime = particles.lifetime.data();
+            auto* color = particles.color.data();
+            for (size_t i = begin; i < end; ++i) {
+                const auto tick = lifetime[i] / dt;
+                color[i] += (distribution->get() - color[i]) / tick;
+                color[i] = glm::clamp(color[i], glm::vec4(0.0f), glm::vec4(std::numeric_limits<float>::max()));
             }
         }
 
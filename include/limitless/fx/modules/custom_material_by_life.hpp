@@ -29,13 +29,17 @@ namespace Limitless::fx {
         auto& getProperties() noexcept { return properties; }
         const auto& getProperties() const noexcept { return properties; }
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
-            for (auto& particle : particles) {
-                for (size_t i = 0; i < properties.size(); ++i) {
-                    if (properties[i]) {
-                        const auto tick = particle.lifetime / dt;
-                        particle.properties[i] += (properties[i]->get() - particle.properties[i]) / tick;
-                    }
+        void update([[maybe_unused]] AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+            const auto* lifetime = particles.lifetime.data();
+            auto* values = particles.properties.data();
+            for (size_t p = 0; p < properties.size(); ++p) {
+                if (!properties[p]) {
+                    continue;
+                }
+
+                for (size_t i = begin; i < end; ++i) {
+                    const auto tick = lifetime[i] / dt;
+                    values[i][p] += (properties[p]->get() - values[i][p]) / tick;
                 }
             }
         }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limitless/util/random.hpp>
 #include <glm/glm.hpp>
 #include <random>
 
@@ -121,15 +122,11 @@ namespace Limitless {
     class RangeDistribution : public Distribution<T> {
     private:
         T min, max;
-
-        mutable std::default_random_engine generator;
-        mutable uniform_distribution<T> distribution;
     public:
         RangeDistribution(const T& min, const T& max) noexcept
             : Distribution<T>(DistributionType::Range)
             , min(min)
-            , max(max)
-            , distribution(min, max) {}
+            , max(max) {}
         ~RangeDistribution() override = default;
 
         [[nodiscard]] const T& getMin() const noexcept { return min; }
@@ -137,18 +134,12 @@ namespace Limitless {
         [[nodiscard]] const T& getMax() const noexcept { return max; }
         [[nodiscard]] T& getMax() noexcept { return max; }
 
-        void setMin(const T& _min) noexcept {
-            min = _min;
-            distribution.set(min, max);
-        }
-
-        void setMax(const T& _max) noexcept {
-            max = _max;
-            distribution.set(min, max);
-        }
+        void setMin(const T& _min) noexcept { min = _min; }
+        void setMax(const T& _max) noexcept { max = _max; }
 
-        T get() override { return distribution(generator); }
-        T get() const override { return distribution(generator); }
+        // distribution is stateless, values are drawn from engine of calling thread so particles can be updated in parallel
+        T get() override { return uniform_distribution<T>(min, max)(getRandomEngine()); }
+        T get() const override { return uniform_distribution<T>(min, max)(getRandomEngine()); }
 
         [[nodiscard]] Distribution<T>* clone() override {
             return new RangeDistribution<T>(*this);
@@ -22,9 +22,10 @@ namespace Limitless::fx {
             particle.lifetime = distribution->get();
         }
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
-            for (auto& particle : particles) {
-                particle.lifetime -= dt;
+        void update([[maybe_unused]] AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+            auto* lifetime = particles.lifetime.data();
+            for (size_t i = begin; i < end; ++i) {
+                lifetime[i] -= dt;
             }
         }
 
@@ -13,7 +13,8 @@ namespace Limitless::fx {
             std::pair<float, float> triangle_position;
             glm::vec3 last_position;
         };
-        std::map<size_t, LocationCache> cache;
+        // cached location by particle index, has exactly as many entries as emitter has particles
+        std::vector<LocationCache> cache;
     public:
         explicit MeshLocationAttachment(std::shared_ptr<AbstractMesh> mesh) noexcept
             : InitialMeshLocation<Particle>(ModuleType::MeshLocationAttachment, std::move(mesh)) {
@@ -25,8 +26,12 @@ namespace Limitless::fx {
 
         ~MeshLocationAttachment() override = default;
 
-        MeshLocationAttachment(const MeshLocationAttachment&) = default;
-        MeshLocationAttachment& operator=(const MeshLocationAttachment&) noexcept = default;
+        // copy starts without particles, so cached locations are not copied
+        MeshLocationAttachment(const MeshLocationAttachment& rhs)
+            : InitialMeshLocation<Particle>(rhs) {
+        }
+
+        MeshLocationAttachment& operator=(const MeshLocationAttachment&) = delete;
 
         void initialize([[maybe_unused]] AbstractEmitter& emitter, Particle& particle, size_t index) noexcept override {
             const auto selected_mesh = this->getSelectedMesh();
@@ -35,35 +40,37 @@ namespace Limitless::fx {
             const auto mesh_position = this->getPositionOnMesh(selected_mesh, vertex_index, triangle_pos.first, triangle_pos.second);
             particle.position += mesh_position;
 
-            cache[index] = { selected_mesh, vertex_index, triangle_pos, mesh_position };
+            // index is count of particles before this one
+            if (cache.size() > index) {
+                cache.resize(index);
+            }
+            cache.push_back({ selected_mesh, vertex_index, triangle_pos, mesh_position });
         }
 
-        void deinitialize(const std::vector<size_t>& indices) override {
-            for (const auto& index : indices) {
-                cache.erase(index);
+        void deinitialize(size_t index) noexcept override {
+            if (index >= cache.size()) {
+                return;
             }
 
-            decltype(cache) new_cache;
-
-            size_t i {};
-            for (const auto& [_, c] : cache) {
-                new_cache.emplace(i++, c);
+            // mirrors particle removal
+            if (index + 1 != cache.size()) {
+                cache[index] = std::move(cache.back());
             }
-
-            cache = std::move(new_cache);
+            cache.pop_back();
         }
 
         MeshLocationAttachment* clone() const noexcept override {
             return new MeshLocationAttachment<Particle>(*this);
         }
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, [[maybe_unused]] float dt, [[maybe_unused]] const Camera &camera) noexcept override {
-            for (size_t i = 0; i < particles.size(); ++i) {
+        void update([[maybe_unused]] AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, [[maybe_unused]] float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+            auto* position = particles.position.data();
+            for (size_t i = begin; i < std::min(end, cache.size()); ++i) {
                 auto& [selected_mesh, vertex_index, triangle, last_position] = cache[i];
                 const auto mesh_position = this->getPositionOnMesh(selected_mesh, vertex_index, triangle.first, triangle.second);
-                particles[i].position += mesh_position - last_position;
+                position[i] += mesh_position - last_position;
                 last_position = mesh_position;
             }
         }
     };
-}
+}
\ No newline at end of file
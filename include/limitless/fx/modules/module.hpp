@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <limitless/fx/emitters/abstract_emitter.hpp>
+#include <limitless/fx/particle_pool.hpp>
 
 namespace Limitless {
     class Context;
@@ -58,8 +59,21 @@ namespace Limitless::fx {
 
         virtual void initialize([[maybe_unused]] AbstractEmitter& e, [[maybe_unused]] Particle& p, [[maybe_unused]] size_t index) noexcept {}
 
-        virtual void deinitialize([[maybe_unused]] const std::vector<size_t>& indices) {}
+        /**
+         * Called when particle at index is killed and the last particle is moved in its place
+         */
+        virtual void deinitialize([[maybe_unused]] size_t index) {}
 
-        virtual void update([[maybe_unused]] AbstractEmitter &emitter, [[maybe_unused]] std::vector<Particle> &particles, [[maybe_unused]] float dt, [[maybe_unused]] const Camera &camera) noexcept {}
+        /**
+         * Updates particles in range [begin, end)
+         */
+        virtual void update([[maybe_unused]] AbstractEmitter &emitter, [[maybe_unused]] ParticlePool<Particle> &particles, [[maybe_unused]] size_t begin, [[maybe_unused]] size_t end, [[maybe_unused]] float dt, [[maybe_unused]] const Camera &camera) noexcept {}
+
+        /**
+         * Whether disjoint particle ranges can be updated concurrently
+         *
+         * modules that keep per-update state are updated once per frame with the whole pool
+         */
+        [[nodiscard]] virtual bool isSplittable() const noexcept { return true; }
     };
 }
@@ -18,10 +18,11 @@ namespace Limitless::fx {
             : Module<Particle>(module.type)
             , distribution {module.distribution->clone()} {}
 
-        void update(AbstractEmitter &emitter, std::vector<Particle> &particles, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+        void update(AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
             const auto rot = emitter.getRotation() * emitter.getLocalRotation();
-            for (auto& particle : particles) {
-                particle.rotation += (distribution->get() * rot) * dt;
+            auto* rotation = particles.rotation.data();
+            for (size_t i = begin; i < end; ++i) {
+                rotation[i] += (distribution->get() * rot) * dt;
             }
         }
 
@@ -18,11 +18,12 @@ namespace Limitless::fx {
             : Module<Particle>(module.type)
             , distribution {module.distribution->clone()} {}
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
-            for (auto& particle : particles) {
-                const auto tick = particle.lifetime / dt;
-                const auto tick_size = (distribution->get() - particle.size) / tick;
-                particle.size += tick_size;
+        void update([[maybe_unused]] AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+            const auto* lifetime = particles.lifetime.data();
+            auto* size = particles.size.data();
+            for (size_t i = begin; i < end; ++i) {
+                const auto tick = lifetime[i] / dt;
+                size[i] += (distribution->get() - size[i]) / tick;
             }
         }
 
@@ -49,11 +50,12 @@ namespace Limitless::fx {
             : Module<MeshParticle>(module.type)
             , distribution {module.distribution->clone()} {}
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<MeshParticle> &particles, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
-            for (auto& particle : particles) {
-                const auto tick = particle.lifetime / dt;
-                const auto tick_size = (distribution->get() - particle.size) / tick;
-                particle.size += tick_size;
+        void update([[maybe_unused]] AbstractEmitter &emitter, ParticlePool<MeshParticle> &particles, size_t begin, size_t end, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+            const auto* lifetime = particles.lifetime.data();
+            auto* size = particles.size.data();
+            for (size_t i = begin; i < end; ++i) {
+                const auto tick = lifetime[i] / dt;
+                size[i] += (distribution->get() - size[i]) / tick;
             }
         }
 
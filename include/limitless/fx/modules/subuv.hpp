@@ -59,24 +59,27 @@ namespace Limitless::fx {
             particle.subUV.w = frames[0].y;
         }
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, [[maybe_unused]] float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+        // keeps frame timer
+        [[nodiscard]] bool isSplittable() const noexcept override { return false; }
+
+        void update(AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, [[maybe_unused]] float dt, [[maybe_unused]] const Camera &camera) noexcept override {
             if (first_update) {
-                last_time = std::chrono::steady_clock::now();
+                last_time = emitter.getFrameTime();
                 first_update = false;
             }
 
-            auto current_time = std::chrono::steady_clock::now();
+            const auto current_time = emitter.getFrameTime();
 
             if (std::chrono::duration_cast<std::chrono::duration<float>>(current_time - last_time).count() >= (1.0f / fps)) {
-                for (auto& p : particles) {
-
-                    auto current_frame = glm::vec2{p.subUV.z, p.subUV.w};
+                for (size_t i = begin; i < end; ++i) {
+                    auto& subUV = particles.subUV[i];
+                    auto current_frame = glm::vec2{subUV.z, subUV.w};
                     auto it = std::find(frames.begin(), frames.end(), current_frame);
 
                     auto next_frame = (*it == frames.back()) ? frames[0] : *(++it);
 
-                    p.subUV.z = next_frame.x;
-                    p.subUV.w = next_frame.y;
+                    subUV.z = next_frame.x;
+                    subUV.w = next_frame.y;
                 }
 
                 last_time = current_time;
@@ -17,9 +17,10 @@ namespace Limitless::fx {
             particle.time = 0.0f;
         }
 
-        void update([[maybe_unused]] AbstractEmitter &emitter, std::vector<Particle> &particles, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
-            for (auto& particle : particles) {
-                particle.time += dt;
+        void update([[maybe_unused]] AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+            auto* time = particles.time.data();
+            for (size_t i = begin; i < end; ++i) {
+                time[i] += dt;
             }
         }
 
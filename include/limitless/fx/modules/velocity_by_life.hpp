@@ -18,12 +18,13 @@ namespace Limitless::fx {
             : Module<Particle>(module.type)
             , distribution {module.distribution->clone()} {}
 
-        void update(AbstractEmitter &emitter, std::vector<Particle> &particles, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
+        void update(AbstractEmitter &emitter, ParticlePool<Particle> &particles, size_t begin, size_t end, float dt, [[maybe_unused]] const Camera &camera) noexcept override {
             const auto rot = emitter.getRotation() * emitter.getLocalRotation();
-            for (auto& particle : particles) {
-                const auto tick = particle.lifetime / dt;
-                const auto tick_vel = (rot * distribution->get() - particle.velocity) / tick;
-                particle.velocity += tick_vel;
+            const auto* lifetime = particles.lifetime.data();
+            auto* velocity = particles.velocity.data();
+            for (size_t i = begin; i < end; ++i) {
+                const auto tick = lifetime[i] / dt;
+                velocity[i] += (rot * distribution->get() - velocity[i]) / tick;
             }
         }
 
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <limitless/fx/particle.hpp>
+
+#include <algorithm>
+
+namespace Limitless::fx {
+    /**
+     * Attribute arrays shared by all particle types
+     */
+    template<typename Particle, typename Size>
+    class CommonParticleArrays {
+    public:
+        std::vector<glm::vec4> color;
+        std::vector<glm::vec4> subUV;
+        std::vector<glm::vec4> properties;
+        std::vector<glm::vec3> acceleration;
+        std::vector<float> lifetime;
+        std::vector<glm::vec3> position;
+        std::vector<Size> size;
+        std::vector<glm::vec3> rotation;
+        std::vector<float> time;
+        std::vector<glm::vec3> velocity;
+
+        /**
+         * Invokes function with every <attribute array, pointer to particle member>
+         */
+        template<typename Self, typename Function>
+        static void forEach(Self& self, Function&& f) {
+            f(self.color, &Particle::color);
+            f(self.subUV, &Particle::subUV);
+            f(self.properties, &Particle::properties);
+            f(self.acceleration, &Particle::acceleration);
+            f(self.lifetime, &Particle::lifetime);
+            f(self.position, &Particle::position);
+            f(self.size, &Particle::size);
+            f(self.rotation, &Particle::rotation);
+            f(self.time, &Particle::time);
+            f(self.velocity, &Particle::velocity);
+        }
+    };
+
+    template<typename Particle>
+    class ParticleArrays;
+
+    template<>
+    class ParticleArrays<SpriteParticle> : public CommonParticleArrays<SpriteParticle, float> {};
+
+    template<>
+    class ParticleArrays<MeshParticle> : public CommonParticleArrays<MeshParticle, glm::vec3> {
+    public:
+        std::vector<glm::mat4> model;
+
+        template<typename Self, typename Function>
+        static void forEach(Self& self, Function&& f) {
+            CommonParticleArrays::forEach(self, f);
+            f(self.model, &MeshParticle::model);
+        }
+    };
+
+    template<>
+    class ParticleArrays<BeamParticle> : public CommonParticleArrays<BeamParticle, float> {
+    public:
+        std::vector<float> displacement;
+        std::vector<glm::vec3> target;
+        std::vector<float> offset;
+        std::vector<float> speed;
+        std::vector<float> length;
+        std::vector<std::chrono::time_point<std::chrono::steady_clock>> speed_start;
+        std::vector<std::chrono::duration<float>> rebuild_delta;
+        std::vector<std::vector<glm::vec3>> derivative_line;
+        std::vector<std::chrono::time_point<std::chrono::steady_clock>> last_rebuild;
+
+        template<typename Self, typename Function>
+        static void forEach(Self& self, Function&& f) {
+            CommonParticleArrays::forEach(self, f);
+            f(self.displacement, &BeamParticle::displacement);
+            f(self.target, &BeamParticle::target);
+            f(self.offset, &BeamParticle::offset);
+            f(self.speed, &BeamParticle::speed);
+            f(self.length, &BeamParticle::length);
+            f(self.speed_start, &BeamParticle::speed_start);
+            f(self.rebuild_delta, &BeamParticle::rebuild_delta);
+            f(self.derivative_line, &BeamParticle::derivative_line);
+            f(self.last_rebuild, &BeamParticle::last_rebuild);
+        }
+    };
+
+    /**
+     * ParticlePool stores emitter particles as structure of arrays
+     *
+     * modules update only attribute arrays they need, so large emitters are processed at memory bandwidth;
+     * particles are removed by swapping with the last one, order of particles is not preserved
+     */
+    template<typename Particle>
+    class ParticlePool final : public ParticleArrays<Particle> {
+    private:
+        using Arrays = ParticleArrays<Particle>;
+    public:
+        [[nodiscard]] size_t count() const noexcept { return this->lifetime.size(); }
+        [[nodiscard]] bool empty() const noexcept { return this->lifetime.empty(); }
+
+        void reserve(size_t count) {
+            Arrays::forEach(*this, [&] (auto& array, auto) { array.reserve(count); });
+        }
+
+        void clear() noexcept {
+            Arrays::forEach(*this, [] (auto& array, auto) { array.clear(); });
+        }
+
+        /**
+         * Adds particle at the end of pool
+         */
+        void push(const Particle& particle) {
+            Arrays::forEach(*this, [&] (auto& array, auto member) { array.push_back(particle.*member); });
+        }
+
+        /**
+         * Removes particle at index by moving the last particle in its place
+         */
+        void remove(size_t index) noexcept {
+            Arrays::forEach(*this, [&] (auto& array, auto) {
+                if (index + 1 != array.size()) {
+                    array[index] = std::move(array.back());
+                }
+                array.pop_back();
+            });
+        }
+
+        /**
+         * Assembles particle at index
+         */
+        [[nodiscard]] Particle get(size_t index) const {
+            Particle particle {};
+            Arrays::forEach(*this, [&] (const auto& array, auto member) { particle.*member = array[index]; });
+            return particle;
+        }
+
+        /**
+         * Assembles up to max_count particles into continuous memory, used to write them straight to mapped GPU storage
+         *
+         * every particle is assembled locally and stored as a whole in order, so write-combined memory is written
+         * once sequentially; returns count of written particles
+         */
+        size_t gather(Particle* out, size_t max_count) const {
+            const auto written = std::min(max_count, count());
+            for (size_t i = 0; i < written; ++i) {
+                out[i] = get(i);
+            }
+            return written;
+        }
+
+        void gather(std::vector<Particle>& out) const {
+            const auto offset = out.size();
+            out.resize(offset + count());
+            gather(out.data() + offset, count());
+        }
+    };
+}
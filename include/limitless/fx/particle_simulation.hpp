@@ -0,0 +1,106 @@
+#pragma once
+
+#include <limitless/fx/emitters/emitter.hpp>
+
+#include <memory>
+
+namespace Limitless {
+    class Buffer;
+    class VertexArray;
+    class ShaderProgram;
+    class AbstractMesh;
+}
+
+namespace Limitless::fx {
+    /**
+     * ParticleSimulation keeps emitter particles on GPU and simulates them with ParticleSimulation compute shader
+     *
+     * emitter only accumulates emitted count and elapsed time, render thread then dispatches two stages:
+     * update applies modules to alive particles, returns dead ones to free list and compacts the rest into draw buffer;
+     * emit takes free slots of state buffer for new particles and appends them to draw buffer;
+     * alive count is written by shader into indirect draw command, so particles are never read back
+     */
+    template<typename Particle>
+    class ParticleSimulation final {
+    public:
+        static constexpr uint32_t WORKGROUP_SIZE = 256;
+
+        /**
+         * Largest time simulated by one step
+         *
+         * time is accumulated until render pass dispatches simulation, so effect that was culled for a while
+         * is not stepped by all skipped time at once
+         */
+        static constexpr float MAX_STEP = 0.1f;
+
+        static constexpr auto STATE_BUFFER_NAME = "particle_simulation_state";
+        static constexpr auto FREE_LIST_BUFFER_NAME = "particle_simulation_free_list";
+        static constexpr auto DRAW_BUFFER_NAME = "particle_simulation_draw";
+        static constexpr auto COMMAND_BUFFER_NAME = "particle_simulation_command";
+    private:
+        // all particle slots, dead ones have non-positive lifetime
+        std::shared_ptr<Buffer> state;
+        // count and indices of dead slots
+        std::shared_ptr<Buffer> free_list;
+        // alive particles of the last step
+        std::shared_ptr<Buffer> draw_particles;
+        // indirect draw command, alive count is accumulated in it
+        std::shared_ptr<Buffer> command;
+        // sprite particles are drawn as points straight from draw buffer
+        std::unique_ptr<VertexArray> vertex_array;
+
+        uint32_t max_count;
+
+        // accumulated by emitter until next simulation step
+        uint32_t pending_emit {};
+        float pending_time {};
+
+        // advanced every step to get different random values
+        uint32_t seed {};
+
+        void initialize();
+        void dispatch(ShaderProgram& program, uint32_t stage, uint32_t count);
+    public:
+        explicit ParticleSimulation(uint32_t max_count) noexcept;
+        ~ParticleSimulation();
+
+        ParticleSimulation(const ParticleSimulation&) = delete;
+        ParticleSimulation(ParticleSimulation&&) = delete;
+
+        /**
+         * Checks whether context is able to simulate particles on GPU
+         */
+        [[nodiscard]] static bool isSupported() noexcept;
+
+        /**
+         * Checks whether emitter can be simulated on GPU
+         *
+         * only modules with shader implementation and constant or range distributions are supported,
+         * particles in local space are not
+         */
+        [[nodiscard]] static bool isSupported(const Emitter<Particle>& emitter) noexcept;
+
+        /**
+         * Accumulates particles to be emitted on next step, called by emitter on update
+         */
+        void emit(uint32_t count) noexcept;
+
+        /**
+         * Accumulates time to be simulated on next step, called by emitter on update
+         */
+        void advance(float dt) noexcept;
+
+        /**
+         * Simulates accumulated time and emits accumulated particles
+         *
+         * must be called from render thread with context current
+         */
+        void update(ShaderProgram& program, const Emitter<Particle>& emitter);
+
+        /**
+         * Draws alive particles with shader that is currently in use
+         */
+        void draw();
+        void draw(AbstractMesh& mesh);
+    };
+}
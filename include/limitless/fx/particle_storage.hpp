@@ -0,0 +1,86 @@
+#pragma once
+
+#include <limitless/core/sync.hpp>
+#include <limitless/core/abstract_vertex_stream.hpp>
+
+#include <array>
+#include <memory>
+
+namespace Limitless {
+    class Buffer;
+    class VertexArray;
+}
+
+namespace Limitless::fx {
+    /**
+     * ParticleStorage is a ring of frame regions inside one mapped buffer that emitter renderers write particles into
+     *
+     * every frame renderers reserve ranges of the current region and emitters write their particles straight into mapped memory;
+     * region is written again only after fence placed when it was last used is signaled, so nothing is orphaned or copied;
+     * particles that do not fit are dropped for one frame and the ring grows on next begin
+     */
+    template<typename Particle>
+    class ParticleStorage final {
+    public:
+        static constexpr uint32_t FRAME_COUNT = 3;
+        static constexpr size_t INITIAL_CAPACITY = 4096;
+
+        class Range {
+        public:
+            // mapped memory of range
+            Particle* data {};
+            // index of the first particle inside buffer
+            size_t first {};
+            size_t count {};
+        };
+    private:
+        std::shared_ptr<Buffer> buffer;
+        // sprites and beams are drawn as vertices of storage
+        std::unique_ptr<VertexArray> vertex_array;
+        std::array<Sync, FRAME_COUNT> fences;
+
+        // mapped memory of current region
+        Particle* mapped {};
+        // particle count of one region
+        size_t capacity {};
+        size_t frame {};
+        size_t used {};
+        // particles requested in current frame including the ones that did not fit
+        size_t requested {};
+        // buffer is mapped once if GL_ARB_buffer_storage is supported, otherwise region is mapped every frame
+        bool persistent {};
+
+        void allocate(size_t capacity);
+        static void wait(Sync& fence);
+    public:
+        ParticleStorage() noexcept;
+        ~ParticleStorage();
+
+        ParticleStorage(const ParticleStorage&) = delete;
+        ParticleStorage(ParticleStorage&&) = delete;
+
+        /**
+         * Switches to the next region and waits until GPU has finished reading it
+         */
+        void begin();
+
+        /**
+         * Reserves range of count particles in current region
+         *
+         * returned range is shorter if region is full
+         */
+        [[nodiscard]] Range reserve(size_t count) noexcept;
+
+        /**
+         * Finishes writing of current region, must be called before drawing
+         */
+        void end() noexcept;
+
+        /**
+         * Draws particles of range as vertices
+         */
+        void draw(VertexStreamDraw mode, const Range& range) const noexcept;
+
+        [[nodiscard]] Buffer& getBuffer() const noexcept { return *buffer; }
+    };
+}
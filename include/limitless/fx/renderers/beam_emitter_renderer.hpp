@@ -2,22 +2,46 @@
 
 #include <limitless/fx/emitters/abstract_emitter.hpp>
 #include <limitless/fx/emitters/beam_emitter.hpp>
+#include <limitless/fx/particle_storage.hpp>
+
+#include <algorithm>
 
 namespace Limitless::fx {
     template<>
     class EmitterRenderer<BeamParticle> : public AbstractEmitterRenderer {
     private:
-        VertexStream<BeamParticleMapping> stream;
+        // emitters added in current frame, storage is kept between frames
+        std::vector<const BeamEmitter*> emitters;
+        ParticleStorage<BeamParticleMapping>::Range range;
 
         const UniqueEmitterShader unique_type;
     public:
         EmitterRenderer(const BeamEmitter& emitter)
-            : stream {emitter.getSpawn().max_count * EMITTER_STORAGE_INSTANCE_COUNT, VertexStreamUsage::Dynamic, VertexStreamDraw::Triangles}
-            , unique_type {emitter.getUniqueShaderType()} {
+            : unique_type {emitter.getUniqueShaderType()} {
+        }
+
+        void add(const BeamEmitter& emitter) {
+            emitters.emplace_back(&emitter);
         }
 
-        void update(ParticleCollector<BeamParticleMapping>& collector) {
-            stream.update(collector.yield());
+        void update(ParticleStorage<BeamParticleMapping>& storage) {
+            size_t count {};
+            for (const auto* emitter : emitters) {
+                count += emitter->getParticles().size();
+            }
+
+            range = storage.reserve(count);
+
+            auto* out = range.data;
+            auto left = range.count;
+            for (const auto* emitter : emitters) {
+                const auto& particles = emitter->getParticles();
+                const auto written = std::min(left, particles.size());
+                out = std::copy_n(particles.begin(), written, out);
+                left -= written;
+            }
+
+            emitters.clear();
         }
 
         void draw(Context& ctx,
@@ -25,7 +49,8 @@ namespace Limitless::fx {
                   ShaderType shader_type,
                   const ms::Material& material,
                   ms::Blending blending,
-                  const UniformSetter& setter) {
+                  const UniformSetter& setter,
+                  const ParticleStorage<BeamParticleMapping>& storage) {
 
             if (material.getBlending() != blending) {
                 return;
@@ -47,7 +72,7 @@ namespace Limitless::fx {
 
             shader.use();
 
-            stream.draw();
+            storage.draw(VertexStreamDraw::Triangles, range);
         }
     };
-}
\ No newline at end of file
+}
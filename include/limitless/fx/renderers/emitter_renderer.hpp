@@ -5,8 +5,6 @@
 namespace Limitless::fx {
     class AbstractEmitter;
 
-    static constexpr auto EMITTER_STORAGE_INSTANCE_COUNT = 3;
-
     class AbstractEmitterRenderer {
 
     };
@@ -1,48 +1,59 @@
 #pragma once
 
 #include <limitless/fx/renderers/emitter_renderer.hpp>
+#include <limitless/fx/emitters/mesh_emitter.hpp>
+#include <limitless/fx/particle_simulation.hpp>
+#include <limitless/fx/particle_storage.hpp>
+#include <limitless/core/uniform/uniform_name.hpp>
 
 namespace Limitless::fx {
     template<>
     class EmitterRenderer<MeshParticle> : public AbstractEmitterRenderer {
     private:
-        std::shared_ptr<Buffer> buffer;
-        uint64_t max_particle_count {};
-
-        uint64_t current_particle_count {};
+        // emitters added in current frame, storage is kept between frames
+        std::vector<const MeshEmitter*> emitters;
+        std::vector<ParticleSimulation<MeshParticle>*> simulations;
+        ParticleStorage<MeshParticle>::Range range;
 
         const UniqueEmitterShader unique_type;
 
-        void checkStorageSize(uint64_t count) {
-            if (count > max_particle_count) {
-                max_particle_count = count;
-                buffer = Buffer::builder()
-                        .target(Buffer::Type::ShaderStorage)
-                        .usage(Buffer::Usage::DynamicDraw)
-                        .access(Buffer::MutableAccess::WriteOrphaning)
-                        .size(sizeof(MeshParticle) * max_particle_count)
-                        .build();
-            }
-        }
-
         static constexpr auto SHADER_MESH_BUFFER_NAME = "mesh_emitter_particles";
+        // index of the first particle of renderer in storage buffer
+        static inline const UniformName PARTICLE_OFFSET {"particle_offset"};
     public:
         explicit EmitterRenderer(const MeshEmitter& emitter)
-            : max_particle_count {emitter.getSpawn().max_count * EMITTER_STORAGE_INSTANCE_COUNT}
-            , unique_type {emitter.getUniqueShaderType()} {
-            buffer = Buffer::builder()
-                    .target(Buffer::Type::ShaderStorage)
-                    .usage(Buffer::Usage::DynamicDraw)
-                    .access(Buffer::MutableAccess::WriteOrphaning)
-                    .size(sizeof(MeshParticle) * max_particle_count)
-                    .build();
+            : unique_type {emitter.getUniqueShaderType()} {
         }
 
-        void update(ParticleCollector<MeshParticle>& collector) {
-            const auto& particles = collector.yield();
-            checkStorageSize(particles.size());
-            current_particle_count = particles.size();
-            buffer->mapData(particles.data(), sizeof(MeshParticle) * current_particle_count);
+        void add(const MeshEmitter& emitter) {
+            emitters.emplace_back(&emitter);
+        }
+
+        void update(const Assets& assets, ParticleStorage<MeshParticle>& storage) {
+            size_t count {};
+            for (const auto* emitter : emitters) {
+                if (!emitter->getSimulation()) {
+                    count += emitter->getParticles().count();
+                }
+            }
+
+            range = storage.reserve(count);
+
+            simulations.clear();
+            auto* out = range.data;
+            auto left = range.count;
+            for (const auto* emitter : emitters) {
+                if (auto* simulation = emitter->getSimulation()) {
+                    simulation->update(assets.shaders.get({emitter->getUniqueShaderType(), ShaderType::ParticleSimulation}), *emitter);
+                    simulations.emplace_back(simulation);
+                } else {
+                    const auto written = emitter->getParticles().gather(out, left);
+                    out += written;
+                    left -= written;
+                }
+            }
+
+            emitters.clear();
         }
 
         void draw(Context& ctx,
@@ -51,8 +62,9 @@ namespace Limitless::fx {
                   const std::shared_ptr<AbstractMesh>& mesh,
                   const ms::Material& material,
                   ms::Blending blending,
-                  const UniformSetter& setter) const {
-            if (current_particle_count == 0 || material.getBlending() != blending) {
+                  const UniformSetter& setter,
+                  const ParticleStorage<MeshParticle>& storage) const {
+            if ((range.count == 0 && simulations.empty()) || material.getBlending() != blending) {
                 return;
             }
 
@@ -69,13 +81,26 @@ namespace Limitless::fx {
 
             setter(shader);
 
-            Context::apply([this] (Context& ctx) {
-                buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, SHADER_MESH_BUFFER_NAME));
-            });
+            if (range.count != 0) {
+                Context::apply([&storage] (Context& ctx) {
+                    storage.getBuffer().bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, SHADER_MESH_BUFFER_NAME));
+                });
 
-            shader.use();
+                shader.setUniform(PARTICLE_OFFSET, static_cast<uint32_t>(range.first));
+                shader.use();
 
-            mesh->draw_instanced(current_particle_count);
+                mesh->draw_instanced(range.count);
+            }
+
+            if (!simulations.empty()) {
+                // simulations bind their own buffers starting from the first particle
+                shader.setUniform(PARTICLE_OFFSET, 0u);
+                shader.use();
+
+                for (auto* simulation : simulations) {
+                    simulation->draw(*mesh);
+                }
+            }
         }
     };
-}
\ No newline at end of file
+}
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <limitless/fx/renderers/emitter_renderer.hpp>
-#include <limitless/fx/emitters/visitor_collector.hpp>
 #include <limitless/fx/emitters/sprite_emitter.hpp>
+#include <limitless/fx/particle_simulation.hpp>
+#include <limitless/fx/particle_storage.hpp>
 
 #include "limitless/core/shader/shader_program.hpp"
 #include <limitless/assets.hpp>
@@ -12,17 +13,46 @@ namespace Limitless::fx {
     template<>
     class EmitterRenderer<SpriteParticle> : public AbstractEmitterRenderer {
     private:
-        VertexStream<SpriteParticle> stream;
+        // emitters added in current frame, storage is kept between frames
+        std::vector<const SpriteEmitter*> emitters;
+        std::vector<ParticleSimulation<SpriteParticle>*> simulations;
+        ParticleStorage<SpriteParticle>::Range range;
 
         const UniqueEmitterShader unique_shader;
     public:
         explicit EmitterRenderer(const SpriteEmitter& emitter)
-            : stream {emitter.getSpawn().max_count * EMITTER_STORAGE_INSTANCE_COUNT, VertexStreamUsage::Dynamic, VertexStreamDraw::Points}
-            , unique_shader {emitter.getUniqueShaderType()} {
+            : unique_shader {emitter.getUniqueShaderType()} {
         }
 
-        void update(ParticleCollector<SpriteParticle>& collector) {
-            stream.update(collector.yield());
+        void add(const SpriteEmitter& emitter) {
+            emitters.emplace_back(&emitter);
+        }
+
+        void update(const Assets& assets, ParticleStorage<SpriteParticle>& storage) {
+            size_t count {};
+            for (const auto* emitter : emitters) {
+                if (!emitter->getSimulation()) {
+                    count += emitter->getParticles().count();
+                }
+            }
+
+            range = storage.reserve(count);
+
+            simulations.clear();
+            auto* out = range.data;
+            auto left = range.count;
+            for (const auto* emitter : emitters) {
+                if (auto* simulation = emitter->getSimulation()) {
+                    simulation->update(assets.shaders.get({emitter->getUniqueShaderType(), ShaderType::ParticleSimulation}), *emitter);
+                    simulations.emplace_back(simulation);
+                } else {
+                    const auto written = emitter->getParticles().gather(out, left);
+                    out += written;
+                    left -= written;
+                }
+            }
+
+            emitters.clear();
         }
 
         void draw(Context& ctx,
@@ -30,7 +60,8 @@ namespace Limitless::fx {
                   ShaderType pass,
                   const ms::Material& material,
                   ms::Blending blending,
-                  const UniformSetter& setter) {
+                  const UniformSetter& setter,
+                  const ParticleStorage<SpriteParticle>& storage) {
 
             if (material.getBlending() != blending) {
                 return;
@@ -52,7 +83,11 @@ namespace Limitless::fx {
 
             shader.use();
 
-            stream.draw();
+            storage.draw(VertexStreamDraw::Points, range);
+
+            for (auto* simulation : simulations) {
+                simulation->draw();
+            }
         }
     };
 }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Limitless {
+    /**
+     * AnimationLod describes how often poses of skeletal instances are evaluated depending on distance to camera
+     *
+     * instance farther than level distance is evaluated once per level interval frames, instances are staggered by id
+     * so evaluations of one level are spread over frames; level with limited depth samples channels of skeleton nodes
+     * only up to that depth and deeper nodes keep their bind pose
+     */
+    class AnimationLod final {
+    public:
+        static constexpr auto ALL_DEPTHS = static_cast<uint32_t>(-1);
+
+        struct Level {
+            float distance;
+            uint32_t interval;
+            uint32_t max_depth;
+        };
+    private:
+        // sorted by distance
+        std::vector<Level> levels;
+    public:
+        AnimationLod();
+        explicit AnimationLod(std::vector<Level> levels);
+
+        /**
+         * Returns level for distance to camera
+         */
+        [[nodiscard]] Level select(float distance) const noexcept;
+
+        /**
+         * Whether instance is evaluated at frame
+         */
+        [[nodiscard]] static bool isDue(const Level& level, uint64_t frame, uint64_t id) noexcept {
+            return (frame + id) % level.interval == 0;
+        }
+
+        [[nodiscard]] const auto& getLevels() const noexcept { return levels; }
+    };
+}
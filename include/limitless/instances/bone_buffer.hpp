@@ -0,0 +1,119 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+namespace Limitless {
+    class Buffer;
+    class Context;
+
+    /**
+     * BoneBuffer is a global shader storage that contains bone matrices of all skeletal instances
+     *
+     * Every skeletal instance owns a range of matrices for its whole lifetime, shaders find the range by
+     * 'bone_offset' of instance data, so all skeletal instances are drawn with one bound buffer
+     *
+     * Ranges are written from animation jobs in parallel, so writing does not lock;
+     * it must not overlap with acquiring or releasing ranges
+     *
+     * If GL_ARB_buffer_storage is supported storage is triple-buffered and persistently mapped;
+     * upload is skipped in frames without writes, persistent storage then stays on the region written last
+     */
+    class BoneBuffer final {
+    public:
+        static constexpr auto BUFFER_NAME = "bone_buffer";
+        static constexpr uint32_t INITIAL_CAPACITY = 4096;
+
+        /**
+         * Owning handle of bone matrices range
+         *
+         * Copy acquires new range of the same size, move transfers ownership
+         */
+        class Range final {
+        private:
+            uint32_t offset;
+            uint32_t count;
+        public:
+            explicit Range(uint32_t count = 0);
+            ~Range();
+
+            Range(const Range&);
+            Range& operator=(const Range&) = delete;
+
+            Range(Range&&) noexcept;
+            Range& operator=(Range&&) noexcept;
+
+            [[nodiscard]] auto getOffset() const noexcept { return offset; }
+            [[nodiscard]] auto getCount() const noexcept { return count; }
+        };
+    private:
+        /**
+         * CPU copy of all ranges
+         */
+        std::vector<glm::mat4> data;
+
+        /**
+         * Released ranges to reuse, instances of the same model take ranges of the same size
+         */
+        std::vector<std::pair<uint32_t, uint32_t>> free_ranges;
+
+        /**
+         * GPU storage
+         */
+        std::shared_ptr<Buffer> buffer;
+
+        /**
+         * Context buffer has been created for
+         */
+        Context* owner {};
+
+        /**
+         * Whether buffer is persistently mapped
+         */
+        bool persistent {};
+
+        /**
+         * Whether matrices have been written since last upload
+         */
+        std::atomic<bool> dirty {};
+
+        std::mutex mutex;
+
+        BoneBuffer() = default;
+
+        uint32_t acquire(uint32_t count);
+        void release(uint32_t offset, uint32_t count) noexcept;
+
+        /**
+         * Returns true if storage has been created or resized
+         */
+        bool ensureStorage(Context& ctx);
+    public:
+        ~BoneBuffer();
+
+        BoneBuffer(const BoneBuffer&) = delete;
+        BoneBuffer(BoneBuffer&&) = delete;
+
+        static BoneBuffer& get();
+
+        /**
+         * Writes matrices to the range
+         *
+         * data gets to GPU on next upload
+         */
+        void write(const Range& range, const glm::mat4* matrices) noexcept;
+
+        /**
+         * Copies all ranges to GPU if they have been written and binds buffer
+         *
+         * Should be called once per frame after scene is updated
+         */
+        void upload(Context& ctx);
+
+        [[nodiscard]] const auto& getBuffer() const noexcept { return buffer; }
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <limitless/instances/instance.hpp>
 #include <limitless/fx/emitters/abstract_emitter.hpp>
+#include <limitless/util/frame_clock.hpp>
 
 #include <unordered_map>
 #include <stdexcept>
@@ -39,12 +40,17 @@ namespace Limitless {
          */
         std::string name;
 
+        /**
+         * Clock of effects updated on their own, such as attachments; effects of scene are stepped by scene clock
+         */
+        FrameClock clock;
+
         /**
          * Checks if effect is finished
          */
         bool isDone() const noexcept;
 
-        void updateEmitters(const Camera& camera) const noexcept;
+        void setEmittersTransform() const noexcept;
 
         friend class fx::EffectBuilder;
         friend class EffectSerializer;
@@ -68,10 +74,27 @@ namespace Limitless {
         std::unique_ptr<Instance> clone() noexcept override;
 
         /**
-         * Updates instance and then emitters
+         * Updates instance and then emitters with own realtime clock
          */
         void update(const Camera &camera) override;
 
+        /**
+         * Updates instance and then emitters with specified clock
+         */
+        void update(const Camera &camera, const FrameClock& frame_clock);
+
+        /**
+         * Updates instance and passes its transformation to emitters without simulating them
+         *
+         * used with finishUpdate() by Scene to simulate emitters of all effects in parallel
+         */
+        void beginUpdate(const Camera& camera);
+
+        /**
+         * Completes update after emitters are simulated
+         */
+        void finishUpdate() noexcept;
+
         const auto& getEmitters() const noexcept { return emitters; }
         auto& getEmitters() noexcept { return emitters; }
         const auto& getName() const noexcept { return name; }
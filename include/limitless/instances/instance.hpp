@@ -6,6 +6,7 @@
 #include <limitless/util/frustum.hpp>
 #include <optional>
 #include <limitless/core/buffer/buffer.hpp>
+#include <limitless/instances/instance_buffer.hpp>
 
 namespace Limitless {
     enum class ShaderType;
@@ -126,36 +127,46 @@ namespace Limitless {
         bool pickable {true};
 
         /**
-         * Instance data structure to GPU map
+         * Whether position, rotation or scale has changed since last update
+         */
+        bool model_changed {true};
+
+        /**
+         * Whether final matrix and bounding box have to be recomputed
+         *
+         * set when instance itself or its parent has moved, so static hierarchies are not recomputed every frame
          */
-         class Data {
-         public:
-             glm::mat4 model_matrix;
-             glm::vec4 outline_color;
-             uint32_t id;
-             uint32_t is_outlined;
-             uint32_t decal_mask;
-             uint32_t pad {};
+        bool transform_changed {true};
 
-             bool operator!=(const Data& rhs) const noexcept {
-                 return std::tie(model_matrix, outline_color, id, is_outlined, decal_mask) !=
-                        std::tie(rhs.model_matrix, rhs.outline_color, rhs.id, rhs.is_outlined, rhs.decal_mask);
-             }
+        /**
+         * Whether final matrix was recomputed since last update
+         */
+        bool moved {true};
 
-             bool operator==(const Data& rhs) const noexcept {
-                 return !(*this != rhs);
-             }
-         };
+        /**
+         * Whether outline, decal mask or bone offset has changed since buffer data was written
+         */
+        bool data_changed {true};
 
-         /**
-          * Instance buffer on GPU
-          */
-         std::shared_ptr<Buffer> instance_buffer;
+        /**
+         * Instance data structure to GPU map
+         */
+        using Data = InstanceData;
 
-         /**
-          * Current buffer data
-          */
-         Data current_data {};
+        /**
+         * Slot of this instance in global instance buffer
+         */
+        InstanceBuffer::Slot slot;
+
+        /**
+         * First matrix of instance bones in global bone buffer, set by skeletal instances
+         */
+        uint32_t bone_offset {};
+
+        /**
+         * Current buffer data
+         */
+        Data current_data {};
 
         /**
          * Default implementation of bounding box updates sets custom user box if present
@@ -164,8 +175,19 @@ namespace Limitless {
 
 		void updateModelMatrix() noexcept;
 		void updateFinalMatrix() noexcept;
+
+        /**
+         * Recomputes model and final matrices with bounding box if instance or its parent has moved
+         */
+        void updateTransform() noexcept;
+
+        /**
+         * Writes buffer data only if instance has moved or its data has changed
+         */
         void updateInstanceBuffer() noexcept;
 
+        void setBoneOffset(uint32_t offset) noexcept;
+
         Instance(InstanceType shader_type, const glm::vec3& position) noexcept;
     public:
         ~Instance() override = default;
@@ -186,14 +208,18 @@ namespace Limitless {
         [[nodiscard]] const auto& getScale() const noexcept { return scale; }
 
         [[nodiscard]] const auto& getTransformationMatrix() const noexcept { return transformation_matrix; }
-        [[nodiscard]] const auto& getBoundingBox() noexcept { updateBoundingBox(); return bounding_box; }
+
+        /**
+         * Bounding box of current transformation, matrices are recomputed first if instance has moved since last update
+         */
+        [[nodiscard]] const Box& getBoundingBox() noexcept;
         [[nodiscard]] const auto& getFinalMatrix() const noexcept { return final_matrix; }
         [[nodiscard]] const auto& getModelMatrix() const noexcept { return model_matrix; }
 
         [[nodiscard]] const auto& getDecalMask() const noexcept { return decal_mask; }
         [[nodiscard]] const auto& getOutlineColor() const noexcept { return outline_color; }
         [[nodiscard]] const auto& getCurrentData() const noexcept { return current_data; }
-        [[nodiscard]] const auto& getInstanceBuffer() const noexcept { return instance_buffer; }
+        [[nodiscard]] auto getInstanceSlot() const noexcept { return slot.getIndex(); }
 
         /**
          * Instance outlined
@@ -295,6 +321,8 @@ namespace Limitless {
 
         /**
          * Updates instance data
+         *
+         * matrices and bounding box are recomputed only if instance or its parent has moved
          */
 		virtual void update(const Camera &camera);
 
@@ -18,6 +18,29 @@ namespace Limitless {
 }
 
 namespace Limitless {
+    /**
+     * Gets notified about changes that affect spatial indexing of observed instances
+     */
+    class InstanceObserver {
+    public:
+        virtual ~InstanceObserver() = default;
+
+        /**
+         * Bounding box, visibility or liveness of instance has changed
+         */
+        virtual void onInstanceChanged(Instance& instance) = 0;
+
+        /**
+         * Instance has been attached to observed one
+         */
+        virtual void onInstanceAttached(const std::shared_ptr<Instance>& instance) = 0;
+
+        /**
+         * Instance is about to be detached from observed one
+         */
+        virtual void onInstanceDetached(Instance& instance) = 0;
+    };
+
     /**
      * InstanceAttachment is base class for any instance that can have an attachments of another instances
      *
@@ -46,6 +69,11 @@ namespace Limitless {
 	private:
 		std::map<AttachmentID, std::shared_ptr<Instance>> attachments;
 	protected:
+        /**
+         * Scene this instance is indexed in, it is not copied
+         */
+        InstanceObserver* observer {};
+
         /**
          * Sets parent matrix to attachments
          */
@@ -87,5 +115,8 @@ namespace Limitless {
 
 		auto& getAttachments() noexcept { return attachments; }
 		[[nodiscard]] const auto& getAttachments() const noexcept { return attachments; }
+
+        [[nodiscard]] auto* getObserver() const noexcept { return observer; }
+        void setObserver(InstanceObserver* _observer) noexcept { observer = _observer; }
 	};
 }
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <tuple>
+
+namespace Limitless {
+    class Buffer;
+    class Context;
+
+    /**
+     * Instance data structure to GPU map
+     */
+    class InstanceData {
+    public:
+        glm::mat4 model_matrix {1.0f};
+        glm::vec4 outline_color {};
+        uint32_t id {};
+        uint32_t is_outlined {};
+        uint32_t decal_mask {};
+        // first matrix of instance bones in bone buffer
+        uint32_t bone_offset {};
+
+        bool operator!=(const InstanceData& rhs) const noexcept {
+            return std::tie(model_matrix, outline_color, id, is_outlined, decal_mask, bone_offset) !=
+                   std::tie(rhs.model_matrix, rhs.outline_color, rhs.id, rhs.is_outlined, rhs.decal_mask, rhs.bone_offset);
+        }
+
+        bool operator==(const InstanceData& rhs) const noexcept {
+            return !(*this != rhs);
+        }
+    };
+
+    /**
+     * InstanceBuffer is a global shader storage that contains data of all instances
+     *
+     * Every instance owns a stable slot for its whole lifetime and writes its data there only when it changes,
+     * shaders index the buffer with per-draw 'instance_index' uniform
+     *
+     * If GL_ARB_buffer_storage is supported storage is triple-buffered and persistently mapped,
+     * so uploading changed slots is just a memcpy guarded by fences
+     */
+    class InstanceBuffer final {
+    public:
+        static constexpr auto BUFFER_NAME = "INSTANCE_BUFFER";
+        static constexpr uint32_t FRAME_COUNT = 3;
+        static constexpr uint32_t INITIAL_CAPACITY = 1024;
+
+        /**
+         * Owning handle of instance slot
+         *
+         * Copy acquires new slot, move transfers ownership
+         */
+        class Slot final {
+        private:
+            static constexpr uint32_t INVALID = UINT32_MAX;
+            uint32_t index;
+        public:
+            Slot();
+            ~Slot();
+
+            Slot(const Slot&);
+            Slot& operator=(const Slot&) = delete;
+
+            Slot(Slot&&) noexcept;
+            Slot& operator=(Slot&&) noexcept;
+
+            [[nodiscard]] auto getIndex() const noexcept { return index; }
+        };
+    private:
+        /**
+         * CPU copy of all slots
+         */
+        std::vector<InstanceData> data;
+
+        /**
+         * Amount of frames slot should be still copied to GPU
+         */
+        std::vector<uint8_t> pending;
+
+        /**
+         * Slots that have pending copies
+         */
+        std::vector<uint32_t> dirty;
+
+        /**
+         * Released slots to reuse
+         */
+        std::vector<uint32_t> free_slots;
+
+        /**
+         * GPU storage
+         */
+        std::shared_ptr<Buffer> buffer;
+
+        /**
+         * Context buffer has been created for
+         */
+        Context* owner {};
+
+        /**
+         * Whether buffer is persistently mapped
+         */
+        bool persistent {};
+
+        std::mutex mutex;
+
+        InstanceBuffer() = default;
+
+        uint32_t acquire();
+        void release(uint32_t slot) noexcept;
+
+        void markDirty(uint32_t slot) noexcept;
+        void ensureStorage(Context& ctx);
+    public:
+        ~InstanceBuffer();
+
+        InstanceBuffer(const InstanceBuffer&) = delete;
+        InstanceBuffer(InstanceBuffer&&) = delete;
+
+        static InstanceBuffer& get();
+
+        /**
+         * Writes instance data to the slot
+         *
+         * data gets to GPU on next upload
+         */
+        void write(uint32_t slot, const InstanceData& instance_data);
+
+        /**
+         * Copies changed slots to GPU and binds buffer
+         *
+         * Should be called once per frame after scene is updated
+         */
+        void upload(Context& ctx);
+
+        [[nodiscard]] const auto& getBuffer() const noexcept { return buffer; }
+    };
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <limitless/instances/animation_lod.hpp>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Limitless {
+    class SkeletalInstance;
+    class Camera;
+    class FrameClock;
+    struct Animation;
+
+    /**
+     * PoseCache updates skeletal instances in parallel and shares poses between them
+     *
+     * animation time is quantized to SAMPLE_RATE samples per second, so instances playing the same animation
+     * at the same sample get one evaluated pose; poses are evaluated by parallel jobs and then copied to the rest
+     *
+     * far instances are updated at rates of AnimationLod, their animation time still advances every frame
+     */
+    class PoseCache final {
+    public:
+        static constexpr double SAMPLE_RATE = 60.0;
+
+        /**
+         * Pose counts of the last update
+         */
+        struct Counters {
+            // poses evaluated from animation
+            uint32_t evaluated {};
+            // poses copied from instance at the same sample
+            uint32_t shared {};
+            // instances not updated this frame because of animation lod
+            uint32_t skipped {};
+        };
+    private:
+        struct Key {
+            const Animation* animation;
+            int64_t sample;
+            uint32_t max_depth;
+
+            bool operator==(const Key& rhs) const noexcept {
+                return animation == rhs.animation && sample == rhs.sample && max_depth == rhs.max_depth;
+            }
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key& key) const noexcept {
+                return std::hash<const void*>{}(key.animation) ^ (std::hash<int64_t>{}(key.sample) * 31) ^ (std::hash<uint32_t>{}(key.max_depth) * 17);
+            }
+        };
+
+        // instance that evaluates pose for every key
+        std::unordered_map<Key, SkeletalInstance*, KeyHash> evaluating;
+        std::vector<std::pair<SkeletalInstance*, uint32_t>> evaluated;
+        // instance and the one it copies pose from
+        std::vector<std::pair<SkeletalInstance*, const SkeletalInstance*>> shared;
+
+        AnimationLod lod;
+        Counters counters;
+        uint64_t frame {};
+    public:
+        /**
+         * Advances animations of instances by clock and updates poses of the ones due by animation lod
+         *
+         * containers are kept between frames
+         */
+        void update(const std::vector<SkeletalInstance*>& instances, const Camera& camera, const FrameClock& clock);
+
+        void setLod(AnimationLod _lod) noexcept { lod = std::move(_lod); }
+        [[nodiscard]] const auto& getLod() const noexcept { return lod; }
+        [[nodiscard]] const auto& getCounters() const noexcept { return counters; }
+    };
+}
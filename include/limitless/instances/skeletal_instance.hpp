@@ -3,11 +3,11 @@
 #include <limitless/instances/model_instance.hpp>
 #include <limitless/instances/socket_attachment.hpp>
 #include <limitless/models/skeletal_model.hpp>
+#include <limitless/instances/bone_buffer.hpp>
+#include <limitless/util/frame_clock.hpp>
 #include <chrono>
 
 namespace Limitless {
-    class Buffer;
-
     class no_such_animation : public std::runtime_error {
     public:
         using std::runtime_error::runtime_error;
@@ -26,9 +26,19 @@ namespace Limitless {
         std::vector<glm::mat4> bone_transform;
 
         /**
-         * OpenGL buffer for bone transformations
+         * Global transformations of flattened skeleton nodes of current frame
          */
-        std::shared_ptr<Buffer> bone_buffer;
+        std::vector<glm::mat4> node_transform;
+
+        /**
+         * Keyframe cursors for every animation node of current animation
+         */
+        std::vector<KeyframeCursor> cursors;
+
+        /**
+         * Range of bone transformations in global bone buffer
+         */
+        BoneBuffer::Range bone_range;
 
         /**
          * Current animation
@@ -41,22 +51,33 @@ namespace Limitless {
         bool paused {};
 
         /**
-         * Animation last update time
+         * Clock of instances that are not advanced by scene, such as attachments
+         *
+         * started on first own update, so its first delta does not include time instance was loaded for
          */
-        std::chrono::time_point<std::chrono::steady_clock> last_time;
+        std::optional<FrameClock> clock;
 
         /**
          * Current animation ongoing duration
          */
         std::chrono::duration<double> animation_duration {};
 
-        void initializeBuffer();
+        /**
+         * Current animation time in ticks
+         */
+        double animation_time {};
+
+        /**
+         * Whether animation has been advanced by scene in current frame
+         */
+        bool animation_advanced {};
 
         /**
-         * Updates bone transformation for current animation frame
+         * Whether animation is read from baked animations of model instead of being evaluated
          */
-        void updateAnimationFrame();
-        [[nodiscard]] const AnimationNode* findAnimationNode(const Bone& bone) const noexcept;
+        bool baked {};
+
+        void setAnimation(const Animation& animation) noexcept;
     public:
         /**
          * Creates instance with SkeletalModel
@@ -74,9 +95,35 @@ namespace Limitless {
 
         /**
          * Updates current animation, socket attachments data and instance itself
+         *
+         * animation is evaluated here only if it has not been advanced by scene
          */
         void update(const Camera &camera) override;
 
+        /**
+         * Advances current animation time by delta of clock
+         *
+         * returns false if there is nothing to evaluate
+         */
+        bool advanceAnimation(const FrameClock& frame_clock) noexcept;
+
+        /**
+         * Rounds current animation time down to sample of specified rate and returns sample index
+         */
+        int64_t sampleAnimationTime(double rate) noexcept;
+
+        /**
+         * Evaluates bone transformations for current animation time and writes them to bone buffer
+         *
+         * nodes deeper than max_depth keep bind pose; may be called from jobs, instances do not share state
+         */
+        void evaluatePose(uint32_t max_depth = static_cast<uint32_t>(-1));
+
+        /**
+         * Takes bone transformations of instance of the same model evaluated at the same animation time
+         */
+        void setPose(const SkeletalInstance& instance) noexcept;
+
         /**
          * Plays animation with name
          *
@@ -100,11 +147,19 @@ namespace Limitless {
          */
         SkeletalInstance& stop() noexcept;
 
+        /**
+         * Switches instance to baked animations of model, pose is not evaluated on CPU and sockets stay in last evaluated pose
+         *
+         * throws std::runtime_error if model animations are not baked
+         */
+        SkeletalInstance& setBaked(bool baked);
+        [[nodiscard]] auto isBaked() const noexcept { return baked; }
+
         [[nodiscard]] auto isPaused() const noexcept { return paused; }
         [[nodiscard]] const auto& getCurrentAnimation() const noexcept { return animation; }
         [[nodiscard]] const std::vector<Animation>& getAllAnimations() const noexcept;
         const std::vector<Bone>& getAllBones() const noexcept;
-        const auto& getBoneBuffer() const noexcept { return bone_buffer; }
+        [[nodiscard]] auto getBoneOffset() const noexcept { return bone_range.getOffset(); }
 
         /**
          * Calculates transformed vertex position on specified instance mesh for specified vertex
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <limitless/instances/skeletal_instance.hpp>
+#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/core/context.hpp>
+
+namespace Limitless {
+    /**
+     * SkeletalInstancedInstance draws skeletal instances of the same model with one instanced draw per mesh
+     *
+     * every instance keeps its own animation, shaders take instance data by instance index
+     * and find instance bones in global bone buffer by its bone offset
+     */
+    class SkeletalInstancedInstance : public Instance {
+    protected:
+        // contains all instanced skeletal models
+        std::vector<std::shared_ptr<SkeletalInstance>> instances;
+
+        // contains instances to be drawn in current frame
+        std::vector<std::shared_ptr<SkeletalInstance>> visible_instances;
+
+        // contains instance data for each visible SkeletalInstance
+        std::shared_ptr<Buffer> buffer;
+
+        std::vector<Data> current_instance_data;
+
+        void updateInstanceBuffer();
+    public:
+        SkeletalInstancedInstance();
+        ~SkeletalInstancedInstance() override = default;
+
+        SkeletalInstancedInstance(const SkeletalInstancedInstance& rhs);
+        SkeletalInstancedInstance(SkeletalInstancedInstance&&) noexcept = default;
+
+        std::unique_ptr<Instance> clone() noexcept override;
+
+        /**
+         * Adds instance to be drawn
+         *
+         * all instances must share the same SkeletalModel
+         */
+        void add(const std::shared_ptr<SkeletalInstance>& instance);
+        void remove(uint64_t id);
+
+        void update(const Camera &camera) override;
+
+        auto& getInstances() noexcept { return instances; }
+        [[nodiscard]] const auto& getInstances() const noexcept { return instances; }
+        auto& getVisibleInstances() noexcept { return visible_instances; }
+        auto& getBuffer() noexcept { return buffer ; }
+
+        /**
+         *  Sets visible instances to specified subset
+         */
+        void setVisible(const std::vector<std::shared_ptr<SkeletalInstance>>& visible);
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <limitless/core/framebuffer.hpp>
 #include <limitless/renderer/renderer_settings.hpp>
+#include <limitless/util/frustum_culling.hpp>
 
 namespace Limitless::fx {
     class EffectRenderer;
@@ -31,6 +32,12 @@ namespace Limitless {
     private:
         static constexpr auto SPLIT_WEIGHT {0.75f};
 
+        /**
+         * Minimal distance shadow volume is extended toward the light,
+         * it is used for casters that are not present in scene spatial index
+         */
+        static constexpr auto CASTER_DISTANCE {50.0f};
+
         glm::uvec2 shadow_resolution;
         uint8_t split_count;
 
@@ -41,9 +48,14 @@ namespace Limitless {
         std::shared_ptr<Buffer> light_buffer;
         std::vector<glm::mat4> light_space;
 
+        /**
+         * Shadow casters of each cascade
+         */
+        std::vector<FrustumCulling> cullings;
+
         void initBuffers();
         void updateFrustums(Context& ctx, const Camera& camera);
-        void updateLightMatrices(const Light& light);
+        void updateLightMatrices(const Light& light, const Box& casters);
     public:
         explicit CascadeShadows(const RendererSettings& settings);
         ~CascadeShadows();
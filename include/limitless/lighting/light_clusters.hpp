@@ -0,0 +1,96 @@
+#pragma once
+
+#include <limitless/lighting/light.hpp>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include <map>
+
+namespace Limitless {
+    class Buffer;
+    class Camera;
+
+    /**
+     * LightClusters assigns punctual lights to clusters of 3D grid aligned to camera frustum
+     *
+     * grid is uniform in screen space and exponential in view depth,
+     * lighting shaders iterate only lights of the cluster that contains shaded point
+     *
+     * buffer layout:
+     *  header - grid size and depth slicing parameters
+     *  grid - [offset, count] pair per cluster
+     *  indices - light indices referenced by grid
+     */
+    class LightClusters final {
+    public:
+        static constexpr uint32_t GRID_X = 16;
+        static constexpr uint32_t GRID_Y = 9;
+        static constexpr uint32_t GRID_Z = 24;
+        static constexpr uint32_t CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+        static constexpr auto BUFFER_NAME = "LIGHT_CLUSTERS";
+    private:
+        /**
+         * Buffer header presentation
+         */
+        struct Header {
+            glm::uvec4 size;
+            // near, far, slice scale, slice bias
+            glm::vec4 depth;
+        };
+
+        static constexpr size_t HEADER_SIZE = sizeof(Header) / sizeof(uint32_t);
+
+        /**
+         * Inclusive range of clusters affected by light
+         */
+        struct ClusterRange {
+            glm::uvec3 min;
+            glm::uvec3 max;
+            bool empty;
+        };
+
+        /**
+         * Light lists of one depth slice, built independently
+         */
+        struct Slice {
+            std::vector<uint32_t> grid;
+            std::vector<uint32_t> indices;
+        };
+
+        std::vector<glm::vec4> spheres;
+        std::vector<ClusterRange> ranges;
+        std::vector<Slice> slices;
+
+        /**
+         * Header, grid and indices in buffer layout
+         */
+        std::vector<uint32_t> data;
+
+        std::shared_ptr<Buffer> buffer;
+
+        Header header {};
+
+        [[nodiscard]] uint32_t getSlice(float depth) const noexcept;
+        [[nodiscard]] ClusterRange getRange(const glm::mat4& projection, const glm::vec3& center, float radius) const noexcept;
+        void buildSlice(uint32_t slice);
+        void upload();
+    public:
+        LightClusters();
+        ~LightClusters();
+
+        LightClusters(const LightClusters&) = delete;
+        LightClusters(LightClusters&&) = delete;
+
+        /**
+         * Rebuilds light lists for camera, light indices follow order of lights
+         */
+        void update(const Camera& camera, const std::map<uint64_t, Light>& lights);
+
+        /**
+         * Binds buffer to current context
+         */
+        void bind() const;
+
+        [[nodiscard]] size_t getIndexCount() const noexcept { return data.size() - HEADER_SIZE - CLUSTER_COUNT * 2; }
+    };
+}
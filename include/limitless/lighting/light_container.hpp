@@ -5,9 +5,11 @@
 #include <vector>
 #include <memory>
 #include <limitless/lighting/light.hpp>
+#include <limitless/lighting/light_clusters.hpp>
 
 namespace Limitless {
     class Buffer;
+    class Camera;
 
     class LightContainer {
     private:
@@ -44,6 +46,9 @@ namespace Limitless {
 
         // visible lights buffer
         std::shared_ptr<Buffer> buffer;
+
+        // per cluster lists of visible lights
+        LightClusters clusters;
     public:
         LightContainer();
         ~LightContainer() = default;
@@ -56,6 +61,9 @@ namespace Limitless {
         Light& add(Light&& light);
         Light& add(const Light& light);
 
-        void update();
+        /**
+         * Maps changed lights and assigns them to clusters of camera frustum
+         */
+        void update(const Camera& camera);
     };
 }
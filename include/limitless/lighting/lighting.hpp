@@ -5,6 +5,7 @@
 
 namespace Limitless {
     class Context;
+    class Camera;
 
     class Lighting final {
     private:
@@ -71,6 +72,6 @@ namespace Limitless {
         Light& add(Light&& light);
         Light& add(const Light& light);
 
-        void update();
+        void update(const Camera& camera);
     };
 }
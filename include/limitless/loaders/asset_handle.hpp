@@ -0,0 +1,72 @@
+#pragma once
+
+#include <exception>
+#include <atomic>
+#include <memory>
+
+namespace Limitless {
+    enum class AssetStatus {
+        Loading,
+        Ready,
+        Failed
+    };
+
+    /**
+     * Handle of asset that is loaded asynchronously by AssetManager
+     *
+     * resolves to placeholder until asset is published by AssetManager::update,
+     * and stays on placeholder if loading failed
+     */
+    template<typename T>
+    class AssetHandle final {
+    private:
+        struct State {
+            std::shared_ptr<T> asset;
+            std::shared_ptr<T> placeholder;
+            std::exception_ptr error;
+            std::atomic<AssetStatus> status {AssetStatus::Loading};
+        };
+
+        std::shared_ptr<State> state;
+
+        friend class AssetManager;
+
+        void resolve(std::shared_ptr<T> asset) noexcept {
+            state->asset = std::move(asset);
+            state->status.store(AssetStatus::Ready, std::memory_order_release);
+        }
+
+        void fail(std::exception_ptr error) noexcept {
+            state->error = std::move(error);
+            state->status.store(AssetStatus::Failed, std::memory_order_release);
+        }
+    public:
+        explicit AssetHandle(std::shared_ptr<T> placeholder = {})
+            : state {std::make_shared<State>()} {
+            state->placeholder = std::move(placeholder);
+        }
+
+        [[nodiscard]] AssetStatus getStatus() const noexcept { return state->status.load(std::memory_order_acquire); }
+        [[nodiscard]] bool isReady() const noexcept { return getStatus() == AssetStatus::Ready; }
+        [[nodiscard]] bool hasFailed() const noexcept { return getStatus() == AssetStatus::Failed; }
+
+        /**
+         * Returns loaded asset or placeholder while it is not ready
+         */
+        [[nodiscard]] const std::shared_ptr<T>& get() const noexcept {
+            return isReady() ? state->asset : state->placeholder;
+        }
+
+        [[nodiscard]] const std::shared_ptr<T>& getPlaceholder() const noexcept { return state->placeholder; }
+
+        /**
+         * Exception thrown by loading, empty unless failed
+         */
+        [[nodiscard]] std::exception_ptr getError() const noexcept {
+            return hasFailed() ? state->error : nullptr;
+        }
+
+        T* operator->() const noexcept { return get().get(); }
+        explicit operator bool() const noexcept { return get() != nullptr; }
+    };
+}
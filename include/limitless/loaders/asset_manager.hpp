@@ -1,53 +1,140 @@
 #pragma once
 
 #include <limitless/core/context_thread_pool.hpp>
-#include <limitless/models/abstract_model.hpp>
-#include <limitless/util/filesystem.hpp>
+#include <limitless/core/sync.hpp>
+#include <limitless/loaders/asset_handle.hpp>
+#include <limitless/loaders/gltf_model_loader.hpp>
 #include <limitless/loaders/texture_loader.hpp>
+#include <limitless/util/filesystem.hpp>
+#include <chrono>
+
+namespace Limitless::ms {
+    class Material;
+}
 
 namespace Limitless {
     class Assets;
+    class AbstractModel;
+    class EffectInstance;
+    class RendererSettings;
 
     fs::path getAssetsDir();
     fs::path getShadersDir();
 
+    /**
+     * AssetManager loads assets asynchronously on workers with contexts shared with main one
+     *
+     * file reading, glTF parsing, image decoding and creation of GL objects happen on workers,
+     * every job places fence after its commands; assets are published to Assets and their handles
+     * are resolved by update on main thread once fence is signaled
+     *
+     * vertex arrays are not shared between contexts, meshes generate them on first bind in drawing context
+     *
+     * with zero workers jobs are queued and run by update on calling thread within its budget
+     */
     class AssetManager final {
     private:
-        using future_model = std::future<std::function<std::shared_ptr<AbstractModel>()>>;
-        using future_asset = std::future<void>;
-
-        struct model_postproc {
-            future_model future;
-            std::function<void(future_model&)> addition;
+        /**
+         * Worker part of job returns its main thread part, it is run when fence is signaled
+         */
+        struct Job {
+            std::future<std::function<void()>> future;
+            std::shared_ptr<Sync> fence;
         };
 
-        std::vector<model_postproc> model_futures;
-        std::vector<future_asset> asset_futures;
         ContextThreadPool pool;
+        uint32_t workers;
+
+        std::vector<Job> jobs;
+
+        std::shared_ptr<AbstractModel> model_placeholder;
+        std::shared_ptr<Texture> texture_placeholder;
 
         Assets& assets;
+
+        /**
+         * Queues work, fence is placed on worker context after it
+         */
+        void schedule(std::function<std::function<void()>()> work);
+
+        /**
+         * Job is finished when its worker part returned and its commands are completed
+         */
+        static bool isFinished(Job& job);
+
+        /**
+         * Queues loading of asset which is resolved to handle by publish on main thread
+         *
+         * loading exception fails handle instead of being thrown
+         */
+        template<typename T, typename Load, typename Publish>
+        AssetHandle<T> loadAsync(std::shared_ptr<T> placeholder, Load&& load, Publish&& publish) {
+            AssetHandle<T> handle {std::move(placeholder)};
+
+            schedule([handle, load = std::forward<Load>(load), publish = std::forward<Publish>(publish)] () -> std::function<void()> {
+                try {
+                    return [handle, asset = load(), publish] () mutable {
+                        handle.resolve(publish(std::move(asset)));
+                    };
+                } catch (...) {
+                    return [handle, error = std::current_exception()] () mutable {
+                        handle.fail(error);
+                    };
+                }
+            });
+
+            return handle;
+        }
     public:
         AssetManager(Context& context, Assets& assets, uint32_t pool_size = std::thread::hardware_concurrency());
         ~AssetManager();
 
-        void loadModel(std::string asset_name, fs::path path, const ModelLoaderFlags& flags = {});
-        void loadTexture(fs::path path, const TextureLoaderFlags& flags = TextureLoaderFlags{});
+        AssetManager(const AssetManager&) = delete;
+        AssetManager& operator=(const AssetManager&) = delete;
 
-        void loadMaterial(std::string asset_name, fs::path path);
-        void loadEffect(std::string asset_name, fs::path path);
+        /**
+         * Loads glTF model and its materials and textures, model is added to assets with specified name when published
+         */
+        AssetHandle<AbstractModel> loadModel(std::string asset_name, fs::path path, const ModelLoaderFlags& flags = {});
 
+        /**
+         * Loads texture, it is added to assets by its file name
+         */
+        AssetHandle<Texture> loadTexture(fs::path path, const TextureLoaderFlags& flags = TextureLoaderFlags{});
+
+        AssetHandle<ms::Material> loadMaterial(std::string asset_name, fs::path path);
+        AssetHandle<EffectInstance> loadEffect(std::string asset_name, fs::path path);
+
+        /**
+         * Runs function on worker context, its exception is rethrown by update
+         */
         void build(std::function<void()> f);
 
-        // does a delayed job
-        // constructs loaded models because VertexArray is not shared between contexts
-        void doDelayedJob();
+        /**
+         * Placeholders that handles resolve to until loaded
+         *
+         * model placeholder is cube of assets if it is loaded, texture placeholder is 1x1 gray texture
+         */
+        void setPlaceholder(std::shared_ptr<AbstractModel> model) noexcept { model_placeholder = std::move(model); }
+        void setPlaceholder(std::shared_ptr<Texture> texture) noexcept { texture_placeholder = std::move(texture); }
+
+        /**
+         * Publishes finished jobs until budget is spent, should be called every frame on main thread
+         *
+         * at least one job is published per call, so loading progresses with any budget
+         */
+        void update(std::chrono::microseconds budget = std::chrono::microseconds {2000});
 
         // compiles all required shaders
-        void compileShaders(Context& ctx, const RenderSettings& settings);
+        void compileShaders(Context& ctx, const RendererSettings& settings);
 
+        /**
+         * Blocks until all jobs are finished and published
+         */
         void wait();
 
-        bool isDone();
-        operator bool() { return isDone(); }
+        [[nodiscard]] bool isDone() const noexcept { return jobs.empty(); }
+        [[nodiscard]] size_t getPendingCount() const noexcept { return jobs.size(); }
+        explicit operator bool() const noexcept { return isDone(); }
     };
 }
@@ -10,11 +10,19 @@ namespace Limitless {
         explicit dds_loader_exception(const std::string& str) : std::runtime_error(str) {}
     };
 
+    /**
+     * Loads block compressed 2D textures from DDS files
+     *
+     * legacy FourCC (DXT1/3/5, ATI1/ATI2, BC4/BC5) and DX10 header formats (BC1-BC7) are supported;
+     * file is mapped into memory and all its stored levels are uploaded from it as they are
+     */
     class DDSLoader {
-        static std::size_t getDXTByteCount(glm::uvec2 size, std::size_t block_size) noexcept;
-
-        static void loadLevel(std::shared_ptr<Texture>& texture, std::ifstream& fs, uint32_t level, int channels);
     public:
+        /**
+         * Parses DDS file in memory, levels of image point into it
+         */
+        static TextureLoader::CompressedImage parse(const std::byte* data, std::size_t size, const TextureLoaderFlags& flags = {});
+
         static std::shared_ptr<Texture> load(Assets& assets, const fs::path& path, const TextureLoaderFlags& flags);
     };
 }
@@ -2,19 +2,28 @@
 
 #include <filesystem>
 #include <limitless/models/model.hpp>
+#include <limitless/models/animation_compression.hpp>
+#include <limitless/renderer/shader_type.hpp>
 #include <memory>
 #include <stdexcept>
 #include <string>
 
 namespace Limitless {
 	class AbstractModel;
+	class Assets;
 
 	enum class ModelLoaderOption {
 		FlipUV,
 		GenerateUniqueMeshNames,
 		FlipWindingOrder,
 		NoMaterials,
-		GlobalScale
+		GlobalScale,
+		// removes keyframes restored by interpolation within errors of animation compression
+		ReduceKeyframes,
+		// replaces keyframes with uniformly sampled quantized tracks
+		CompressAnimations,
+		// loads model from binary cache next to source, cache is written on first load and when source changes
+		Cache
 	};
 
 	struct ModelLoadError : public std::runtime_error {
@@ -27,6 +36,7 @@ namespace Limitless {
 		std::set<ModelLoaderOption> options;
 		float scale_factor {1.0f};
 		InstanceTypes additional_instance_types;
+		AnimationCompression animation_compression;
 
 		auto isPresent(ModelLoaderOption option) const { return options.count(option) != 0; }
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <limitless/assets.hpp>
+#include <limitless/loaders/texture_loader.hpp>
+
+namespace Limitless {
+    class ktx_loader_exception : public std::runtime_error {
+    public:
+        explicit ktx_loader_exception(const char* msg) : std::runtime_error(msg) {}
+        explicit ktx_loader_exception(const std::string& str) : std::runtime_error(str) {}
+    };
+
+    /**
+     * Loads block compressed 2D textures from KTX2 files
+     *
+     * BC1-BC7 and ASTC 4x4 formats without supercompression are supported;
+     * file is mapped into memory and all its stored levels are uploaded from it as they are
+     */
+    class KTXLoader {
+    public:
+        /**
+         * Parses KTX2 file in memory, levels of image point into it
+         */
+        static TextureLoader::CompressedImage parse(const std::byte* data, std::size_t size, const TextureLoaderFlags& flags = {});
+
+        static std::shared_ptr<Texture> load(Assets& assets, const fs::path& path, const TextureLoaderFlags& flags);
+    };
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <limitless/util/filesystem.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Limitless::ms {
+    class Material;
+}
+
+namespace Limitless {
+    class AbstractModel;
+
+    /**
+     * Engine native binary model format
+     *
+     * file starts with aligned header followed by model name, meshes with vertex, index and bone weight blobs
+     * in vertex stream layout, and for skeletal models bone, skeleton and animation tables;
+     * blobs are aligned, materials are referenced by name
+     *
+     * cache is mapped into memory and blobs are copied into vertex streams without per-vertex work
+     */
+    class ModelCache final {
+    public:
+        static constexpr uint32_t VERSION = 1;
+        static constexpr auto EXTENSION = ".lmodel";
+
+        /**
+         * Identifies source cache was written for, cache is stale when any of it differs
+         */
+        struct Source {
+            uint64_t write_time {};
+            uint64_t size {};
+            // loader options that change cooked data
+            uint32_t options {};
+        };
+
+        using MaterialResolver = std::function<std::shared_ptr<ms::Material>(const std::string& name)>;
+
+        ModelCache() = delete;
+        ~ModelCache() = delete;
+
+        /**
+         * Path of cache next to source file
+         */
+        static fs::path getPath(const fs::path& source);
+
+        static Source getSource(const fs::path& source, uint32_t options);
+
+        /**
+         * Writes model to cache, animations must not be compressed yet
+         *
+         * file is replaced atomically, so concurrently loading process never reads partially written cache
+         */
+        static void save(const AbstractModel& model, const fs::path& path, const Source& source);
+
+        /**
+         * Loads model from cache, returns nullptr if cache is missing or was written for other source or version
+         *
+         * materials are requested by name from resolver, throws ModelLoadError if cache is corrupted
+         */
+        static std::shared_ptr<AbstractModel> load(const fs::path& path, const Source& source, const MaterialResolver& resolver);
+    };
+}
@@ -4,6 +4,8 @@
 #include <limitless/core/context_debug.hpp>
 #include <limitless/util/filesystem.hpp>
 #include <set>
+#include <vector>
+#include <cstddef>
 
 namespace Limitless {
     class Assets;
@@ -11,11 +13,11 @@ namespace Limitless {
 
     class TextureLoaderFlags {
     public:
-    	// does not work for DDS formats
+    	// does not work for DDS and KTX2 formats
         enum class Origin { TopLeft, BottomLeft };
         enum class Filter { Linear, Nearest };
         enum class Compression { None, Default, DXT1, DXT5, BC7, RGTC };
-        // works for dds with precomputed mipmaps only
+        // works for dds and ktx2 with precomputed mipmaps only
         enum class DownScale { None = 0, x2, x4, x8, x16 };
         enum class Space { sRGB, Linear };
 
@@ -29,7 +31,7 @@ namespace Limitless {
         // only for 3 or 4 channels now
         Space space { Space::Linear };
 
-        // for dds it loads mipmaps in a file
+        // for dds and ktx2 it loads mipmaps in a file
         bool mipmap {true};
 
         bool anisotropic_filter {false};
@@ -54,8 +56,42 @@ namespace Limitless {
     };
 
     class TextureLoader final {
+    public:
+        /**
+         * Decoded image in memory
+         *
+         * decoding does not touch GL, so images can be decoded on any thread and uploaded later on context one
+         */
+        struct Image {
+            std::shared_ptr<unsigned char> data;
+            int width {};
+            int height {};
+            int channels {};
+            // empty for images decoded from memory
+            fs::path path;
+        };
+
+        /**
+         * Block compressed image stored in container file
+         *
+         * levels point into memory of the file, so they are uploaded as they are without decoding
+         */
+        struct CompressedImage {
+            struct Level {
+                const std::byte* data {};
+                std::size_t byte_count {};
+            };
+
+            Texture::InternalFormat format {};
+            glm::uvec2 size {};
+            // starting from full resolution
+            std::vector<Level> levels;
+            fs::path path;
+        };
     private:
+        static Image wrap(unsigned char* data, int width, int height, int channels, const TextureLoaderFlags& flags);
         static void setFormat(Texture::Builder& builder, const TextureLoaderFlags& flags, int channels);
+        static void checkCompressionSupport(Texture::InternalFormat format);
         static void setAnisotropicFilter(const std::shared_ptr<Texture>& texture, const TextureLoaderFlags& flags);
         static void setDownScale(int& width, int& height, int channels, unsigned char*& data, const TextureLoaderFlags& flags);
         static bool isPowerOfTwo(int width, int height);
@@ -77,6 +113,44 @@ namespace Limitless {
             const TextureLoaderFlags& flags = {}
         );
 
+        /**
+         * Decodes image file or memory, downscale is applied as well
+         */
+        static Image decode(const fs::path& path, const TextureLoaderFlags& flags = {});
+        static Image decode(const std::string& name, const uint8_t* buffer, size_t size, const TextureLoaderFlags& flags = {});
+
+        /**
+         * Resizes decoded image, e.g. to size of its lower mip
+         */
+        static Image resize(const Image& image, glm::uvec2 size);
+
+        /**
+         * Uploads decoded image without adding it to assets
+         */
+        static std::shared_ptr<Texture> build(const Image& image, const TextureLoaderFlags& flags);
+
+        /**
+         * Uploads stored levels of compressed image without adding it to assets
+         *
+         * downscale skips top levels, no levels are generated at runtime
+         */
+        static std::shared_ptr<Texture> build(const CompressedImage& image, const TextureLoaderFlags& flags);
+
+        /**
+         * Byte count of level of block compressed format, throws for uncompressed ones
+         */
+        static std::size_t getCompressedByteCount(Texture::InternalFormat format, glm::uvec2 size);
+
+        /**
+         * Length of full mip chain down to 1x1
+         */
+        static uint32_t getMaxLevelCount(glm::uvec2 size) noexcept;
+
+        /**
+         * Uploads decoded image, returns texture already added with the same name
+         */
+        static std::shared_ptr<Texture> load(Assets& assets, const std::string& name, const Image& image, const TextureLoaderFlags& flags = {});
+
         static std::shared_ptr<Texture> loadCubemap(Assets& assets, const fs::path& path, const TextureLoaderFlags& flags = {});
     };
 }
\ No newline at end of file
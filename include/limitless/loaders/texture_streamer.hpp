@@ -0,0 +1,172 @@
+#pragma once
+
+#include <limitless/loaders/texture_loader.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <unordered_map>
+#include <optional>
+#include <future>
+#include <mutex>
+
+namespace Limitless::ms {
+    class Material;
+}
+
+namespace Limitless {
+    class Assets;
+
+    /**
+     * TextureStreamer keeps textures resident only with mips they are seen with
+     *
+     * texture is loaded with its mip tail only, that is levels not larger than tail size; higher mips are
+     * requested by screen size of meshes using texture, decoded on streamer workers and uploaded by update
+     * as new storage of the same Texture, so materials keep their textures
+     *
+     * when memory budget is exceeded, top mips of least recently requested textures are dropped on GPU
+     * without reading them back; replaced storage is released a few frames later, which makes its bindless
+     * handle non-resident after materials mapped the new one
+     *
+     * streamed textures must have mipmaps, others are loaded by TextureLoader as usual
+     */
+    class TextureStreamer final {
+    public:
+        /**
+         * Streaming state of texture that budget decisions are made by
+         */
+        struct Residency {
+            Texture::InternalFormat format {};
+            // full resolution
+            glm::uvec2 size {};
+            uint32_t tail_mip {};
+            // top mip of current storage
+            uint32_t resident_mip {};
+            uint64_t last_used {};
+        };
+    private:
+        /**
+         * Frames replaced storage is kept for, in-flight frames may still sample it
+         */
+        static constexpr uint64_t RETIRE_FRAMES = 3;
+
+        struct Entry : Residency {
+            std::weak_ptr<Texture> texture;
+            fs::path path;
+            TextureLoaderFlags flags;
+            // top mip requested since last update
+            uint32_t requested_mip {};
+            uint64_t memory {};
+            uint64_t tail_memory {};
+
+            std::future<TextureLoader::Image> pending;
+            uint32_t pending_mip {};
+        };
+
+        struct Retired {
+            std::shared_ptr<Texture> storage;
+            uint64_t frame;
+        };
+
+        std::unordered_map<const Texture*, Entry> entries;
+        std::vector<Retired> retired;
+        std::mutex mutex;
+
+        // decoding is done on own workers, so it never runs inside parallelFor of frame
+        ThreadPool pool;
+
+        uint64_t budget;
+        uint64_t usage {};
+        uint32_t tail_size;
+        uint32_t uploads_per_update {2};
+        uint64_t frame {};
+
+        /**
+         * Swaps storage of texture, previous one is retired
+         */
+        void replace(Entry& entry, Texture& texture, std::shared_ptr<Texture> storage);
+
+        /**
+         * Drops one top mip of least recently used textures until required memory fits budget
+         *
+         * nothing is evicted and false is returned if it does not fit anyway
+         */
+        bool evict(uint64_t required, const Entry* except);
+
+        void finishPending(Entry& entry, uint32_t& uploads);
+
+        /**
+         * Starts decoding of highest requested mip that fits available memory
+         */
+        void startPending(Entry& entry, uint64_t& available);
+    public:
+        /**
+         * @param budget - GPU memory for streamed textures in bytes
+         * @param tail_size - largest mip that is always resident
+         * @param workers - decoding threads
+         */
+        explicit TextureStreamer(uint64_t budget, uint32_t tail_size = 64, uint32_t workers = 1);
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        /**
+         * Loads mip tail of image, texture is added to assets by its file name
+         */
+        std::shared_ptr<Texture> load(Assets& assets, const fs::path& path, const TextureLoaderFlags& flags = {});
+
+        /**
+         * Requests texture to be resident with at least specified top mip until next update
+         */
+        void request(const Texture& texture, uint32_t mip);
+
+        /**
+         * Requests textures of material seen with specified screen size in pixels
+         */
+        void request(const ms::Material& material, float screen_size);
+
+        /**
+         * Uploads finished mips and starts decoding of requested ones within budget, must be called on context thread once per frame
+         */
+        void update();
+
+        /**
+         * Mip that texture of specified size mapped once onto object of screen size is sampled with
+         */
+        [[nodiscard]] static uint32_t getRequiredMip(glm::uvec2 size, float screen_size) noexcept;
+
+        /**
+         * GPU memory used by all levels of texture storage
+         */
+        [[nodiscard]] static uint64_t getMemorySize(const Texture& texture) noexcept;
+
+        /**
+         * GPU memory of storage that starts from specified mip of texture of full size
+         */
+        [[nodiscard]] static uint64_t getMemorySize(Texture::InternalFormat format, glm::uvec2 size, uint32_t mip) noexcept;
+
+        /**
+         * Highest mip between requested and resident one which storage growth fits available memory,
+         * resident mip if none does
+         */
+        [[nodiscard]] static uint32_t selectMip(const Residency& residency, uint32_t requested_mip, uint64_t available) noexcept;
+
+        /**
+         * Indices of textures to drop one top mip from, in order, so that required memory fits budget
+         *
+         * least recently used textures go first, ones used at frame and ones at their tail are kept;
+         * returns nullopt if required memory does not fit anyway
+         */
+        [[nodiscard]] static std::optional<std::vector<size_t>> selectEvictions(std::vector<Residency> residencies, uint64_t usage, uint64_t required, uint64_t budget, uint64_t frame);
+
+        /**
+         * Top mip of texture storage, 0 for full resolution or texture that is not streamed
+         */
+        [[nodiscard]] uint32_t getResidentMip(const Texture& texture);
+
+        void setBudget(uint64_t bytes) noexcept { budget = bytes; }
+        void setUploadsPerUpdate(uint32_t count) noexcept { uploads_per_update = count; }
+
+        [[nodiscard]] auto getBudget() const noexcept { return budget; }
+        [[nodiscard]] auto getUsage() const noexcept { return usage; }
+        [[nodiscard]] auto getTailSize() const noexcept { return tail_size; }
+    };
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <optional>
+#include <cstdint>
+#include <vector>
+#include <array>
+
+namespace Limitless {
+    struct Animation;
+    struct AnimationNode;
+
+    /**
+     * Quaternion packed with smallest three method
+     *
+     * the largest component is dropped and restored from unit length, the rest are quantized to 15 bits;
+     * index of dropped component is kept in high bits of the first two values
+     */
+    class QuantizedQuat final {
+    private:
+        std::array<uint16_t, 3> data {};
+    public:
+        static QuantizedQuat pack(const glm::fquat& quat) noexcept;
+        [[nodiscard]] glm::fquat unpack() const noexcept;
+    };
+
+    /**
+     * Vector quantized to 16 bits per component inside bounds of its track
+     */
+    struct QuantizedVec3 {
+        std::array<uint16_t, 3> data;
+    };
+
+    /**
+     * Describes compression of animation
+     */
+    struct AnimationCompression {
+        // samples per second of animation
+        double sample_rate {30.0};
+
+        // tracks that never deviate from their first value more than error are stored as constant
+        float position_error {1e-4f};
+        float rotation_error {1e-4f};
+        float scale_error {1e-4f};
+    };
+
+    /**
+     * CompressedAnimation keeps animation tracks uniformly sampled and quantized
+     *
+     * every track is absent, constant or has sample for every sample time,
+     * so keyframes are found without search
+     */
+    class CompressedAnimation final {
+    public:
+        /**
+         * Sample index and factor between it and the next one
+         */
+        struct Sample {
+            uint32_t index;
+            float factor;
+        };
+    private:
+        struct VectorTrack {
+            glm::vec3 min {};
+            glm::vec3 extent {};
+            uint32_t offset {};
+            // 0 - track is absent, 1 - constant
+            uint32_t count {};
+        };
+
+        struct RotationTrack {
+            uint32_t offset {};
+            uint32_t count {};
+        };
+
+        struct NodeTracks {
+            VectorTrack position;
+            RotationTrack rotation;
+            VectorTrack scale;
+        };
+
+        std::vector<NodeTracks> tracks;
+        std::vector<QuantizedVec3> vectors;
+        std::vector<QuantizedQuat> rotations;
+
+        // animation ticks between samples
+        double step;
+        uint32_t sample_count;
+
+        [[nodiscard]] glm::vec3 sample(const VectorTrack& track, const Sample& sample) const noexcept;
+    public:
+        CompressedAnimation(const Animation& animation, const AnimationCompression& settings);
+
+        /**
+         * Finds sample for animation time in ticks
+         */
+        [[nodiscard]] Sample locate(double anim_time) const noexcept;
+
+        /**
+         * Values of track of animation node, nullopt if node does not animate it
+         */
+        [[nodiscard]] std::optional<glm::vec3> position(size_t node, const Sample& sample) const noexcept;
+        [[nodiscard]] std::optional<glm::fquat> rotation(size_t node, const Sample& sample) const noexcept;
+        [[nodiscard]] std::optional<glm::vec3> scale(size_t node, const Sample& sample) const noexcept;
+
+        /**
+         * Size of stored tracks in bytes
+         */
+        [[nodiscard]] size_t getSize() const noexcept;
+    };
+
+    /**
+     * Removes keyframes that are restored by interpolation of their neighbours within error
+     */
+    void reduceKeyframes(AnimationNode& node, const AnimationCompression& settings);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Limitless {
+    class SkeletalModel;
+    class Texture;
+
+    /**
+     * BakedAnimations keeps all animations of skeletal model sampled into float texture
+     *
+     * every row is one frame, every joint takes three texels with rows of its 3x4 bone matrix;
+     * instances that play baked animations pass flagged frame instead of bone offset and are not evaluated on CPU
+     */
+    class BakedAnimations final {
+    public:
+        // set in bone offset of instance data when it is baked frame row
+        static constexpr uint32_t FRAME_FLAG = 0x80000000u;
+
+        struct Clip {
+            uint32_t first_frame;
+            uint32_t frame_count;
+        };
+    private:
+        std::shared_ptr<Texture> texture;
+        // in order of model animations
+        std::vector<Clip> clips;
+        double sample_rate;
+    public:
+        /**
+         * Bakes animations of model with sample rate in frames per second
+         *
+         * requires context, throws std::runtime_error if frames do not fit into texture
+         */
+        BakedAnimations(const SkeletalModel& model, double sample_rate);
+
+        /**
+         * Returns texture row of animation at time in ticks
+         */
+        [[nodiscard]] uint32_t getFrame(size_t animation, double anim_time, double tps) const noexcept;
+
+        [[nodiscard]] const auto& getTexture() const noexcept { return texture; }
+        [[nodiscard]] const auto& getClips() const noexcept { return clips; }
+        [[nodiscard]] auto getSampleRate() const noexcept { return sample_rate; }
+    };
+}
@@ -39,6 +39,15 @@ namespace Limitless {
             calculateBoundingBox();
         }
 
+        /**
+         * Takes already known bounding box, e.g. read from model cache
+         */
+        Mesh(std::unique_ptr<AbstractVertexStream> _stream, std::string _name, const Box& _bounding_box)
+            : stream {std::move(_stream)}
+            , name {std::move(_name)}
+            , bounding_box {_bounding_box} {
+        }
+
         ~Mesh() override = default;
 
         Mesh(const Mesh&) = delete;
@@ -69,5 +78,13 @@ namespace Limitless {
         void draw_instanced(VertexStreamDraw draw, std::size_t count) noexcept override {
             stream->draw_instanced(draw, count);
         }
+
+        void draw_instanced_indirect(Buffer& command) noexcept override {
+            stream->draw_instanced_indirect(command);
+        }
+
+        void draw_instanced_indirect(VertexStreamDraw draw, Buffer& command) noexcept override {
+            stream->draw_instanced_indirect(draw, command);
+        }
     };
 }
@@ -3,6 +3,8 @@
 #include <limitless/models/model.hpp>
 #include <limitless/util/tree.hpp>
 #include <limitless/models/bones.hpp>
+#include <limitless/models/animation_compression.hpp>
+#include <limitless/models/baked_animations.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <unordered_map>
 #include <optional>
@@ -18,6 +20,17 @@ namespace Limitless {
             , time(time) {}
     };
 
+    /**
+     * Keyframe indices of animation node reached by previous evaluation
+     *
+     * kept by instance to advance keyframes incrementally instead of searching them every frame
+     */
+    struct KeyframeCursor {
+        size_t position {};
+        size_t rotation {};
+        size_t scale {};
+    };
+
     struct AnimationNode {
         std::vector<KeyFrame<glm::fquat>> rotations;
         std::vector<KeyFrame<glm::vec3>> positions;
@@ -32,28 +45,69 @@ namespace Limitless {
         [[nodiscard]] std::optional<glm::vec3> positionLerp(double anim_time) const;
         [[nodiscard]] std::optional<glm::fquat> rotationLerp(double anim_time) const;
         [[nodiscard]] std::optional<glm::vec3> scalingLerp(double anim_time) const;
+
+        /**
+         * Interpolates keyframes starting search from cursor and moves cursor to found keyframe
+         *
+         * cursor is rewound when time goes backwards, so looped animation costs one step per frame
+         */
+        [[nodiscard]] std::optional<glm::vec3> positionLerp(double anim_time, KeyframeCursor& cursor) const noexcept;
+        [[nodiscard]] std::optional<glm::fquat> rotationLerp(double anim_time, KeyframeCursor& cursor) const noexcept;
+        [[nodiscard]] std::optional<glm::vec3> scalingLerp(double anim_time, KeyframeCursor& cursor) const noexcept;
     };
 
     struct Animation {
+        static constexpr auto NO_CHANNEL = static_cast<uint32_t>(-1);
+
         std::vector<AnimationNode> nodes;
         std::string name;
         double duration;
         double tps;
 
-        Animation(std::string name, double duration, double tps, decltype(nodes) nodes) noexcept
-            : nodes(std::move(nodes))
-            , name(std::move(name))
-            , duration(duration)
-            , tps(tps) {
+        // index of animation node for every bone index, NO_CHANNEL if bone is not animated
+        std::vector<uint32_t> channels;
+
+        // uniformly sampled quantized tracks, keyframes of nodes are released when set
+        std::optional<CompressedAnimation> compressed;
+
+        Animation(std::string name, double duration, double tps, decltype(nodes) nodes);
+
+        /**
+         * Replaces keyframes of nodes with compressed tracks
+         */
+        void compress(const AnimationCompression& settings);
+
+        [[nodiscard]] const AnimationNode* findChannel(uint32_t bone_index) const noexcept {
+            return bone_index < channels.size() && channels[bone_index] != NO_CHANNEL ? &nodes[channels[bone_index]] : nullptr;
         }
     };
 
+    /**
+     * Bone of flattened skeleton
+     */
+    struct SkeletonNode {
+        static constexpr auto NO_PARENT = static_cast<uint32_t>(-1);
+
+        uint32_t bone;
+        // index of parent node in flattened skeleton
+        uint32_t parent;
+        // roots have zero depth
+        uint32_t depth;
+    };
+
     class SkeletalModel : public Model {
     protected:
         std::unordered_map<std::string, uint32_t> bone_map;
         std::vector<Animation> animations;
         std::vector<Bone> bones;
         std::vector<Tree<uint32_t>> skeletons;
+
+        // skeleton trees flattened in parent before child order, so pose is evaluated by one linear pass
+        std::vector<SkeletonNode> skeleton;
+
+        std::shared_ptr<BakedAnimations> baked_animations;
+
+        void flattenSkeletons();
     public:
         SkeletalModel(
             decltype(meshes)&& meshes,
@@ -70,9 +124,31 @@ namespace Limitless {
         SkeletalModel(const SkeletalModel&) = delete;
         SkeletalModel& operator=(const SkeletalModel&) = delete;
 
+        /**
+         * Evaluates global skeleton node and bone transformations of animation at time in ticks
+         *
+         * cursors are per animation node, transformations are sized by skeleton and joint count;
+         * channels of nodes deeper than max_depth are not sampled and these nodes keep their bind pose
+         */
+        void evaluatePose(
+            const Animation& animation,
+            double anim_time,
+            std::vector<KeyframeCursor>& cursors,
+            std::vector<glm::mat4>& node_transform,
+            std::vector<glm::mat4>& bone_transform,
+            uint32_t max_depth = static_cast<uint32_t>(-1)
+        ) const noexcept;
+
+        /**
+         * Bakes all animations into texture of bone matrices, requires context
+         */
+        void bakeAnimations(double sample_rate = 30.0);
+
         [[nodiscard]] const auto& getAnimations() const noexcept { return animations; }
         [[nodiscard]] const auto& getSkeletonTrees() const noexcept { return skeletons; }
         [[nodiscard]] const auto& getBones() const noexcept { return bones; }
+        [[nodiscard]] const auto& getSkeleton() const noexcept { return skeleton; }
+        [[nodiscard]] const auto& getBakedAnimations() const noexcept { return baked_animations; }
 
         auto& getSkeletonTrees() noexcept { return skeletons; }
         auto& getAnimations() noexcept { return animations; }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Limitless {
+    class ModelInstance;
+    class MeshInstance;
+    class Buffer;
+
+    namespace ms {
+        class Material;
+    }
+
+    /**
+     * InstanceBatcher groups meshes of visible ModelInstances into instanced draws
+     *
+     * meshes are batched when they share vertex stream, shader and material values,
+     * each batch is drawn once with slots of its instances taken from BATCH_BUFFER by gl_InstanceID
+     */
+    class InstanceBatcher final {
+    public:
+        static constexpr auto BUFFER_NAME = "BATCH_BUFFER";
+
+        /**
+         * Value of 'batch_offset' uniform for draws that are not batched
+         */
+        static constexpr uint32_t NOT_BATCHED = 0xFFFFFFFF;
+
+        class Batch {
+        public:
+            ModelInstance* instance;
+            MeshInstance* mesh;
+            uint32_t offset;
+            uint32_t count;
+        };
+    private:
+        class Draw {
+        public:
+            ModelInstance* instance;
+            MeshInstance* mesh;
+            uint64_t shader_index;
+            uint32_t slot;
+        };
+
+        std::vector<Draw> draws;
+        std::vector<Batch> batches;
+        std::vector<uint32_t> slots;
+
+        std::shared_ptr<Buffer> buffer;
+
+        static bool isBatchable(const ms::Material& lhs, const ms::Material& rhs) noexcept;
+    public:
+        InstanceBatcher();
+        ~InstanceBatcher();
+
+        InstanceBatcher(const InstanceBatcher&) = delete;
+        InstanceBatcher(InstanceBatcher&&) = delete;
+
+        /**
+         * Adds mesh of instance
+         *
+         * meshes of the same batch keep order they were added in
+         */
+        void add(ModelInstance& instance, MeshInstance& mesh);
+
+        /**
+         * Groups added meshes into batches and maps their slots to GPU
+         */
+        void build();
+
+        /**
+         * Clears added meshes and batches
+         */
+        void clear() noexcept;
+
+        [[nodiscard]] const auto& getBatches() const noexcept { return batches; }
+        [[nodiscard]] bool empty() const noexcept { return draws.empty(); }
+    };
+}
@@ -3,12 +3,15 @@
 #include <limitless/renderer/shader_type.hpp>
 
 #include <limitless/instances/instanced_instance.hpp>
+#include <limitless/instances/skeletal_instanced_instance.hpp>
 #include <limitless/scene.hpp>
 #include <limitless/assets.hpp>
 #include <limitless/core/shader/shader_program.hpp>
 #include <limitless/instances/terrain_instance.hpp>
 #include <limitless/fx/effect_renderer.hpp>
 #include <limitless/util/frustum_culling.hpp>
+#include <limitless/renderer/instance_batcher.hpp>
+#include <limitless/renderer/render_queue.hpp>
 
 namespace Limitless {
     class DrawParameters {
@@ -25,11 +28,23 @@ namespace Limitless {
     private:
         FrustumCulling frustum_culling;
         fx::EffectRenderer effect_renderer;
+        InstanceBatcher batcher;
+
+        /**
+         * Queue of camera visible meshes and queue for other views
+         */
+        RenderQueue queue;
+        RenderQueue view_queue;
+
+        glm::vec3 camera_position {};
+        float camera_far {1.0f};
 
         /**
          * Sets shader and context state according to parameters
+         *
+         * batch_offset is position of batch slots in InstanceBatcher buffer
          */
-        static void setRenderState(const Instance& instance, const MeshInstance& mesh, const DrawParameters& drawp);
+        static void setRenderState(const Instance& instance, const MeshInstance& mesh, const DrawParameters& drawp, uint32_t batch_offset = InstanceBatcher::NOT_BATCHED);
 
         /**
          * Checks whether instance should be rendered for specified parameters
@@ -37,17 +52,24 @@ namespace Limitless {
         static bool shouldBeRendered(const Instance& instance, const DrawParameters& drawp);
 
         /**
-         * Renders only visible subset of InstancedInstance instances from frustum culling
+         * Renders queue items with blending of parameters, opaque ModelInstances are batched
+         */
+        void renderItems(RenderQueue::Range items, const DrawParameters& drawp, const FrustumCulling& culling);
+
+        /**
+         * Renders single mesh of queue item
+         *
+         * InstancedInstance and SkeletalInstancedInstance are drawn with their visible subsets from culling
          */
-        void renderVisibleInstancedInstance(InstancedInstance& instance, const DrawParameters& drawp);
+        static void renderItem(const RenderQueue::Item& item, const DrawParameters& drawp, const FrustumCulling& culling);
+
         /**
-         * Renders only visible MeshInstances of terrain
+         * Renders batches of ModelInstances added to batcher
          */
-        void renderVisibleTerrain(TerrainInstance& instance, const DrawParameters& drawp);
-        void renderVisible(Instance& instance, const DrawParameters& drawp);
+        void renderBatches(const DrawParameters& drawp);
 
     public:
-        void update(Scene& scene, Camera& camera);
+        void update(Scene& scene, Camera& camera, const Assets& assets);
 
         /**
          * Renders instances from prepared scene in [update] method
@@ -56,6 +78,16 @@ namespace Limitless {
          */
         void renderScene(const DrawParameters& drawp);
 
+        /**
+         * Renders instances found visible by specified culling, used for views other than camera (e.g. shadow cascades)
+         */
+        void renderScene(const DrawParameters& drawp, const FrustumCulling& culling);
+
+        /**
+         * Renders all translucent meshes from back to front regardless of their blending, then effects
+         */
+        void renderTranslucent(const DrawParameters& drawp);
+
         /**
          * Renders decal instances from prepared scene in [update] method
          */
@@ -72,9 +104,11 @@ namespace Limitless {
         static void render(ModelInstance& instance, const DrawParameters& drawp);
         static void render(SkeletalInstance& instance, const DrawParameters& drawp);
         static void render(InstancedInstance& instance, const DrawParameters& drawp);
+        static void render(SkeletalInstancedInstance& instance, const DrawParameters& drawp);
         static void render(TerrainInstance& instance, const DrawParameters& drawp);
         static void render(DecalInstance& instance, const DrawParameters& drawp);
 
         [[nodiscard]] const FrustumCulling& getFrustumCulling() const noexcept { return frustum_culling; }
+        [[nodiscard]] const RenderQueue& getRenderQueue() const noexcept { return queue; }
     };
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Limitless {
+    class Instance;
+    class MeshInstance;
+    class FrustumCulling;
+
+    /**
+     * RenderQueue contains meshes of visible instances sorted by packed 64-bit keys
+     *
+     * opaque key:      [bucket:1][instance type:3][shader:16][mesh:20][depth:24] - state changes first, then front-to-back
+     * translucent key: [bucket:1][inverted depth:24][blending:3][instance type:3][shader:16][mesh:17] - back-to-front
+     *
+     * queue is built once per frame from visible set and consumed by passes by bucket
+     */
+    class RenderQueue final {
+    public:
+        class Item {
+        public:
+            uint64_t key;
+            Instance* instance;
+            MeshInstance* mesh;
+        };
+
+        class Range {
+        private:
+            const Item* first;
+            const Item* last;
+        public:
+            Range(const Item* first, const Item* last) noexcept : first {first}, last {last} {}
+
+            [[nodiscard]] const Item* begin() const noexcept { return first; }
+            [[nodiscard]] const Item* end() const noexcept { return last; }
+            [[nodiscard]] size_t size() const noexcept { return last - first; }
+            [[nodiscard]] bool empty() const noexcept { return first == last; }
+        };
+
+        static constexpr uint64_t TRANSLUCENT_BUCKET = uint64_t{1} << 63;
+    private:
+        std::vector<Item> items;
+        std::vector<Item> scratch;
+        size_t translucent_begin {};
+
+        glm::vec3 origin {};
+        float max_distance {1.0f};
+
+        [[nodiscard]] uint64_t makeKey(Instance& instance, const MeshInstance& mesh) const noexcept;
+        void add(Instance& instance, MeshInstance& mesh);
+    public:
+        /**
+         * Builds queue from visible instances of culling sorted relative to origin
+         *
+         * max distance is used to quantize depth, usually camera far plane
+         */
+        void build(const FrustumCulling& culling, const glm::vec3& origin, float max_distance);
+
+        [[nodiscard]] Range getOpaque() const noexcept { return {items.data(), items.data() + translucent_begin}; }
+        [[nodiscard]] Range getTranslucent() const noexcept { return {items.data() + translucent_begin, items.data() + items.size()}; }
+        [[nodiscard]] const auto& getItems() const noexcept { return items; }
+    };
+}
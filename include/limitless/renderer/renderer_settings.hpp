@@ -4,6 +4,7 @@
 #include <glm/vec2.hpp>
 #include <limitless/postprocessing/ssr.hpp>
 #include <limitless/postprocessing/ssao.hpp>
+#include <limitless/util/filesystem.hpp>
 
 namespace Limitless {
     enum class RenderPipeline {
@@ -71,6 +72,13 @@ namespace Limitless {
          float specular_aa_threshold {0.1f};
          float specular_aa_variance {0.2f};
 
+        /**
+         * Directory to store compiled shader program binaries in
+         *
+         * binary cache is disabled if empty
+         */
+        fs::path shader_cache_directory;
+
         /**
          * Debug settings
          */
@@ -146,6 +154,11 @@ namespace Limitless {
             float specular_threshold {0.1f};
             float specular_variance {0.2f};
 
+            /**
+             * Shader program binary cache
+             */
+            fs::path shader_cache;
+
             /**
              * Debug settings
              */
@@ -203,6 +216,8 @@ namespace Limitless {
             Builder& specular_aa_threshold(float threshold);
             Builder& specular_aa_variance(float variance);
 
+            Builder& shader_cache_directory(fs::path directory);
+
             Builder& debug_light_radius();
             Builder& debug_coordinate_system_axes();
             Builder& debug_bounding_box();
@@ -64,7 +64,14 @@ namespace Limitless {
         /**
          * Decal shader allows you to modify other surfaces with screen space projection without geometry
          */
-        Decal
+        Decal,
+
+        /**
+         * ParticleSimulation compute shader simulates emitter particles on GPU
+         *
+         * compiled only for emitters with GPU simulation
+         */
+        ParticleSimulation
     };
 
     inline const std::map<ShaderType, std::string> SHADER_PASS_PATH = {
@@ -75,6 +82,7 @@ namespace Limitless {
         {ShaderType::DirectionalShadow, "lighting"  PATH_SEPARATOR "directional_shadows" },
         {ShaderType::ColorPicker,       "pipeline"  PATH_SEPARATOR "color_picker" },
         {ShaderType::Decal,             "pipeline"  PATH_SEPARATOR "decal" },
+        {ShaderType::ParticleSimulation, "fx"       PATH_SEPARATOR "particle_simulation" },
     };
 
     /**
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <limitless/renderer/renderer_pass.hpp>
+
+namespace Limitless {
+    class TextureStreamer;
+
+    /**
+     * Feeds TextureStreamer with screen sizes of visible meshes and updates it
+     *
+     * should be added before SceneUpdatePass, so materials map replaced texture storage at the same frame
+     */
+    class TextureStreamingPass final : public RendererPass {
+    private:
+        TextureStreamer& streamer;
+    public:
+        TextureStreamingPass(Renderer& renderer, TextureStreamer& streamer);
+
+        /**
+         * Requests textures of render queue meshes by screen size of their instances, then uploads streamed mips
+         */
+        void update(Scene& scene, const Camera& camera) override;
+    };
+}
@@ -4,8 +4,10 @@
 #include <limitless/instances/skeletal_instance.hpp>
 #include <limitless/instances/effect_instance.hpp>
 #include <limitless/instances/instance_builder.hpp>
+#include <limitless/instances/pose_cache.hpp>
 #include <limitless/skybox/skybox.hpp>
 #include <limitless/camera.hpp>
+#include <limitless/util/aabb_tree.hpp>
 #include <stdexcept>
 #include <unordered_map>
 #include <memory>
@@ -21,14 +23,86 @@ namespace Limitless {
     /**
      *
      */
-    class Scene final {
+    class Scene final : private InstanceObserver {
     private:
         Lighting lighting;
         std::unordered_map<uint64_t, std::shared_ptr<Instance>> instances;
         std::shared_ptr<Skybox> skybox;
+
+        /**
+         * Scene instance or attachment and its proxy in spatial index, hidden ones have no proxy
+         */
+        struct SpatialProxy {
+            std::shared_ptr<Instance> instance;
+            int32_t proxy {AABBTree::NULL_NODE};
+            // listed in compound instances
+            bool compound {};
+            // queued in spatial changes
+            bool changed {};
+        };
+
+        /**
+         * Bounding volume hierarchy of visible instances and their attachments
+         *
+         * proxies are updated only when instance bounding box leaves its enlarged box in tree
+         */
+        AABBTree spatial_index;
+        std::unordered_map<uint64_t, SpatialProxy> spatial_proxies;
+
+        /**
+         * Instances reported by observer since last update, only they are reindexed
+         */
+        std::vector<uint64_t> spatial_changes;
+
+        /**
+         * InstancedInstance, SkeletalInstancedInstance and TerrainInstance are not indexed as a whole, their parts are tested separately
+         */
+        Instances compound_instances;
+
+        /**
+         * Effects and their emitters updated this frame, reused between frames
+         */
+        std::vector<EffectInstance*> updated_effects;
+        std::vector<fx::AbstractEmitter*> updated_emitters;
+
+        /**
+         * Skeletal instances updated this frame and cache that shares their poses
+         */
+        std::vector<SkeletalInstance*> updated_skeletals;
+        PoseCache pose_cache;
+
+        FrameClock clock;
+
         void removeDeadInstances() noexcept;
+
+        /**
+         * Evaluates poses of skeletal instances in parallel on shared thread pool with animation lod of camera distance
+         */
+        void updateSkeletals(const Camera& camera, const FrameClock& clock);
+
+        /**
+         * Updates effect instances, emitters are simulated in parallel on shared thread pool
+         */
+        void updateEffects(const Camera& camera, const FrameClock& clock);
+
+        /**
+         * Starts observing instance and its attachments, indexes them right away
+         */
+        void track(const std::shared_ptr<Instance>& instance);
+        void untrack(Instance& instance);
+
+        /**
+         * Inserts, moves or removes proxy according to instance visibility and bounding box
+         */
+        void index(SpatialProxy& proxy);
+        void updateSpatialIndex();
+
+        void onInstanceChanged(Instance& instance) override;
+        void onInstanceAttached(const std::shared_ptr<Instance>& instance) override;
+        void onInstanceDetached(Instance& instance) override;
     public:
         explicit Scene(Context& context);
+        ~Scene() override;
 
         Scene(const Scene&) = delete;
         Scene(Scene&&) = delete;
@@ -58,6 +132,58 @@ namespace Limitless {
          */
         Instances getInstances() const noexcept;
 
+        /**
+         * Spatial queries over visible instances and their attachments
+         *
+         * InstancedInstance and TerrainInstance are not included, check getCompoundInstances()
+         */
+
+        /**
+         * Appends instances which bounding boxes intersect frustum
+         */
+        void query(const Frustum& frustum, Instances& result) const;
+
+        /**
+         * Returns instances which bounding boxes overlap box
+         */
+        [[nodiscard]] Instances query(const Box& box) const;
+
+        /**
+         * Returns instances which bounding boxes intersect sphere
+         */
+        [[nodiscard]] Instances query(const glm::vec3& center, float radius) const;
+
+        /**
+         * Returns instances which bounding boxes are hit by ray, ordered by hit distance
+         */
+        [[nodiscard]] Instances raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance) const;
+
+        [[nodiscard]] const AABBTree& getSpatialIndex() const noexcept { return spatial_index; }
+
+        /**
+         * Animation lod and pose counters of skeletal instances
+         */
+        [[nodiscard]] const PoseCache& getPoseCache() const noexcept { return pose_cache; }
+        PoseCache& getPoseCache() noexcept { return pose_cache; }
+
+        [[nodiscard]] const Instances& getCompoundInstances() const noexcept { return compound_instances; }
+
+        /**
+         * Clock ticked by update(camera), may be switched to fixed step
+         */
+        [[nodiscard]] const FrameClock& getClock() const noexcept { return clock; }
+        FrameClock& getClock() noexcept { return clock; }
+
+        /**
+         * Ticks scene clock and updates scene with it
+         */
         void update(const Camera& camera);
+
+        /**
+         * Updates scene with specified clock, emitters and animations are stepped by its delta
+         *
+         * clock is published for time uniforms of materials
+         */
+        void update(const Camera& camera, const FrameClock& frame_clock);
     };
 }
\ No newline at end of file
@@ -19,7 +19,7 @@ namespace Limitless {
 namespace Limitless {
     class EmitterSerializer {
     private:
-        static constexpr uint8_t VERSION = 0x1;
+        static constexpr uint8_t VERSION = 0x2;
     public:
         ByteBuffer serialize(const fx::AbstractEmitter& emitter);
         void deserialize(Assets& ctx, ByteBuffer& buffer, fx::EffectBuilder& builder);
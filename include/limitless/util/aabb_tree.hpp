@@ -0,0 +1,265 @@
+#pragma once
+
+#include <limitless/util/box.hpp>
+#include <limitless/util/frustum.hpp>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Limitless {
+    /**
+     * Dynamic bounding volume hierarchy of axis-aligned boxes
+     *
+     * Leaves store boxes enlarged by margin, so small movements do not change the tree.
+     * Tree is kept balanced with rotations on insertion and removal.
+     *
+     * Proxy is a stable handle of inserted box, user data is returned from queries
+     */
+    class AABBTree final {
+    public:
+        static constexpr int32_t NULL_NODE = -1;
+    private:
+        struct Node {
+            glm::vec3 min {};
+            glm::vec3 max {};
+            uint64_t user {};
+            // next free node if node is not used
+            int32_t parent {NULL_NODE};
+            int32_t left {NULL_NODE};
+            int32_t right {NULL_NODE};
+            // leaf is 0, free node is -1
+            int32_t height {-1};
+
+            [[nodiscard]] bool isLeaf() const noexcept { return left == NULL_NODE; }
+        };
+
+        std::vector<Node> nodes;
+        int32_t root {NULL_NODE};
+        int32_t free_list {NULL_NODE};
+        size_t leaf_count {};
+
+        /**
+         * Enlargement of leaf boxes
+         */
+        float margin;
+
+        int32_t allocateNode();
+        void freeNode(int32_t node) noexcept;
+
+        void insertLeaf(int32_t leaf);
+        void removeLeaf(int32_t leaf);
+        int32_t balance(int32_t node);
+        void refit(int32_t node);
+
+        static float area(const glm::vec3& min, const glm::vec3& max) noexcept {
+            const auto d = max - min;
+            return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+
+        static bool overlaps(const Node& node, const glm::vec3& min, const glm::vec3& max) noexcept {
+            return glm::all(glm::lessThanEqual(node.min, max)) && glm::all(glm::greaterThanEqual(node.max, min));
+        }
+
+        template<typename F>
+        void collect(int32_t node, std::vector<int32_t>& stack, const F& callback) const {
+            stack.emplace_back(node);
+            while (!stack.empty()) {
+                const auto& current = nodes[stack.back()];
+                stack.pop_back();
+
+                if (current.isLeaf()) {
+                    callback(current.user);
+                } else {
+                    stack.emplace_back(current.left);
+                    stack.emplace_back(current.right);
+                }
+            }
+        }
+    public:
+        explicit AABBTree(float margin = 0.1f) noexcept;
+
+        /**
+         * Inserts box and returns its proxy
+         */
+        int32_t insert(const Box& box, uint64_t user);
+
+        /**
+         * Removes proxy from tree
+         */
+        void remove(int32_t proxy);
+
+        /**
+         * Updates box of proxy
+         *
+         * tree changes only if new box is not contained in enlarged one, returns whether it has changed
+         */
+        bool update(int32_t proxy, const Box& box);
+
+        void clear() noexcept;
+
+        [[nodiscard]] uint64_t getUser(int32_t proxy) const { return nodes.at(proxy).user; }
+        [[nodiscard]] Box getBox(int32_t proxy) const;
+        [[nodiscard]] Box getBounds() const noexcept;
+        [[nodiscard]] size_t size() const noexcept { return leaf_count; }
+        [[nodiscard]] bool empty() const noexcept { return leaf_count == 0; }
+        [[nodiscard]] int32_t getHeight() const noexcept { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+        /**
+         * Calls callback(user) for every proxy which box overlaps specified one
+         */
+        template<typename F>
+        void query(const Box& box, const F& callback) const {
+            if (root == NULL_NODE) {
+                return;
+            }
+
+            const auto half = glm::abs(box.size) * 0.5f;
+            const auto min = box.center - half;
+            const auto max = box.center + half;
+
+            std::vector<int32_t> stack;
+            stack.reserve(64);
+            stack.emplace_back(root);
+
+            while (!stack.empty()) {
+                const auto& node = nodes[stack.back()];
+                stack.pop_back();
+
+                if (!overlaps(node, min, max)) {
+                    continue;
+                }
+
+                if (node.isLeaf()) {
+                    callback(node.user);
+                } else {
+                    stack.emplace_back(node.left);
+                    stack.emplace_back(node.right);
+                }
+            }
+        }
+
+        /**
+         * Calls callback(user) for every proxy which box intersects frustum
+         *
+         * subtrees completely inside frustum are not tested further
+         */
+        template<typename F>
+        void query(const Frustum& frustum, const F& callback) const {
+            if (root == NULL_NODE) {
+                return;
+            }
+
+            std::vector<int32_t> stack;
+            std::vector<int32_t> inside;
+            stack.reserve(64);
+            stack.emplace_back(root);
+
+            while (!stack.empty()) {
+                const auto index = stack.back();
+                const auto& node = nodes[index];
+                stack.pop_back();
+
+                switch (frustum.classify(node.min, node.max)) {
+                    case Frustum::Intersection::Outside:
+                        break;
+                    case Frustum::Intersection::Inside:
+                        collect(index, inside, callback);
+                        break;
+                    case Frustum::Intersection::Intersects:
+                        if (node.isLeaf()) {
+                            callback(node.user);
+                        } else {
+                            stack.emplace_back(node.left);
+                            stack.emplace_back(node.right);
+                        }
+                        break;
+                }
+            }
+        }
+
+        /**
+         * Calls callback(user) for every proxy which box intersects sphere
+         */
+        template<typename F>
+        void query(const glm::vec3& center, float radius, const F& callback) const {
+            if (root == NULL_NODE) {
+                return;
+            }
+
+            const auto radius2 = radius * radius;
+
+            std::vector<int32_t> stack;
+            stack.reserve(64);
+            stack.emplace_back(root);
+
+            while (!stack.empty()) {
+                const auto& node = nodes[stack.back()];
+                stack.pop_back();
+
+                const auto closest = glm::clamp(center, node.min, node.max);
+                const auto delta = closest - center;
+                if (glm::dot(delta, delta) > radius2) {
+                    continue;
+                }
+
+                if (node.isLeaf()) {
+                    callback(node.user);
+                } else {
+                    stack.emplace_back(node.left);
+                    stack.emplace_back(node.right);
+                }
+            }
+        }
+
+        /**
+         * Calls callback(user, distance) for every proxy which box is hit by ray within max distance
+         *
+         * distance is a ray parameter of entry point, direction is expected to be normalized
+         */
+        template<typename F>
+        void raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance, const F& callback) const {
+            if (root == NULL_NODE) {
+                return;
+            }
+
+            const auto inverse = 1.0f / direction;
+
+            std::vector<int32_t> stack;
+            stack.reserve(64);
+            stack.emplace_back(root);
+
+            while (!stack.empty()) {
+                const auto& node = nodes[stack.back()];
+                stack.pop_back();
+
+                // slab test, ray parallel to slab hits it only if origin is between its planes
+                auto enter = 0.0f;
+                auto exit = max_distance;
+                for (int axis = 0; axis < 3 && enter <= exit; ++axis) {
+                    if (direction[axis] == 0.0f) {
+                        if (origin[axis] < node.min[axis] || origin[axis] > node.max[axis]) {
+                            exit = -1.0f;
+                        }
+                        continue;
+                    }
+
+                    const auto t1 = (node.min[axis] - origin[axis]) * inverse[axis];
+                    const auto t2 = (node.max[axis] - origin[axis]) * inverse[axis];
+                    enter = std::max(enter, std::min(t1, t2));
+                    exit = std::min(exit, std::max(t1, t2));
+                }
+
+                if (enter > exit) {
+                    continue;
+                }
+
+                if (node.isLeaf()) {
+                    callback(node.user, enter);
+                } else {
+                    stack.emplace_back(node.left);
+                    stack.emplace_back(node.right);
+                }
+            }
+        }
+    };
+}
@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/functions.hpp>
 #include <vector>
+#include <cmath>
 
 namespace Limitless {
     class Box {
@@ -11,6 +12,42 @@ namespace Limitless {
         glm::vec3 size;
     };
 
+    /**
+     * Boxes stored as separate arrays of center and half-size components
+     *
+     * used for batch intersection tests
+     */
+    class BoxArray {
+    public:
+        std::vector<float> center_x;
+        std::vector<float> center_y;
+        std::vector<float> center_z;
+        std::vector<float> extent_x;
+        std::vector<float> extent_y;
+        std::vector<float> extent_z;
+
+        void add(const Box& box) {
+            center_x.emplace_back(box.center.x);
+            center_y.emplace_back(box.center.y);
+            center_z.emplace_back(box.center.z);
+            // transformed boxes can have negative size
+            extent_x.emplace_back(std::abs(box.size.x) * 0.5f);
+            extent_y.emplace_back(std::abs(box.size.y) * 0.5f);
+            extent_z.emplace_back(std::abs(box.size.z) * 0.5f);
+        }
+
+        void clear() noexcept {
+            center_x.clear();
+            center_y.clear();
+            center_z.clear();
+            extent_x.clear();
+            extent_y.clear();
+            extent_z.clear();
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return center_x.size(); }
+    };
+
     template<typename V>
     inline Box calculateBoundingBox(const std::vector<V>& vertices) {
         auto min = glm::vec3{ std::numeric_limits<float>::max() };
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace Limitless {
+    /**
+     * FrameClock is the time source of simulation
+     *
+     * it is ticked once per frame and passed to everything that is simulated, so emitters and animations
+     * step by the same delta instead of querying system clock on their own;
+     * in fixed step mode every tick advances time by the step, so simulation is deterministic and can be replayed
+     */
+    class FrameClock final {
+    public:
+        using clock = std::chrono::steady_clock;
+        using time_point = clock::time_point;
+        using duration = std::chrono::duration<double>;
+    private:
+        /**
+         * Time of current frame
+         */
+        time_point time;
+
+        /**
+         * Time passed since previous frame
+         */
+        duration delta {};
+
+        /**
+         * Step of fixed step mode, system clock is used if not set
+         */
+        std::optional<duration> fixed_step;
+
+        uint64_t frame {};
+
+        static constexpr auto UNPUBLISHED = std::numeric_limits<clock::rep>::min();
+
+        /**
+         * Ticks of time of clock that has been published last
+         *
+         * it is read by workers while render thread publishes next frame, so it is kept atomic
+         */
+        static inline std::atomic<clock::rep> published {UNPUBLISHED};
+    public:
+        /**
+         * Creates clock at current system time
+         */
+        FrameClock() noexcept;
+
+        /**
+         * Creates clock in fixed step mode
+         */
+        explicit FrameClock(duration fixed_step) noexcept;
+
+        /**
+         * Advances clock to the next frame
+         *
+         * reads system clock once in realtime mode, adds step in fixed step mode
+         */
+        void tick() noexcept;
+
+        /**
+         * Advances clock by specified delta regardless of mode
+         */
+        void tick(duration delta) noexcept;
+
+        void setFixedStep(std::optional<duration> step) noexcept { fixed_step = step; }
+
+        [[nodiscard]] auto getTime() const noexcept { return time; }
+        [[nodiscard]] auto getDelta() const noexcept { return delta; }
+        [[nodiscard]] auto getFrame() const noexcept { return frame; }
+        [[nodiscard]] const auto& getFixedStep() const noexcept { return fixed_step; }
+
+        /**
+         * Makes time of clock current for consumers outside of simulation, such as time uniforms of materials
+         *
+         * called by scene update on render thread
+         */
+        static void publish(const FrameClock& clock) noexcept {
+            published.store(clock.time.time_since_epoch().count(), std::memory_order_release);
+        }
+
+        /**
+         * Returns published time or system time if no clock has been published
+         */
+        [[nodiscard]] static time_point getPublishedTime() noexcept {
+            const auto ticks = published.load(std::memory_order_acquire);
+            return ticks == UNPUBLISHED ? clock::now() : time_point {clock::duration {ticks}};
+        }
+    };
+}
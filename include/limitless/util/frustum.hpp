@@ -9,6 +9,7 @@ namespace Limitless {
     class Frustum {
     public:
         enum Planes { Left, Right, Bottom, Top, Near, Far };
+        enum class Intersection { Outside, Intersects, Inside };
     private:
         std::array<glm::vec4, 6> planes;
         std::array<glm::vec3, 8> points;
@@ -31,9 +32,27 @@ namespace Limitless {
          */
         bool intersects(Instance& instance) const;
 
+        /**
+         * Classifies box [min, max] against frustum planes
+         */
+        [[nodiscard]] Intersection classify(const glm::vec3& min, const glm::vec3& max) const noexcept;
+
+        /**
+         * Checks frustum planes intersection with boxes [begin, end) and sets bits of visible ones
+         *
+         * tests several boxes at once using SSE/AVX if available
+         * [begin] should be multiple of 64, so that different ranges never share the same bitset word
+         */
+        void intersects(const BoxArray& boxes, size_t begin, size_t end, uint64_t* visibility) const noexcept;
+
         /**
          * Creates Frustum from Camera
          */
         static Frustum fromCamera(const Camera& camera);
+
+        /**
+         * Creates Frustum from [projection * view] matrix
+         */
+        static Frustum fromMatrix(const glm::mat4& matrix);
     };
 }
\ No newline at end of file
@@ -1,10 +1,46 @@
 #pragma once
 
 #include <limitless/instances/model_instance.hpp>
+#include <limitless/util/frustum.hpp>
+#include <limitless/scene.hpp>
+#include <unordered_map>
 
 namespace Limitless {
+    class InstancedInstance;
+    class SkeletalInstancedInstance;
+    class SkeletalInstance;
+    class TerrainInstance;
+
+    /**
+     * FrustumCulling finds visible instances of the scene
+     *
+     * Single instances are found by scene spatial index,
+     * parts of instanced, skeletal instanced and terrain instances are gathered into one BoxArray,
+     * tested in batches on shared thread pool and written to flat visibility bitset
+     */
     class FrustumCulling {
     private:
+        /**
+         * Instance and range of its boxes in tested array
+         */
+        struct CullingRange {
+            std::shared_ptr<Instance> instance;
+            uint32_t first;
+            uint32_t count;
+        };
+
+        /**
+         * Boxes to test
+         */
+        BoxArray boxes;
+
+        /**
+         * Bit per box
+         */
+        std::vector<uint64_t> visibility;
+
+        std::vector<CullingRange> ranges;
+
         /**
          * Contains visible array of simple instances
          */
@@ -12,56 +48,50 @@ namespace Limitless {
 
         /**
          * Contains visible array of model instances for each instanced instance
+         *
+         * vectors are reused between frames, index is looked up by instance id
          */
-        std::map<uint64_t, std::vector<std::shared_ptr<ModelInstance>>> visible_instances_of_instanced_instances;
+        std::vector<std::vector<std::shared_ptr<ModelInstance>>> visible_instanced;
+        std::unordered_map<uint64_t, uint32_t> visible_instanced_index;
 
         /**
-         * Contains visible MeshInstances of TerrainInstance
+         * Contains visible array of skeletal instances for each skeletal instanced instance
          */
-        std::map<uint64_t, std::vector<std::reference_wrapper<MeshInstance>>> visible_meshes_of_terrain_instances;
-    public:
-        void update(Scene& scene, Camera& camera) {
-            visible.clear();
-            visible_instances_of_instanced_instances.clear();
-            visible_meshes_of_terrain_instances.clear();
+        std::vector<std::vector<std::shared_ptr<SkeletalInstance>>> visible_skeletal_instanced;
+        std::unordered_map<uint64_t, uint32_t> visible_skeletal_instanced_index;
 
-            const auto frustum = Frustum::fromCamera(camera);
-
-            for (auto& instance : scene.getInstances()) {
-                if (instance->getInstanceType() == InstanceType::Instanced) {
-                    auto& instanced = static_cast<InstancedInstance&>(*instance); //NOLINT
-
-                    for (auto& i: instanced.getInstances()) {
-                        if (frustum.intersects(*i)) {
-                            visible_instances_of_instanced_instances[instance->getId()].emplace_back(i);
-                        }
-                    }
+        /**
+         * Contains visible MeshInstances of TerrainInstance
+         */
+        std::vector<std::vector<std::reference_wrapper<MeshInstance>>> visible_terrain;
+        std::unordered_map<uint64_t, uint32_t> visible_terrain_index;
 
-                    if (visible_instances_of_instanced_instances.count(instance->getId()) != 0) {
-                        visible.emplace_back(instance);
-                    }
-                } else if (instance->getInstanceType() == InstanceType::Terrain) {
-                    auto& terrain = static_cast<TerrainInstance&>(*instance); //NOLINT
+        /**
+         * Boxes tested by one job
+         */
+        static constexpr size_t BATCH_SIZE = 4096;
 
-                    for (auto& [_, mesh_instance] : terrain.getMeshes()) {
-                        if (frustum.intersects(mesh_instance.getMesh()->getBoundingBox())) {
-                            visible_meshes_of_terrain_instances[instance->getId()].emplace_back(mesh_instance);
-                        }
-                    }
+        void gather(const Instances& instances);
+        void test(const Frustum& frustum);
+        void collect();
 
-                    if (visible_meshes_of_terrain_instances.count(instance->getId()) != 0) {
-                        visible.emplace_back(instance);
-                    }
-                } else {
-                    if (frustum.intersects(*instance)) {
-                        visible.emplace_back(instance);
-                    }
-                }
-            }
+        [[nodiscard]] bool isVisible(uint32_t index) const noexcept {
+            return (visibility[index / 64] >> (index % 64)) & 1u;
         }
+    public:
+        /**
+         * Culls scene instances against camera frustum
+         */
+        void update(Scene& scene, Camera& camera);
+
+        /**
+         * Culls scene instances against specified frustum
+         */
+        void update(Scene& scene, const Frustum& frustum);
 
         [[nodiscard]] const Instances& getVisibleInstances() const noexcept { return visible; }
-        [[nodiscard]] const std::vector<std::shared_ptr<ModelInstance>>& getVisibleModelInstanced(const InstancedInstance& instance) const noexcept { return visible_instances_of_instanced_instances.at(instance.getId()); }
-        const std::vector<std::reference_wrapper<MeshInstance>>& getVisibleTerrainMeshes(const TerrainInstance& instance) const noexcept { return visible_meshes_of_terrain_instances.at(instance.getId()); }
+        [[nodiscard]] const std::vector<std::shared_ptr<ModelInstance>>& getVisibleModelInstanced(const InstancedInstance& instance) const noexcept;
+        [[nodiscard]] const std::vector<std::shared_ptr<SkeletalInstance>>& getVisibleSkeletalInstanced(const SkeletalInstancedInstance& instance) const noexcept;
+        [[nodiscard]] const std::vector<std::reference_wrapper<MeshInstance>>& getVisibleTerrainMeshes(const TerrainInstance& instance) const noexcept;
     };
-}
\ No newline at end of file
+}
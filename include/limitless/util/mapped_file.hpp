@@ -0,0 +1,42 @@
+#pragma once
+
+#include <limitless/util/filesystem.hpp>
+#include <stdexcept>
+#include <cstddef>
+
+namespace Limitless {
+    class mapped_file_error : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * Read-only view of whole file mapped into memory
+     *
+     * pages are read by the system on first access, so loaders can upload data straight from the view
+     */
+    class MappedFile final {
+    private:
+        const std::byte* data {};
+        size_t size {};
+
+    #ifdef WIN32
+        void* file {};
+        void* mapping {};
+    #endif
+
+        void close() noexcept;
+    public:
+        explicit MappedFile(const fs::path& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& rhs) noexcept;
+        MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+        [[nodiscard]] const std::byte* getData() const noexcept { return data; }
+        [[nodiscard]] size_t getSize() const noexcept { return size; }
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Limitless {
+    /**
+     * Sorts values by 64-bit key in ascending order
+     *
+     * least significant digit radix sort with 8-bit digits, stable,
+     * passes over digits that are equal for all keys are skipped
+     *
+     * scratch is used as temporary storage and can be reused between calls to avoid allocations
+     */
+    template<typename T, typename KeyGetter>
+    void radixSort(std::vector<T>& values, std::vector<T>& scratch, const KeyGetter& key) {
+        // small arrays are faster to sort by comparison
+        if (values.size() < 64) {
+            std::stable_sort(values.begin(), values.end(), [&] (const T& lhs, const T& rhs) { return key(lhs) < key(rhs); });
+            return;
+        }
+
+        scratch.resize(values.size());
+
+        for (uint32_t shift = 0; shift < 64; shift += 8) {
+            std::array<size_t, 256> offsets {};
+            for (const auto& value : values) {
+                ++offsets[(key(value) >> shift) & 0xFF];
+            }
+
+            // every key has the same digit
+            if (offsets[(key(values.front()) >> shift) & 0xFF] == values.size()) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (auto& count : offsets) {
+                const auto current = count;
+                count = offset;
+                offset += current;
+            }
+
+            for (auto& value : values) {
+                scratch[offsets[(key(value) >> shift) & 0xFF]++] = std::move(value);
+            }
+
+            values.swap(scratch);
+        }
+    }
+}
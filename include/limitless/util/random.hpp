@@ -0,0 +1,21 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+
+namespace Limitless {
+    /**
+     * Returns random engine of calling thread
+     *
+     * every thread gets its own stream, so engine can be used from parallel tasks without locking
+     */
+    inline std::default_random_engine& getRandomEngine() noexcept {
+        static std::atomic<uint32_t> stream {0};
+        thread_local std::default_random_engine engine = [] {
+            std::seed_seq seed {std::random_device{}(), stream.fetch_add(1, std::memory_order_relaxed)};
+            return std::default_random_engine {seed};
+        }();
+        return engine;
+    }
+}
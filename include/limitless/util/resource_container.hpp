@@ -53,6 +53,16 @@ namespace Limitless {
             }
         }
 
+        /**
+         * Adds resource if name is not taken yet and returns contained one
+         *
+         * used by loaders that may add the same resource from different threads
+         */
+        std::shared_ptr<T> emplace(const std::string& name, std::shared_ptr<T> res) {
+            std::unique_lock lock(mutex);
+            return resource.emplace(name, std::move(res)).first->second;
+        }
+
         void remove(const std::string& name) {
             std::unique_lock lock(mutex);
             resource.erase(name);
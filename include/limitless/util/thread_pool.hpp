@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <algorithm>
 #include <functional>
 #include <future>
 #include <vector>
@@ -46,6 +47,59 @@ namespace Limitless {
             return future;
         }
 
+        /**
+         * Takes one queued task and runs it on calling thread
+         *
+         * returns false if queue is empty
+         */
+        bool runPendingTask();
+
+        /**
+         * Splits [0, count) into chunks of at least [grain] elements and calls func(begin, end) for each of them in parallel
+         *
+         * Calling thread takes the first chunk and helps with queued tasks while waiting,
+         * so it is safe to call from tasks of the same pool
+         */
+        template<typename F>
+        void parallelFor(size_t count, size_t grain, const F& func) {
+            if (count == 0) {
+                return;
+            }
+
+            const auto workers = threads.size() + 1;
+            const auto chunk = std::max<size_t>(std::max<size_t>(grain, 1), (count + workers - 1) / workers);
+
+            if (threads.empty() || chunk >= count) {
+                func(size_t{0}, count);
+                return;
+            }
+
+            std::vector<std::future<void>> futures;
+            futures.reserve(count / chunk);
+
+            for (size_t begin = chunk; begin < count; begin += chunk) {
+                futures.emplace_back(add([&func, begin, end = std::min(begin + chunk, count)] { func(begin, end); }));
+            }
+
+            func(size_t{0}, chunk);
+
+            for (auto& future : futures) {
+                while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    if (!runPendingTask()) {
+                        future.wait();
+                    }
+                }
+                future.get();
+            }
+        }
+
+        /**
+         * Engine pool for data-parallel work (culling, simulation, animation)
+         *
+         * uses all hardware threads except the calling one
+         */
+        static ThreadPool& getShared();
+
         void joinAll();
     };
 }
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Limitless {
+    /**
+     * Composes translation-rotation-scale matrix
+     *
+     * equal to translate(position) * toMat4(rotation) * scale(scale) but written column by column
+     * without any full matrix multiplication, rotation is expected to be normalized
+     */
+    inline glm::mat4 composeTRS(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) noexcept {
+        const float xx = rotation.x * rotation.x;
+        const float yy = rotation.y * rotation.y;
+        const float zz = rotation.z * rotation.z;
+        const float xy = rotation.x * rotation.y;
+        const float xz = rotation.x * rotation.z;
+        const float yz = rotation.y * rotation.z;
+        const float wx = rotation.w * rotation.x;
+        const float wy = rotation.w * rotation.y;
+        const float wz = rotation.w * rotation.z;
+
+        return glm::mat4 {
+            glm::vec4{1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f} * scale.x,
+            glm::vec4{2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f} * scale.y,
+            glm::vec4{2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f} * scale.z,
+            glm::vec4{position, 1.0f}
+        };
+    }
+}
@@ -6,39 +6,63 @@ struct InstanceData {
     uint id;
     uint is_outlined;
     uint decal_mask;
-    uint pad;
+    uint bone_offset;
 };
 
 // REGULAR MODEL
 #if defined (ENGINE_MATERIAL_REGULAR_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_MODEL) || defined (ENGINE_MATERIAL_DECAL_MODEL) || defined (ENGINE_MATERIAL_TERRAIN_MODEL)
-    layout (std140) uniform INSTANCE_BUFFER {
-        InstanceData _instance_data;
+    layout (std430) buffer INSTANCE_BUFFER {
+        InstanceData _instance_data[];
     };
 
+    uniform uint instance_index;
+
+    #if defined (ENGINE_MATERIAL_REGULAR_MODEL)
+        // instance slots of batched draws, batch_offset is 0xFFFFFFFF for single draw
+        layout (std430) buffer BATCH_BUFFER {
+            uint _batch_slots[];
+        };
+
+        uniform uint batch_offset;
+    #endif
+
+    uint getInstanceIndex() {
+        #if defined (ENGINE_MATERIAL_REGULAR_MODEL)
+            if (batch_offset != 0xFFFFFFFFu) {
+                return _batch_slots[batch_offset + uint(gl_InstanceID)];
+            }
+        #endif
+        return instance_index;
+    }
+
     mat4 getModelMatrix() {
-        return _instance_data.model_transform;
+        return _instance_data[getInstanceIndex()].model_transform;
     }
 
     vec3 getOutlineColor() {
-        return _instance_data.outline_color.rgb;
+        return _instance_data[getInstanceIndex()].outline_color.rgb;
     }
 
     uint getId() {
-        return _instance_data.id;
+        return _instance_data[getInstanceIndex()].id;
     }
 
     uint getIsOutlined() {
-        return _instance_data.is_outlined;
+        return _instance_data[getInstanceIndex()].is_outlined;
     }
 
     uint getDecalMask() {
-        return _instance_data.decal_mask;
+        return _instance_data[getInstanceIndex()].decal_mask;
+    }
+
+    uint getBoneOffset() {
+        return _instance_data[getInstanceIndex()].bone_offset;
     }
 #endif
 //
 
 // INSTANCED MODEL
-#if defined (ENGINE_MATERIAL_INSTANCED_MODEL)
+#if defined (ENGINE_MATERIAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
     layout (std430) buffer model_buffer {
         InstanceData _instances[];
     };
@@ -62,23 +86,45 @@ struct InstanceData {
     uint getDecalMask() {
         return _instances[gl_InstanceID].decal_mask;
     }
+
+    uint getBoneOffset() {
+        return _instances[gl_InstanceID].bone_offset;
+    }
 #endif
 //
 
 // SKELETAL MODEL
-#if defined (ENGINE_MATERIAL_SKELETAL_MODEL)
+#if defined (ENGINE_MATERIAL_SKELETAL_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
 layout (std430) buffer bone_buffer {
     mat4 _bones[];
 };
 
+// animations baked by BakedAnimations, rows are frames and every joint takes three texels with rows of bone matrix
+uniform sampler2D baked_animation;
+
+mat4 getBone(uint offset, int bone) {
+    // offset with high bit set is frame row of baked animation
+    if ((offset & 0x80000000u) != 0u) {
+        int frame = int(offset & 0x7FFFFFFFu);
+        vec4 r0 = texelFetch(baked_animation, ivec2(bone * 3, frame), 0);
+        vec4 r1 = texelFetch(baked_animation, ivec2(bone * 3 + 1, frame), 0);
+        vec4 r2 = texelFetch(baked_animation, ivec2(bone * 3 + 2, frame), 0);
+        return transpose(mat4(r0, r1, r2, vec4(0.0, 0.0, 0.0, 1.0)));
+    }
+
+    return _bones[int(offset) + bone];
+}
+
 mat4 getBoneMatrix() {
+    // bones of all skeletal instances share one buffer
+    uint bone_offset = getBoneOffset();
     ivec4 bone_id = getVertexBoneID();
     vec4 bone_weight = getVertexBoneWeight();
 
-    mat4 bone_transform = _bones[bone_id[0]] * bone_weight[0];
-    bone_transform     += _bones[bone_id[1]] * bone_weight[1];
-    bone_transform     += _bones[bone_id[2]] * bone_weight[2];
-    bone_transform     += _bones[bone_id[3]] * bone_weight[3];
+    mat4 bone_transform = getBone(bone_offset, bone_id[0]) * bone_weight[0];
+    bone_transform     += getBone(bone_offset, bone_id[1]) * bone_weight[1];
+    bone_transform     += getBone(bone_offset, bone_id[2]) * bone_weight[2];
+    bone_transform     += getBone(bone_offset, bone_id[3]) * bone_weight[3];
 
     return bone_transform;
 }
@@ -93,7 +139,7 @@ mat4 getBoneMatrix() {
 #endif
 
 mat4 getModelTransform() {
-    #if defined (ENGINE_MATERIAL_SKELETAL_MODEL)
+    #if defined (ENGINE_MATERIAL_SKELETAL_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
         return getModelMatrix() * getBoneMatrix();
     #else
         return getModelMatrix();
@@ -101,7 +147,7 @@ mat4 getModelTransform() {
 }
 
 // TBN matrix only for meshes
-#if (defined (MeshEmitter) || defined (ENGINE_MATERIAL_REGULAR_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_MODEL) || defined (ENGINE_MATERIAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_DECAL_MODEL) || defined (ENGINE_MATERIAL_TERRAIN_MODEL)) && defined (ENGINE_MATERIAL_NORMAL_TEXTURE) && defined (ENGINE_SETTINGS_NORMAL_MAPPING)
+#if (defined (MeshEmitter) || defined (ENGINE_MATERIAL_REGULAR_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_MODEL) || defined (ENGINE_MATERIAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_DECAL_MODEL) || defined (ENGINE_MATERIAL_TERRAIN_MODEL)) && defined (ENGINE_MATERIAL_NORMAL_TEXTURE) && defined (ENGINE_SETTINGS_NORMAL_MAPPING)
     mat3 getModelTBN(mat4 model_transform) {
         //TODO: pass through uniform instance buffer ? bone transform ?
         mat3 normal_matrix = transpose(inverse(mat3(model_transform)));
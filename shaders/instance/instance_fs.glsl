@@ -4,39 +4,52 @@ struct InstanceData {
     uint id;
     uint is_outlined;
     uint decal_mask;
-    uint pad;
+    uint bone_offset;
 };
 
 // REGULAR MODEL
 #if defined (ENGINE_MATERIAL_REGULAR_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_MODEL) || defined (ENGINE_MATERIAL_DECAL_MODEL) || defined (ENGINE_MATERIAL_TERRAIN_MODEL)
-    layout (std140) uniform INSTANCE_BUFFER {
-        InstanceData _instance_data;
+    layout (std430) buffer INSTANCE_BUFFER {
+        InstanceData _instance_data[];
     };
 
+    #if defined (ENGINE_MATERIAL_REGULAR_MODEL)
+        // resolved in vertex shader for batched draws
+        uint getInstanceIndex() {
+            return _in_data.instance_index;
+        }
+    #else
+        uniform uint instance_index;
+
+        uint getInstanceIndex() {
+            return instance_index;
+        }
+    #endif
+
     mat4 getModelMatrix() {
-        return _instance_data.model_transform;
+        return _instance_data[getInstanceIndex()].model_transform;
     }
 
     vec3 getOutlineColor() {
-        return _instance_data.outline_color.rgb;
+        return _instance_data[getInstanceIndex()].outline_color.rgb;
     }
 
     uint getId() {
-        return _instance_data.id;
+        return _instance_data[getInstanceIndex()].id;
     }
 
     uint getIsOutlined() {
-        return _instance_data.is_outlined;
+        return _instance_data[getInstanceIndex()].is_outlined;
     }
 
     uint getDecalMask() {
-        return _instance_data.decal_mask;
+        return _instance_data[getInstanceIndex()].decal_mask;
     }
 #endif
 //
 
 // INSTANCED MODEL
-#if defined (ENGINE_MATERIAL_INSTANCED_MODEL)
+#if defined (ENGINE_MATERIAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
     layout (std430) buffer model_buffer {
         InstanceData _instances[];
     };
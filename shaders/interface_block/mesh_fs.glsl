@@ -17,9 +17,13 @@ in _vertex_data {
         flat uint types;
     #endif
 
-    #if defined (ENGINE_MATERIAL_INSTANCED_MODEL)
+    #if defined (ENGINE_MATERIAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
         flat int instance_id;
     #endif
+
+    #if defined (ENGINE_MATERIAL_REGULAR_MODEL)
+        flat uint instance_index;
+    #endif
 } _in_data;
 
 vec3 getVertexPosition() {
@@ -66,7 +70,7 @@ vec2 getVertexUV() {
     }
 #endif
 
-#if defined (ENGINE_MATERIAL_INSTANCED_MODEL)
+#if defined (ENGINE_MATERIAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
     int getInstanceId() {
         return _in_data.instance_id;
     }
@@ -17,7 +17,11 @@ out _vertex_data {
         flat uint types;
     #endif
 
-    #if defined (ENGINE_MATERIAL_INSTANCED_MODEL)
+    #if defined (ENGINE_MATERIAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
         flat int instance_id;
     #endif
+
+    #if defined (ENGINE_MATERIAL_REGULAR_MODEL)
+        flat uint instance_index;
+    #endif
 } _out_data;
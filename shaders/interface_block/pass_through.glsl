@@ -81,8 +81,12 @@ void InterfaceBlockPassThrough(vec3 world_position, vec2 uv, mat4 model_transfor
             _out_data.types = getVertexTileType();
         #endif
 
-        #if defined (ENGINE_MATERIAL_INSTANCED_MODEL)
+        #if defined (ENGINE_MATERIAL_INSTANCED_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
            _out_data.instance_id = gl_InstanceID;
         #endif
+
+        #if defined (ENGINE_MATERIAL_REGULAR_MODEL)
+            _out_data.instance_index = getInstanceIndex();
+        #endif
     #endif
 }
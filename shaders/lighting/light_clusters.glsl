@@ -0,0 +1,35 @@
+/*
+    punctual lights are assigned to clusters of 3D grid aligned to camera frustum
+
+    _cluster_size - grid dimensions
+    _cluster_depth - near, far, slice scale, slice bias
+    _cluster_data - [offset, count] pair per cluster followed by light indices
+*/
+
+layout (std430) buffer LIGHT_CLUSTERS {
+    uvec4 _cluster_size;
+    vec4 _cluster_depth;
+    uint _cluster_data[];
+};
+
+/*
+    returns offset and count of lights in cluster containing world position
+*/
+uvec2 getLightCluster(const vec3 world_position) {
+    vec4 view_position = getView() * vec4(world_position, 1.0);
+    vec4 clip_position = getProjection() * view_position;
+
+    ivec2 size = ivec2(_cluster_size.xy);
+    ivec2 tile = clamp(ivec2((clip_position.xy / clip_position.w * 0.5 + 0.5) * vec2(size)), ivec2(0), size - 1);
+
+    float depth = max(-view_position.z, _cluster_depth.x);
+    int slice = clamp(int(log(depth) * _cluster_depth.z + _cluster_depth.w), 0, int(_cluster_size.z) - 1);
+
+    uint cluster = (uint(slice) * _cluster_size.y + uint(tile.y)) * _cluster_size.x + uint(tile.x);
+
+    return uvec2(_cluster_data[cluster * 2u], _cluster_data[cluster * 2u + 1u]);
+}
+
+uint getClusterLightIndex(const uint index) {
+    return _cluster_data[index];
+}
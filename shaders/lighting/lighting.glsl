@@ -5,6 +5,7 @@
 #include "../shading/custom.glsl"
 
 #include "./scene_lighting.glsl"
+#include "./light_clusters.glsl"
 #include "./shadows.glsl"
 
 vec3 computeLight(const ShadingContext sctx, const LightingContext lctx, const Light light) {
@@ -60,8 +61,11 @@ vec3 computeLights(const ShadingContext sctx) {
     color += sctx.indirect_lighting;
 #endif
 
-    for (uint i = 0u; i < getLightCount(); ++i) {
-        Light light = getLight(i);
+    // only lights of the cluster can affect shaded point
+    uvec2 cluster = getLightCluster(sctx.worldPos);
+
+    for (uint i = 0u; i < cluster.y; ++i) {
+        Light light = getLight(getClusterLightIndex(cluster.x + i));
 
         LightingContext lctx = computeLightingContext(sctx, light);
 
@@ -53,46 +53,49 @@ layout (std430) buffer mesh_emitter_particles {
     MeshParticle _particles[];
 };
 
+// index of the first particle of drawn emitters in buffer
+uniform uint particle_offset;
+
 mat4 getModelMatrix() {
-    return _particles[gl_InstanceID].model;
+    return _particles[particle_offset + uint(gl_InstanceID)].model;
 }
 
 vec4 getParticleColor() {
-    return _particles[gl_InstanceID].color;
+    return _particles[particle_offset + uint(gl_InstanceID)].color;
 }
 
 vec4 getParticleSubUV() {
-    return _particles[gl_InstanceID].subUV;
+    return _particles[particle_offset + uint(gl_InstanceID)].subUV;
 }
 
 vec4 getParticleProperties() {
-    return _particles[gl_InstanceID].properties;
+    return _particles[particle_offset + uint(gl_InstanceID)].properties;
 }
 
 vec3 getParticleAcceleration() {
-    return _particles[gl_InstanceID].acceleration_lifetime.xyz;
+    return _particles[particle_offset + uint(gl_InstanceID)].acceleration_lifetime.xyz;
 }
 
 float getParticleLifetime() {
-    return _particles[gl_InstanceID].acceleration_lifetime.w;
+    return _particles[particle_offset + uint(gl_InstanceID)].acceleration_lifetime.w;
 }
 
 vec3 getParticlePosition() {
-    return _particles[gl_InstanceID].position.xyz;
+    return _particles[particle_offset + uint(gl_InstanceID)].position.xyz;
 }
 
 vec3 getParticleSize() {
-    return _particles[gl_InstanceID].size.xyz;
+    return _particles[particle_offset + uint(gl_InstanceID)].size.xyz;
 }
 
 vec3 getParticleRotation() {
-    return _particles[gl_InstanceID].rotation_time.xyz;
+    return _particles[particle_offset + uint(gl_InstanceID)].rotation_time.xyz;
 }
 
 float getParticleTime() {
-    return _particles[gl_InstanceID].rotation_time.w;
+    return _particles[particle_offset + uint(gl_InstanceID)].rotation_time.w;
 }
 
 vec3 getParticleVelocity() {
-    return _particles[gl_InstanceID].velocity.xyz;
+    return _particles[particle_offset + uint(gl_InstanceID)].velocity.xyz;
 }
@@ -4,7 +4,7 @@ layout (location = 1) in vec3 _vertex_normal;
     layout (location = 2) in vec3 _vertex_tangent;
 #endif
 layout (location = 3) in vec2 _vertex_uv;
-#if defined (ENGINE_MATERIAL_SKELETAL_MODEL)
+#if defined (ENGINE_MATERIAL_SKELETAL_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
     layout (location = 4) in ivec4 _vertex_bone_id;
     layout (location = 5) in vec4 _vertex_bone_weight;
 #endif
@@ -35,7 +35,7 @@ vec2 getVertexUV() {
     }
 #endif
 
-#if defined (ENGINE_MATERIAL_SKELETAL_MODEL)
+#if defined (ENGINE_MATERIAL_SKELETAL_MODEL) || defined (ENGINE_MATERIAL_SKELETAL_INSTANCED_MODEL)
     ivec4 getVertexBoneID() {
         return _vertex_bone_id;
     }
@@ -113,6 +113,7 @@ void Assets::compileAssets(Context& ctx, const RendererSettings& settings) {
 
 void Assets::recompileAssets(Context& ctx, const RendererSettings& settings) {
     shaders.clear();
+    Shader::clearSourceCache();
     compileAssets(ctx, settings);
 }
 
@@ -156,6 +157,8 @@ void Assets::compileEffect(Context& ctx, const RendererSettings& settings, const
     for (const auto& pass_shader : getRequiredPassShaders(settings)) {
         compiler.compile(*effect, pass_shader);
     }
+
+    compiler.compile(*effect, ShaderType::ParticleSimulation);
 }
 
 void Assets::compileSkybox(Context& ctx, const RendererSettings& settings, const std::shared_ptr<Skybox>& skybox) {
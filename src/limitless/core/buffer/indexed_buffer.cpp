@@ -12,7 +12,30 @@ std::shared_ptr<Buffer> IndexedBuffer::get(std::string_view name) {
 }
 
 void IndexedBuffer::add(std::string_view name, std::shared_ptr<Buffer> buffer) noexcept {
-    buffers.emplace(name, std::move(buffer));
+    auto it = buffers.emplace(name, std::move(buffer));
+    resolve(it->first);
+}
+
+void IndexedBuffer::resolve(const std::string& name) {
+    const auto handle = getHandle(name);
+
+    if (handle >= resolved.size()) {
+        resolved.resize(handle + 1);
+    }
+
+    resolved[handle] = buffers.count(name) == 1 ? buffers.find(name)->second : nullptr;
+}
+
+IndexedBuffer::Handle IndexedBuffer::getHandle(std::string_view name) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, Handle> handles;
+
+    std::unique_lock lock(mutex);
+    return handles.try_emplace(std::string{name}, static_cast<Handle>(handles.size())).first->second;
+}
+
+Buffer* IndexedBuffer::find(Handle handle) const noexcept {
+    return handle < resolved.size() ? resolved[handle].get() : nullptr;
 }
 
 GLuint IndexedBuffer::getBindingPoint(Type type, std::string_view name) noexcept {
@@ -61,4 +84,5 @@ void IndexedBuffer::remove(const std::string &name, const std::shared_ptr<Buffer
     while (found->second != buffer) { ++found; }
 
     buffers.erase(found);
+    resolve(name);
 }
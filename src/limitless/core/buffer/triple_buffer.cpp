@@ -92,6 +92,20 @@ void TripleBuffer::bind() const noexcept {
     buffers[curr_index]->bind();
 }
 
+TripleBuffer* TripleBuffer::clone() {
+    return new TripleBuffer {{
+        std::shared_ptr<Buffer>(buffers[0]->clone()),
+        std::shared_ptr<Buffer>(buffers[1]->clone()),
+        std::shared_ptr<Buffer>(buffers[2]->clone())
+    }};
+}
+
+void TripleBuffer::resize(size_t bytes) noexcept {
+    for (const auto& buffer : buffers) {
+        buffer->resize(bytes);
+    }
+}
+
 void TripleBuffer::waitFence() noexcept {
     buffers[curr_index]->waitFence();
 }
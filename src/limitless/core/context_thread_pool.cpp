@@ -35,14 +35,8 @@ ContextThreadPool::ContextThreadPool(Context& shared, uint32_t pool_size)
 
                 task();
 
-                // explicitly share state between contexts
-                {
-                    // make sure that all commands in a queue
-                    glFlush();
-
-                    // make sure that all commands are finished
-                    glFinish();
-                }
+                // submits commands of task, tasks place fences to signal when their objects are ready for other contexts
+                glFlush();
             }
         };
 
@@ -0,0 +1,135 @@
+#include <limitless/core/shader/program_binary_cache.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/shader/shader.hpp>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+using namespace Limitless;
+
+namespace {
+    constexpr uint32_t CACHE_MAGIC = 0x4342504C; // LPBC
+    constexpr uint32_t CACHE_VERSION = 1;
+
+    class CacheHeader {
+    public:
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t format;
+        uint32_t size;
+    };
+
+    // FNV-1a, stable between runs and builds unlike std::hash
+    constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+    constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+    uint64_t hash(uint64_t seed, const void* data, size_t size) noexcept {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            seed = (seed ^ bytes[i]) * FNV_PRIME;
+        }
+        return seed;
+    }
+
+    std::string getString(GLenum name) {
+        const auto* str = reinterpret_cast<const char*>(glGetString(name)); //NOLINT
+        return str ? str : "";
+    }
+}
+
+ProgramBinaryCache::ProgramBinaryCache(fs::path _directory)
+    : directory {std::move(_directory)}
+    , driver {getString(GL_VENDOR) + '|' + getString(GL_RENDERER) + '|' + getString(GL_VERSION)} {
+}
+
+bool ProgramBinaryCache::isSupported() noexcept {
+    if (!ContextInitializer::isExtensionSupported("GL_ARB_get_program_binary")) {
+        return false;
+    }
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+fs::path ProgramBinaryCache::getPath(uint64_t key) const {
+    std::stringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return directory / name.str();
+}
+
+uint64_t ProgramBinaryCache::getKey(const std::vector<Shader>& shaders) const noexcept {
+    auto key = hash(FNV_OFFSET, driver.data(), driver.size());
+
+    for (const auto& shader : shaders) {
+        const auto type = static_cast<GLenum>(shader.getType());
+        key = hash(key, &type, sizeof(type));
+        key = hash(key, shader.getSource().data(), shader.getSource().size());
+    }
+
+    return key;
+}
+
+GLuint ProgramBinaryCache::load(uint64_t key) const {
+    const auto path = getPath(key);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return 0;
+    }
+
+    CacheHeader header {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header)); //NOLINT
+    if (!file || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key) {
+        return 0;
+    }
+
+    std::vector<char> binary(header.size);
+    file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!file) {
+        return 0;
+    }
+
+    const GLuint program_id = glCreateProgram();
+    glProgramBinary(program_id, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // driver can reject binary made by another driver build, then it is compiled from sources and rewritten
+    GLint status = GL_FALSE;
+    glGetProgramiv(program_id, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE) {
+        glDeleteProgram(program_id);
+        return 0;
+    }
+
+    return program_id;
+}
+
+void ProgramBinaryCache::store(uint64_t key, GLuint program_id) const {
+    GLint size = 0;
+    glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0) {
+        return;
+    }
+
+    CacheHeader header {CACHE_MAGIC, CACHE_VERSION, key, 0, 0};
+
+    std::vector<char> binary(size);
+    GLsizei length = 0;
+    glGetProgramBinary(program_id, size, &length, &header.format, binary.data());
+    if (length <= 0) {
+        return;
+    }
+    header.size = static_cast<uint32_t>(length);
+
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error) {
+        return;
+    }
+
+    std::ofstream file(getPath(key), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header)); //NOLINT
+    file.write(binary.data(), length);
+}
@@ -1,8 +1,11 @@
 #include <limitless/core/shader/shader.hpp>
 #include <limitless/core/context_initializer.hpp>
 #include <limitless/core/keyline_extensions.hpp>
+#include <unordered_map>
 #include <string>
 #include <sstream>
+#include <optional>
+#include <mutex>
 #include <limitless/core/shader/shader_extensions.hpp>
 
 using namespace Limitless;
@@ -84,24 +87,52 @@ void Shader::replaceKey(const std::string& key, const std::string& value) noexce
     }
 }
 
-std::string Shader::getSource(const fs::path& filepath) {
-    try {
-        std::ifstream file(filepath);
-        std::string file_source;
+namespace {
+    // contains <file path, source> or nullopt if file is missing
+    std::mutex source_cache_mutex;
+    std::unordered_map<std::string, std::optional<std::string>> source_cache;
+
+    std::optional<std::string> readSource(const fs::path& filepath) {
+        try {
+            std::ifstream file(filepath);
+            std::string file_source;
+
+            file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
 
-        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+            if (file.good()) {
+                std::stringstream stream;
+                stream << file.rdbuf();
 
-        if (file.good()) {
-            std::stringstream stream;
-            stream << file.rdbuf();
+                file_source = stream.str();
+            }
 
-            file_source = stream.str();
+            return file_source;
+        } catch (...) {
+            return std::nullopt;
         }
+    }
+}
 
-        return file_source;
-    } catch (...) {
+std::string Shader::getSource(const fs::path& filepath) {
+    const auto key = filepath.lexically_normal().string();
+
+    std::unique_lock lock(source_cache_mutex);
+
+    auto found = source_cache.find(key);
+    if (found == source_cache.end()) {
+        found = source_cache.emplace(key, readSource(filepath)).first;
+    }
+
+    if (!found->second) {
         throw shader_file_not_found(filepath.string());
     }
+
+    return *found->second;
+}
+
+void Shader::clearSourceCache() noexcept {
+    std::unique_lock lock(source_cache_mutex);
+    source_cache.clear();
 }
 
 void Shader::resolveIncludes(const fs::path& base_dir, std::string& src) {
@@ -17,6 +17,9 @@ ShaderCompiler::ShaderCompiler(Context& _context)
 ShaderCompiler::ShaderCompiler(Context& _context, const RendererSettings& _settings)
     : context {_context}
     , render_settings {_settings} {
+    if (!_settings.shader_cache_directory.empty() && ProgramBinaryCache::isSupported()) {
+        binary_cache.emplace(_settings.shader_cache_directory);
+    }
 }
 
 void ShaderCompiler::checkStatus(const GLuint program_id) {
@@ -52,8 +55,23 @@ std::shared_ptr<ShaderProgram> ShaderCompiler::compile() {
         throw shader_linking_error("No shaders to link. ShaderCompiler is empty.");
     }
 
+    // sources are fully preprocessed at this point, so they identify program binary
+    uint64_t key {};
+    if (binary_cache) {
+        key = binary_cache->getKey(shaders);
+
+        if (const auto program_id = binary_cache->load(key); program_id != 0) {
+            shaders.clear();
+            return std::shared_ptr<ShaderProgram>(new ShaderProgram(program_id));
+        }
+    }
+
     const GLuint program_id = glCreateProgram();
 
+    if (binary_cache) {
+        glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     for (const auto& shader : shaders) {
         shader.compile();
 
@@ -64,6 +82,10 @@ std::shared_ptr<ShaderProgram> ShaderCompiler::compile() {
 
     checkStatus(program_id);
 
+    if (binary_cache) {
+        binary_cache->store(key, program_id);
+    }
+
     shaders.clear();
 
     return std::shared_ptr<ShaderProgram>(new ShaderProgram(program_id));
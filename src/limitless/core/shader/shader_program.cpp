@@ -11,12 +11,25 @@ using namespace Limitless;
 
 ShaderProgram::ShaderProgram(GLuint id) noexcept
     : id {id}
-    , locations {ShaderProgramIntrospection::getUniformLocations(id)}
     , indexed_binds {ShaderProgramIntrospection::getIndexedBufferBounds(id)} {
+    for (auto& [name, location] : ShaderProgramIntrospection::getUniformLocations(id)) {
+        handles.emplace(name, static_cast<UniformHandle>(names.size()));
+        names.emplace_back(name);
+        locations.emplace_back(location);
+    }
+
+    uniforms.resize(names.size());
+
+    const auto found = std::find_if(indexed_binds.begin(), indexed_binds.end(), [] (const auto& buf) { return buf.name == "MATERIAL_BUFFER"; });
+    if (found != indexed_binds.end()) {
+        material_bind = static_cast<int32_t>(found - indexed_binds.begin());
+    }
 }
 
 void ShaderProgram::bindIndexedBuffers() {
-    for (auto& [target, name, block_index, bound_point, connected] : indexed_binds) {
+    auto* ctx = Context::getCurrentContext();
+
+    for (auto& [target, name, block_index, bound_point, handle, connected] : indexed_binds) {
         // connects index block inside program with state binding point
         if (!connected) {
             switch (target) {
@@ -30,26 +43,24 @@ void ShaderProgram::bindIndexedBuffers() {
             connected = true;
         }
 
-        if (auto* ctx = Context::getCurrentContext(); ctx) {
-            // binds buffer to state binding point
-            try {
-                auto buffer = ctx->getIndexedBuffers().get(name);
-
-                Buffer::Type program_target {};
-                switch (target) {
-                    case IndexedBuffer::Type::UniformBuffer:
-                        program_target = Buffer::Type::Uniform;
-                        break;
-                    case IndexedBuffer::Type::ShaderStorage:
-                        program_target = Buffer::Type::ShaderStorage;
-                        break;
-                }
-
-                buffer->bindBaseAs(program_target, bound_point);
-            } catch (const buffer_not_found& e) {
-                continue;
-            }
+        // binds buffer to state binding point
+        // buffer can be missing or set manually if it is ambiguous
+        auto* buffer = ctx ? ctx->getIndexedBuffers().find(handle) : nullptr;
+        if (!buffer) {
+            continue;
+        }
+
+        Buffer::Type program_target {};
+        switch (target) {
+            case IndexedBuffer::Type::UniformBuffer:
+                program_target = Buffer::Type::Uniform;
+                break;
+            case IndexedBuffer::Type::ShaderStorage:
+                program_target = Buffer::Type::ShaderStorage;
+                break;
         }
+
+        buffer->bindBaseAs(program_target, bound_point);
     }
 }
 
@@ -78,83 +89,115 @@ void ShaderProgram::use() {
 
         bindResources();
 
-        for (auto& [name, uniform] : uniforms) {
-            uniform->set();
+        for (const auto handle : active) {
+            uniforms[handle]->set();
         }
     }
 }
 
-template<typename T>
-ShaderProgram& ShaderProgram::setUniform(const std::string& name, const T& value) {
-    // if uniform got optimized out
-    if (locations.find(name) == locations.end()) {
-        return *this;
+ShaderProgram::UniformHandle ShaderProgram::getUniformHandle(const std::string& name) const noexcept {
+    const auto found = handles.find(name);
+    return found != handles.end() ? found->second : INVALID_UNIFORM;
+}
+
+ShaderProgram::UniformHandle ShaderProgram::getUniformHandle(const UniformName& name) noexcept {
+    if (name.getId() >= named.size()) {
+        named.resize(name.getId() + 1, UNRESOLVED_UNIFORM);
     }
 
-    // if not present, add new
-    if (auto it = uniforms.find(name); it == uniforms.end()) {
-        uniforms[name] = std::make_unique<UniformValue<T>>(name, value);
-        uniforms[name]->setLocation(locations.at(name));
-    } else {
-        // else just update value
-        static_cast<UniformValue<T>&>(*it->second).setValue(value);
+    auto& handle = named[name.getId()];
+    if (handle == UNRESOLVED_UNIFORM) {
+        handle = getUniformHandle(name.getName());
     }
 
-    return *this;
+    return handle;
 }
 
-ShaderProgram& ShaderProgram::setUniform(const std::string& name, std::shared_ptr<Texture> texture) {
+template<typename U, typename V>
+ShaderProgram& ShaderProgram::setValue(UniformHandle handle, const V& value) {
     // if uniform got optimized out
-    if (locations.find(name) == locations.end()) {
+    if (handle >= uniforms.size()) {
         return *this;
     }
 
+    auto& uniform = uniforms[handle];
+
     // if not present, add new
-    if (auto it = uniforms.find(name); it == uniforms.end()) {
-        uniforms[name] = std::make_unique<UniformSampler>(name, std::move(texture));
-        uniforms[name]->setLocation(locations.at(name));
+    if (!uniform) {
+        uniform = std::make_unique<U>(names[handle], value);
+        uniform->setLocation(locations[handle]);
+        active.emplace_back(handle);
+        return *this;
+    }
+
+    // else just update value
+    if constexpr (std::is_same_v<U, UniformSampler>) {
+        static_cast<UniformSampler&>(*uniform).setSampler(value); //NOLINT
     } else {
-        // else just update value
-        static_cast<UniformSampler&>(*it->second).setSampler(std::move(texture)); //NOLINT
+        static_cast<U&>(*uniform).setValue(value); //NOLINT
     }
 
     return *this;
 }
 
+template<typename T>
+ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const T& value) {
+    return setValue<UniformValue<T>>(handle, value);
+}
+
+ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, std::shared_ptr<Texture> texture) {
+    return setValue<UniformSampler>(handle, texture);
+}
+
 ShaderProgram& ShaderProgram::setMaterial(const ms::Material& material) {
     // if not present for whatever reason just return
-    auto found = std::find_if(indexed_binds.begin(), indexed_binds.end(), [] (const auto& buf) { return buf.name == "MATERIAL_BUFFER"; });
-    if (found == indexed_binds.end()) {
+    if (material_bind == -1) {
         return *this;
     }
 
     // bind current material buffer to shader
     // these contain scalar values
-    material.getBuffer().getBuffer()->bindBase(found->bound_point);
+    material.getBuffer().getBuffer()->bindBase(indexed_binds[material_bind].bound_point);
 
     // and we need explicitly set samplers
-    for (const auto& [type, uniform] : material.getProperties()) {
-        if (uniform->getType() == UniformType::Sampler) {
-            setUniform(uniform->getName(), static_cast<UniformSampler&>(*uniform).getSampler()); //NOLINT
+    // materials of the same program usually share sampler layout, so handles are cached by position
+    // and validated by name; differing layout resolves its samplers again
+    size_t i = 0;
+
+    const auto set = [&] (const Uniform& uniform) {
+        if (uniform.getType() != UniformType::Sampler) {
+            return;
+        }
+
+        const auto& name = uniform.getName();
+
+        if (i == material_samplers.size()) {
+            material_samplers.emplace_back(name, getUniformHandle(name));
+        } else if (material_samplers[i].first != name) {
+            material_samplers[i] = {name, getUniformHandle(name)};
         }
+
+        setUniform(material_samplers[i++].second, static_cast<const UniformSampler&>(uniform).getSampler()); //NOLINT
+    };
+
+    for (const auto& [type, uniform] : material.getProperties()) {
+        set(*uniform);
     }
 
     for (const auto& [name, uniform] : material.getUniforms()) {
-        if (uniform->getType() == UniformType::Sampler) {
-            setUniform(uniform->getName(), static_cast<UniformSampler&>(*uniform).getSampler()); //NOLINT
-        }
+        set(*uniform);
     }
 
     return *this;
 }
 
 namespace Limitless {
-    template ShaderProgram& ShaderProgram::setUniform(const std::string &name, const int32_t& value);
-    template ShaderProgram& ShaderProgram::setUniform(const std::string &name, const uint32_t& value);
-    template ShaderProgram& ShaderProgram::setUniform(const std::string &name, const float& value);
-    template ShaderProgram& ShaderProgram::setUniform(const std::string &name, const glm::vec2& value);
-    template ShaderProgram& ShaderProgram::setUniform(const std::string &name, const glm::vec3& value);
-    template ShaderProgram& ShaderProgram::setUniform(const std::string &name, const glm::vec4& value);
-    template ShaderProgram& ShaderProgram::setUniform(const std::string &name, const glm::mat3& value);
-    template ShaderProgram& ShaderProgram::setUniform(const std::string &name, const glm::mat4& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const int32_t& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const uint32_t& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const float& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const glm::vec2& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const glm::vec3& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const glm::vec4& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const glm::mat3& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformHandle handle, const glm::mat4& value);
 }
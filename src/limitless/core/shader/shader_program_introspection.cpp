@@ -52,7 +52,8 @@ std::vector<IndexedBufferData> ShaderProgramIntrospection::getIndexedBufferBound
             const auto index = glGetProgramResourceIndex(id, static_cast<GLenum>(type), name.data());
 
             if (auto *ctx = Context::getCurrentContext(); ctx) {
-                indexed_binds.emplace_back(type, name, index, ctx->getIndexedBuffers().getBindingPoint(type, name));
+                auto& buffers = ctx->getIndexedBuffers();
+                indexed_binds.emplace_back(type, name, index, buffers.getBindingPoint(type, name), IndexedBuffer::getHandle(name));
             }
         }
     }
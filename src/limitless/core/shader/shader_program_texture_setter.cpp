@@ -7,11 +7,11 @@
 
 using namespace Limitless;
 
-void ShaderProgramTextureSetter::bindTextures(const std::map<std::string, std::unique_ptr<Uniform>>& uniforms) {
+void ShaderProgramTextureSetter::bindTextures(const std::vector<std::unique_ptr<Uniform>>& uniforms) {
     // first we collect all passed Texture Samplers
     std::vector<Texture*> samplers;
-    for (const auto& [_, uniform] : uniforms) {
-        if (uniform->getType() == UniformType::Sampler) {
+    for (const auto& uniform : uniforms) {
+        if (uniform && uniform->getType() == UniformType::Sampler) {
             samplers.emplace_back(static_cast<UniformSampler&>(*uniform).getSampler().get()); //NOLINT
         }
     }
@@ -36,14 +36,14 @@ void ShaderProgramTextureSetter::bindTextures(const std::map<std::string, std::u
     // then we update unit values in uniforms and set them in shader
     std::vector<Uniform*> bound;
     for (const auto& texture : se_samplers) {
-        bound.emplace_back(std::find_if(uniforms.begin(), uniforms.end(), [&] (auto& p) {
-            if (p.second->getType() == UniformType::Sampler) {
-                auto &sampler = static_cast<UniformSampler&>(*p.second); //NOLINT
+        bound.emplace_back(std::find_if(uniforms.begin(), uniforms.end(), [&] (auto& uniform) {
+            if (uniform && uniform->getType() == UniformType::Sampler) {
+                auto &sampler = static_cast<UniformSampler&>(*uniform); //NOLINT
                 return sampler.getSampler()->getId() == texture->getId();
             } else {
                 return false;
             }
-        })->second.get());
+        })->get());
     }
 
     uint32_t i = 0;
@@ -1,4 +1,5 @@
 #include <limitless/core/sync.hpp>
+#include <utility>
 
 using namespace Limitless;
 
@@ -6,6 +7,18 @@ Sync::~Sync() {
     remove();
 }
 
+Sync::Sync(Sync&& rhs) noexcept
+    : sync {std::exchange(rhs.sync, {})} {
+}
+
+Sync& Sync::operator=(Sync&& rhs) noexcept {
+    if (this != &rhs) {
+        remove();
+        sync = std::exchange(rhs.sync, {});
+    }
+    return *this;
+}
+
 Sync::State Sync::waitUntil(std::chrono::nanoseconds timeout) {
     const auto result = glClientWaitSync(sync, 0, timeout.count());
     return static_cast<State>(result);
@@ -22,12 +35,14 @@ bool Sync::isDone() {
 }
 
 void Sync::place() {
+    remove();
     sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 }
 
 void Sync::remove() {
     if (sync) {
         glDeleteSync(sync);
+        sync = {};
     }
 }
 
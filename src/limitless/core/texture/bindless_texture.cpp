@@ -150,6 +150,12 @@ BindlessTexture& BindlessTexture::setWrapR(GLenum target, GLenum wrap) {
     return *this;
 }
 
+BindlessTexture& BindlessTexture::setLevelRange(GLenum target, GLint base, GLint max) {
+    makeNonResident();
+    texture->setLevelRange(target, base, max);
+    return *this;
+}
+
 void BindlessTexture::compressedTexImage2D(GLenum target, GLint level, GLenum internal_format, glm::uvec2 size, bool border, const void *data, std::size_t bytes) noexcept {
     makeNonResident();
     texture->compressedTexImage2D(target, level, internal_format, size, border, data, bytes);
@@ -112,3 +112,9 @@ NamedTexture& NamedTexture::setWrapR([[maybe_unused]] GLenum _target, GLenum wra
     glTextureParameteri(id, GL_TEXTURE_WRAP_R, wrap);
     return *this;
 }
+
+NamedTexture& NamedTexture::setLevelRange([[maybe_unused]] GLenum _target, GLint base, GLint max) {
+    glTextureParameteri(id, GL_TEXTURE_BASE_LEVEL, base);
+    glTextureParameteri(id, GL_TEXTURE_MAX_LEVEL, max);
+    return *this;
+}
@@ -150,6 +150,13 @@ StateTexture& StateTexture::setWrapR(GLenum target, GLenum wrap) {
     return *this;
 }
 
+StateTexture& StateTexture::setLevelRange(GLenum target, GLint base, GLint max) {
+    bind(target, 0);
+    glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, base);
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, max);
+    return *this;
+}
+
 void StateTexture::compressedTexImage2D(GLenum target, GLint level, GLenum internal_format, glm::uvec2 size, bool border, const void *data, std::size_t bytes) noexcept {
     bind(target, 0);
 
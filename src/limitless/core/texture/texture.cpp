@@ -30,7 +30,8 @@ void Texture::storage(const void* data) {
         }
     }
 
-    if (mipmap) {
+    // compressed levels are uploaded as stored
+    if (mipmap && !compressed) {
         generateMipMap();
     }
 }
@@ -147,6 +148,10 @@ std::shared_ptr<Texture> Texture::clone() {
 }
 
 std::shared_ptr<Texture> Texture::clone(glm::uvec3 s) {
+    return clone(s, levels);
+}
+
+std::shared_ptr<Texture> Texture::clone(glm::uvec3 s, uint32_t l) {
     auto clone = std::shared_ptr<Texture>(new Texture());
 
     clone->texture = std::unique_ptr<ExtensionTexture>(texture->clone());
@@ -163,7 +168,7 @@ std::shared_ptr<Texture> Texture::clone(glm::uvec3 s) {
     clone->wrap_r = wrap_r;
     clone->wrap_s = wrap_s;
     clone->wrap_t = wrap_t;
-    clone->levels = levels;
+    clone->levels = l;
     clone->anisotropic = anisotropic;
     clone->mipmap = mipmap;
     clone->compressed = compressed;
@@ -198,6 +203,31 @@ std::shared_ptr<Texture> Texture::clone(glm::uvec2 s) {
     return clone(glm::uvec3{s, 1});
 }
 
+std::shared_ptr<Texture> Texture::shrink(uint32_t base_level) {
+    if (!is2D()) {
+        throw std::runtime_error("Only 2D texture can be shrunk");
+    }
+
+    if (base_level >= levels) {
+        throw std::runtime_error("Base level is out of texture levels");
+    }
+
+    const auto shrunk_size = glm::max(glm::uvec2 {size} >> base_level, glm::uvec2 {1});
+    auto shrunk = clone(glm::uvec3 {shrunk_size, 1}, levels - base_level);
+
+    for (uint32_t level = 0; level < shrunk->levels; ++level) {
+        const auto level_size = glm::max(shrunk_size >> level, glm::uvec2 {1});
+
+        glCopyImageSubData(
+            getId(), static_cast<GLenum>(target), static_cast<GLint>(level + base_level), 0, 0, 0,
+            shrunk->getId(), static_cast<GLenum>(target), static_cast<GLint>(level), 0, 0, 0,
+            static_cast<GLsizei>(level_size.x), static_cast<GLsizei>(level_size.y), 1
+        );
+    }
+
+    return shrunk;
+}
+
 void Texture::accept(TextureVisitor& visitor) {
     texture->accept(visitor);
 }
@@ -244,6 +274,11 @@ Texture& Texture::setWrapR(Wrap wrap) {
     return *this;
 }
 
+Texture& Texture::setLevelRange(uint32_t base, uint32_t max) {
+    texture->setLevelRange(static_cast<GLenum>(target), static_cast<GLint>(base), static_cast<GLint>(max));
+    return *this;
+}
+
 void Texture::setParameters() {
     setMinFilter(min);
     setMagFilter(mag);
@@ -150,7 +150,10 @@ std::shared_ptr<Texture> Texture::Builder::buildImmutable() {
     }
 
     if (isCompressed()) {
-        throw std::runtime_error("Compressed immutable textures not yet supported!");
+        texture->storage();
+        if (texture->is2D()) {
+            texture->compressedSubImage(0, {0, 0}, static_cast<glm::uvec2>(texture->size), data_, byte_count);
+        }
     } else {
         if (isCubeMap()) {
             texture->storage(cube_data);
@@ -172,6 +175,7 @@ std::shared_ptr<Texture> Texture::Builder::build() {
 Texture::Builder& Texture::Builder::compressed_data(const void* _data, std::size_t count) {
     data_= _data;
     byte_count = count;
+    texture->compressed = true;
     return *this;
 }
 
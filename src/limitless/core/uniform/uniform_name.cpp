@@ -0,0 +1,21 @@
+#include <limitless/core/uniform/uniform_name.hpp>
+
+#include <unordered_map>
+#include <mutex>
+
+using namespace Limitless;
+
+namespace {
+    uint32_t intern(const std::string& name) {
+        static std::mutex mutex;
+        static std::unordered_map<std::string, uint32_t> ids;
+
+        std::unique_lock lock(mutex);
+        return ids.try_emplace(name, static_cast<uint32_t>(ids.size())).first->second;
+    }
+}
+
+UniformName::UniformName(std::string _name)
+    : name {std::move(_name)}
+    , id {intern(name)} {
+}
@@ -7,7 +7,8 @@ using namespace Limitless;
 
 UniformSampler::UniformSampler(std::string name, std::shared_ptr<Texture> sampler) noexcept
     : UniformValue {std::move(name), UniformType::Sampler, -1}
-    , sampler{std::move(sampler)} {}
+    , sampler{std::move(sampler)}
+    , sampler_id {this->sampler ? this->sampler->getId() : 0} {}
 
 std::unique_ptr<Uniform> UniformSampler::clone() noexcept {
     return std::make_unique<UniformSampler>(*this);
@@ -21,6 +22,13 @@ void UniformSampler::setSampler(const std::shared_ptr<Texture>& texture) noexcep
     }
 }
 
+void UniformSampler::refresh() noexcept {
+    if (sampler && sampler_id != sampler->getId()) {
+        sampler_id = sampler->getId();
+        changed = true;
+    }
+}
+
 const std::shared_ptr<Texture>& UniformSampler::getSampler() const noexcept {
     return sampler;
 }
@@ -1,4 +1,5 @@
 #include <limitless/core/uniform/uniform_time.hpp>
+#include <limitless/util/frame_clock.hpp>
 
 using namespace Limitless;
 
@@ -17,13 +18,15 @@ std::unique_ptr<Uniform> UniformTime::clone() noexcept {
 void UniformTime::update() noexcept {
     using namespace std::chrono;
 
+    // time of frame published by scene, so all materials see the same time
+    const auto now = FrameClock::getPublishedTime();
     if (start == time_point<steady_clock>{}) {
-        start = steady_clock::now();
+        start = now;
     }
 
-    setValue(duration_cast<duration<float>>(steady_clock::now() - start).count());
+    setValue(duration_cast<duration<float>>(now - start).count());
 }
 
 void UniformTime::reset() noexcept {
-    start = std::chrono::steady_clock::now();
+    start = FrameClock::getPublishedTime();
 }
@@ -13,9 +13,7 @@ VertexAttribute::VertexAttribute(GLint _size, GLenum _type, GLboolean _normalize
     , pointer {_pointer}
     , buffer {std::move(buffer)} {}
 
-VertexArray::VertexArray() noexcept {
-    glGenVertexArrays(1, &id);
-}
+VertexArray::VertexArray() noexcept = default;
 
 VertexArray::~VertexArray() {
     if (id != 0) {
@@ -28,9 +26,34 @@ VertexArray::~VertexArray() {
     }
 }
 
+void VertexArray::generate(ContextState& ctx) const noexcept {
+    glGenVertexArrays(1, &id);
+    glBindVertexArray(id);
+    ctx.vertex_array_id = id;
+
+    for (const auto& [index, attribute] : attributes) {
+        attribute.buffer->bind();
+        glEnableVertexAttribArray(index);
+
+        if (attribute.type == GL_INT || attribute.type == GL_UNSIGNED_INT) {
+            glVertexAttribIPointer(index, attribute.size, attribute.type, attribute.stride, attribute.pointer);
+        } else {
+            glVertexAttribPointer(index, attribute.size, attribute.type, attribute.normalized, attribute.stride, attribute.pointer);
+        }
+    }
+
+    // element binding is state of new object, so cached binding of context is not relevant
+    if (element_buffer) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer->getId());
+        ctx.buffer_target[Buffer::Type::Element] = element_buffer->getId();
+    }
+}
+
 void VertexArray::bind() const noexcept {
     Context::apply([this] (Context& ctx) {
-        if (ctx.vertex_array_id != id) {
+        if (id == 0) {
+            generate(ctx);
+        } else if (ctx.vertex_array_id != id) {
             glBindVertexArray(id);
             ctx.vertex_array_id = id;
         }
@@ -81,6 +104,8 @@ VertexArray& VertexArray::operator=(VertexArray&& rhs) noexcept {
 void Limitless::swap(VertexArray& lhs, VertexArray& rhs) {
     using std::swap;
 
+    swap(lhs.attributes, rhs.attributes);
+    swap(lhs.element_buffer, rhs.element_buffer);
     swap(lhs.id, rhs.id);
 }
 
@@ -97,6 +122,13 @@ VertexArray& VertexArray::operator<<(const std::pair<TextVertex, const std::shar
 }
 
 void VertexArray::setAttribute(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer, const std::shared_ptr<Buffer>& buffer) {
+    attributes.insert_or_assign(index, VertexAttribute{size, type, normalized, stride, pointer, buffer});
+
+    // replayed on generation
+    if (id == 0) {
+        return;
+    }
+
     bind();
 
     buffer->bind();
@@ -108,30 +140,20 @@ void VertexArray::setAttribute(GLuint index, GLint size, GLenum type, GLboolean
     } else {
         glVertexAttribPointer(index, size, type, normalized, stride, pointer);
     }
-
-    attributes.insert_or_assign(index, VertexAttribute{size, type, normalized, stride, pointer, buffer});
 }
 
 void VertexArray::setElementBuffer(const std::shared_ptr<Buffer>& buffer) {
-    bind();
-    buffer->bind();
-
     if (!element_buffer || element_buffer->getId() != buffer->getId()) {
         element_buffer = buffer;
     }
+
+    if (id != 0) {
+        bind();
+        buffer->bind();
+    }
 }
 
 VertexArray::VertexArray(const VertexArray& rhs)
     : attributes {rhs.attributes}
     , element_buffer {rhs.element_buffer} {
-    glGenVertexArrays(1, &id);
-
-    for (const auto& [index, attribute] : attributes) {
-        const auto& [size, type, normalized, stride, pointer, buffer] = attribute;
-        setAttribute(index, size, type, normalized, stride, pointer, buffer);
-    }
-
-    if (element_buffer) {
-        setElementBuffer(element_buffer);
-    }
 }
@@ -38,6 +38,11 @@ EffectBuilder& EffectBuilder::setLocalSpace(bool local_space) {
     return *this;
 }
 
+EffectBuilder& EffectBuilder::setGpuSimulation(bool gpu_simulation) {
+    effect->emitters.at(last_emitter)->getGpuSimulation() = gpu_simulation;
+    return *this;
+}
+
 EffectBuilder& EffectBuilder::setSpawnMode(EmitterSpawn::Mode mode) {
     effect->emitters.at(last_emitter)->getSpawn().mode = mode;
     if (mode == EmitterSpawn::Mode::Burst) {
@@ -7,16 +7,29 @@
 #include <limitless/instances/effect_instance.hpp>
 #include <limitless/assets.hpp>
 #include <limitless/fx/effect_shader_define_replacer.hpp>
+#include <limitless/fx/particle_simulation.hpp>
 
 using namespace Limitless::fx;
 using namespace Limitless;
 
+namespace {
+    template<typename P>
+    bool isSimulatedOnGpu(const Emitter<P>& emitter) noexcept {
+        return emitter.getGpuSimulation() && ParticleSimulation<P>::isSupported(emitter);
+    }
+}
+
 EffectCompiler::EffectCompiler(Context& context, Assets& assets, const RendererSettings& settings)
     : MaterialCompiler(context, assets, settings) {
 }
 
 template<typename T>
 void EffectCompiler::compile(ShaderType shader_type, const T& emitter) {
+    // simulation shader is needed only by emitters simulated on GPU
+    if (shader_type == ShaderType::ParticleSimulation && !isSimulatedOnGpu(emitter)) {
+        return;
+    }
+
     if (!assets.shaders.reserveIfNotContains({emitter.getUniqueShaderType(), shader_type})) {
         const auto props = [&] (Shader& shader) {
             EffectShaderDefineReplacer::replaceMaterialDependentDefine(shader, emitter.getMaterial(), InstanceType::Effect, emitter);
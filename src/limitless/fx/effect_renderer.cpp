@@ -10,60 +10,46 @@
 
 using namespace Limitless::fx;
 
-void EffectRenderer::visitEmitters(const Instances& instances, EmitterVisitor& emitter_visitor) noexcept {
-    auto effect_instance_visitor = [] (const EffectInstance& effect_instance, EmitterVisitor& visitor) {
-        for (const auto& [name, emitter] : effect_instance.getEmitters()) {
-            emitter->accept(visitor);
-        }
-    };
-
-    std::function<void(const Instance& instance)> visitor = [&] (const Instance& instance) {
-        for (const auto& [_, attachment] : instance.getAttachments()) {
-            visitor(*attachment);
-        }
+void EffectRenderer::visitEmitters(const Instance& instance, EmitterVisitor& visitor) noexcept {
+    for (const auto& [_, attachment] : instance.getAttachments()) {
+        visitEmitters(*attachment, visitor);
+    }
 
-        if (instance.getInstanceType() == InstanceType::Effect) {
-            effect_instance_visitor(static_cast<const EffectInstance&>(instance), emitter_visitor);
+    if (instance.getInstanceType() == InstanceType::Effect) {
+        for (const auto& [name, emitter] : static_cast<const EffectInstance&>(instance).getEmitters()) {
+            emitter->accept(visitor);
         }
-    };
-
-    for (const auto& instance : instances) {
-        visitor(*instance);
     }
 }
 
-void EffectRenderer::updateRenderers(const Instances& instances) noexcept {
+void EffectRenderer::update(const Assets& assets, const Instances& instances) {
     EmitterRendererCreator creator {renderers};
-    visitEmitters(instances, creator);
-}
+    for (const auto& instance : instances) {
+        visitEmitters(*instance, creator);
+    }
 
-void EffectRenderer::update(const Instances& instances) {
-    updateRenderers(instances);
+    sprite_storage.begin();
+    mesh_storage.begin();
+    beam_storage.begin();
 
     for (const auto& [type, renderer] : renderers) {
         type.material->update();
         switch (type.emitter_type) {
-            case AbstractEmitter::Type::Sprite: {
-                ParticleCollector<SpriteParticle> collector {type};
-                visitEmitters(instances, collector);
-                static_cast<EmitterRenderer<SpriteParticle>&>(*renderer).update(collector);
+            case AbstractEmitter::Type::Sprite:
+                static_cast<EmitterRenderer<SpriteParticle>&>(*renderer).update(assets, sprite_storage);
                 break;
-            }
-            case AbstractEmitter::Type::Mesh: {
-                ParticleCollector<MeshParticle> collector {type};
-                visitEmitters(instances, collector);
-                static_cast<EmitterRenderer<MeshParticle>&>(*renderer).update(collector);
+            case AbstractEmitter::Type::Mesh:
+                static_cast<EmitterRenderer<MeshParticle>&>(*renderer).update(assets, mesh_storage);
                 break;
-            }
-            case AbstractEmitter::Type::Beam: {
-                ParticleCollector<BeamParticleMapping> collector {type};
-                visitEmitters(instances, collector);
-                static_cast<EmitterRenderer<BeamParticle>&>(*renderer).update(collector);
+            case AbstractEmitter::Type::Beam:
+                static_cast<EmitterRenderer<BeamParticle>&>(*renderer).update(beam_storage);
                 break;
-            }
         }
-
     }
+
+    sprite_storage.end();
+    mesh_storage.end();
+    beam_storage.end();
 }
 
 void EffectRenderer::draw(Context& ctx, const Assets& assets, ShaderType shader, ms::Blending blending, const UniformSetter& setter) {
@@ -71,17 +57,17 @@ void EffectRenderer::draw(Context& ctx, const Assets& assets, ShaderType shader,
         switch (type.emitter_type) {
             case AbstractEmitter::Type::Sprite: {
                 auto& sprite_renderer = static_cast<EmitterRenderer<SpriteParticle>&>(*renderer);
-                sprite_renderer.draw(ctx, assets, shader, *type.material, blending, setter);
+                sprite_renderer.draw(ctx, assets, shader, *type.material, blending, setter, sprite_storage);
                 break;
             }
             case AbstractEmitter::Type::Mesh: {
                 auto& mesh_renderer = static_cast<EmitterRenderer<MeshParticle>&>(*renderer);
-                mesh_renderer.draw(ctx, assets, shader, type.mesh.value(), *type.material, blending, setter);
+                mesh_renderer.draw(ctx, assets, shader, type.mesh.value(), *type.material, blending, setter, mesh_storage);
                 break;
             }
             case AbstractEmitter::Type::Beam: {
                 auto& beam_renderer = static_cast<EmitterRenderer<BeamParticle>&>(*renderer);
-                beam_renderer.draw(ctx, assets, shader, *type.material, blending, setter);
+                beam_renderer.draw(ctx, assets, shader, *type.material, blending, setter, beam_storage);
                 break;
             }
         }
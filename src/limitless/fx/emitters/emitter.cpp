@@ -1,5 +1,9 @@
 #include <limitless/fx/emitters/emitter.hpp>
 
+#include <limitless/fx/particle_simulation.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <limitless/util/frame_clock.hpp>
+
 using namespace Limitless::fx;
 
 template<typename Particle>
@@ -12,8 +16,19 @@ Emitter<P>::Emitter(Type _type)
     : AbstractEmitter(_type) {
 }
 
+template<typename P>
+Emitter<P>::~Emitter() = default;
+
+template<typename P>
+Emitter<P>::Emitter(Emitter&&) noexcept = default;
+
 template<typename P>
 void Emitter<P>::emit(uint32_t count) noexcept {
+    if (simulation) {
+        simulation->emit(count);
+        return;
+    }
+
     for (uint32_t i = 0; i < count; ++i) {
         P particle {};
 
@@ -21,10 +36,10 @@ void Emitter<P>::emit(uint32_t count) noexcept {
         particle.rotation = glm::eulerAngles(rotation * local_rotation);
 
         for (auto& module : modules) {
-            module->initialize(*this, particle, particles.size());
+            module->initialize(*this, particle, particles.count());
         }
 
-        particles.emplace_back(particle);
+        particles.push(particle);
     }
 }
 
@@ -53,6 +68,11 @@ bool& Emitter<P>::getLocalSpace() noexcept {
     return local_space;
 }
 
+template<typename P>
+bool& Emitter<P>::getGpuSimulation() noexcept {
+    return gpu_simulation;
+}
+
 template<typename P>
 EmitterSpawn& Emitter<P>::getSpawn() noexcept {
     return spawn;
@@ -83,6 +103,11 @@ bool Emitter<P>::getLocalSpace() const noexcept {
     return local_space;
 }
 
+template<typename P>
+bool Emitter<P>::getGpuSimulation() const noexcept {
+    return gpu_simulation;
+}
+
 template<typename P>
 const glm::vec3& Emitter<P>::getLocalPosition() const noexcept {
     return local_position;
@@ -109,8 +134,8 @@ void Emitter<P>::setPosition(const glm::vec3& new_position) noexcept {
         const auto final_position = new_position + local_position;
         const auto diff = final_position - (position + local_position);
 
-        for (auto& particle : particles) {
-            particle.position += diff;
+        for (auto& particle_position : particles.position) {
+            particle_position += diff;
         }
     }
 
@@ -123,11 +148,12 @@ void Emitter<P>::setRotation(const glm::quat& new_rotation) noexcept {
         const auto final_rotation = new_rotation * local_rotation;
         const auto diff = final_rotation * glm::inverse(rotation * local_rotation);
 
-        for (auto& particle : particles) {
-            particle.rotation += glm::eulerAngles(diff);
+        const auto angles = glm::eulerAngles(diff);
+        for (size_t i = 0; i < particles.count(); ++i) {
+            particles.rotation[i] += angles;
 
-            particle.velocity = diff * particle.velocity;
-            particle.acceleration = diff * particle.acceleration;
+            particles.velocity[i] = diff * particles.velocity[i];
+            particles.acceleration[i] = diff * particles.acceleration[i];
         }
     }
 
@@ -146,7 +172,7 @@ void Emitter<P>::spawnParticles() noexcept {
         return spawn.last_spawn == time_point<steady_clock>();
     };
 
-    const auto current_time = steady_clock::now();
+    const auto current_time = frame_time;
     if (isFirst()) {
         spawn.last_spawn = current_time;
     }
@@ -155,7 +181,7 @@ void Emitter<P>::spawnParticles() noexcept {
     switch (spawn.mode) {
         case EmitterSpawn::Mode::Spray: {
             if (delta >= (1.0f / spawn.spawn_rate) || isFirst()) {
-                const auto remaining = spawn.max_count - particles.size();
+                const auto remaining = spawn.max_count - particles.count();
                 if (remaining > 0) {
                     emit(glm::clamp(static_cast<size_t>(delta * spawn.spawn_rate), static_cast<size_t>(1), remaining));
                 }
@@ -167,7 +193,7 @@ void Emitter<P>::spawnParticles() noexcept {
             if (spawn.burst->loops != spawn.burst->loops_done) {
                 if (delta >= (1.0f / spawn.spawn_rate) || isFirst()) {
                     auto emit_count = spawn.burst->burst_count->get();
-                    emit_count = (particles.size() + emit_count > spawn.max_count) ? spawn.max_count - particles.size() : emit_count;
+                    emit_count = (particles.count() + emit_count > spawn.max_count) ? spawn.max_count - particles.count() : emit_count;
                     emit(emit_count);
 
                     if (spawn.burst->loops != -1) {
@@ -183,49 +209,91 @@ void Emitter<P>::spawnParticles() noexcept {
 
 template<typename P>
 void Emitter<P>::killParticles() noexcept {
-    std::vector<size_t> indices;
-    for (size_t i = 0; i < particles.size(); ++i) {
-        if (particles[i].lifetime <= 0.0f) {
-            indices.emplace_back(i);
+    // swaps dead particle with the last one, modules mirror the same removal
+    for (size_t i = 0; i < particles.count();) {
+        if (particles.lifetime[i] <= 0.0f) {
+            particles.remove(i);
+
+            for (auto& module : modules) {
+                module->deinitialize(i);
+            }
+        } else {
+            ++i;
         }
     }
+}
 
-    for (auto it = particles.begin(); it != particles.end();) {
-        if (it->lifetime <= 0.0f) {
-            it = particles.erase(it);
+template<typename P>
+void Emitter<P>::updateParticles(const Camera& camera, float dt) {
+    const auto count = particles.count();
+    const auto parallel = count >= PARALLEL_PARTICLE_COUNT;
+
+    const auto forRanges = [&] (const auto& func) {
+        if (parallel) {
+            ThreadPool::getShared().parallelFor(count, PARTICLE_RANGE_SIZE, func);
         } else {
+            func(size_t{0}, count);
+        }
+    };
+
+    // splits modules into runs of splittable ones, module order is kept
+    for (auto it = modules.begin(); it != modules.end();) {
+        if (!(*it)->isSplittable()) {
+            (*it)->update(*this, particles, 0, count, dt, camera);
             ++it;
+            continue;
         }
-    }
 
-    for (auto& module : modules) {
-        module->deinitialize(indices);
+        const auto last = std::find_if(it, modules.end(), [] (const auto& module) { return !module->isSplittable(); });
+        forRanges([&] (size_t begin, size_t end) {
+            for (auto module = it; module != last; ++module) {
+                (*module)->update(*this, particles, begin, end, dt, camera);
+            }
+        });
+        it = last;
     }
+
+    forRanges([&] (size_t begin, size_t end) {
+        auto* particle_position = particles.position.data();
+        auto* velocity = particles.velocity.data();
+        const auto* acceleration = particles.acceleration.data();
+        for (size_t i = begin; i < end; ++i) {
+            particle_position[i] += velocity[i] * dt;
+            velocity[i] += acceleration[i] * dt;
+        }
+    });
 }
 
 template<typename P>
-void Emitter<P>::update(const Camera &camera) {
+void Emitter<P>::update(const Camera &camera, const FrameClock& clock) {
     using namespace std::chrono;
 
-    const auto current_time = steady_clock::now();
+    // emitter may skip frames, so delta is taken from its own last update
+    const auto current_time = clock.getTime();
+    if (start_time == time_point<steady_clock>()) {
+        start_time = current_time;
+        last_time = current_time;
+    }
+
     const auto delta_time = duration_cast<std::chrono::duration<float>>(current_time - last_time);
     last_time = current_time;
+    frame_time = current_time;
 
-	if (start_time == time_point<steady_clock>()) {
-		start_time = current_time;
-	}
-
-    killParticles();
-
-    {
-        for (auto& module : modules) {
-            module->update(*this, particles, delta_time.count(), camera);
+    if (gpu_simulation && !simulation) {
+        if (ParticleSimulation<P>::isSupported(*this)) {
+            simulation = std::make_unique<ParticleSimulation<P>>(spawn.max_count);
+        } else {
+            gpu_simulation = false;
         }
+    }
 
-        for (auto& particle : particles) {
-            particle.position += particle.velocity * delta_time.count();
-            particle.velocity += particle.acceleration * delta_time.count();
-        }
+    if (simulation) {
+        // particles are simulated by render thread, only elapsed time is accumulated
+        simulation->advance(delta_time.count());
+    } else {
+        killParticles();
+
+        updateParticles(camera, delta_time.count());
     }
 
     if (!done) {
@@ -252,6 +320,7 @@ Emitter<P>::Emitter(const Emitter& emitter)
     , position {emitter.position}
     , rotation {emitter.rotation}
     , local_space {emitter.local_space}
+    , gpu_simulation {emitter.gpu_simulation}
     , spawn {emitter.spawn}
     , duration {emitter.duration}
     , unique_shader {emitter.unique_shader} {
@@ -21,19 +21,20 @@ MeshEmitter* MeshEmitter::clone() const {
     return new MeshEmitter(*this);
 }
 
-void MeshEmitter::update(const Camera &camera) {
-    Emitter::update(camera);
+void MeshEmitter::update(const Camera &camera, const FrameClock& clock) {
+    Emitter::update(camera, clock);
 
-    for (auto& particle : particles) {
-        auto model = glm::translate(glm::mat4(1.0f), particle.position);
+    for (size_t i = 0; i < particles.count(); ++i) {
+        const auto& particle_rotation = particles.rotation[i];
+        auto model = glm::translate(glm::mat4(1.0f), particles.position[i]);
 
-        model = glm::rotate(model, particle.rotation.x, glm::vec3(1.0f, 0.f, 0.f));
-        model = glm::rotate(model, particle.rotation.y, glm::vec3(0.0f, 1.f, 0.f));
-        model = glm::rotate(model, particle.rotation.z, glm::vec3(0.0f, 0.f, 1.f));
+        model = glm::rotate(model, particle_rotation.x, glm::vec3(1.0f, 0.f, 0.f));
+        model = glm::rotate(model, particle_rotation.y, glm::vec3(0.0f, 1.f, 0.f));
+        model = glm::rotate(model, particle_rotation.z, glm::vec3(0.0f, 0.f, 1.f));
 
-        model = glm::scale(model, particle.size);
+        model = glm::scale(model, particles.size[i]);
 
-        particle.model = model;
+        particles.model[i] = model;
     }
 }
 
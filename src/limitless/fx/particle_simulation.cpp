@@ -0,0 +1,318 @@
+#include <limitless/fx/particle_simulation.hpp>
+
+#include <limitless/fx/modules/modules.hpp>
+#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/core/shader/shader_program.hpp>
+#include <limitless/core/uniform/uniform_name.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/keyline_extensions.hpp>
+#include <limitless/core/vertex_array.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/models/abstract_mesh.hpp>
+
+#include <numeric>
+#include <optional>
+#include <map>
+
+using namespace Limitless::fx;
+using namespace Limitless;
+
+namespace {
+    const UniformName STAGE {"stage"};
+    const UniformName INVOCATION_COUNT {"invocation_count"};
+    const UniformName DELTA_TIME {"dt"};
+    const UniformName SEED {"seed"};
+    const UniformName EMITTER_POSITION {"emitter_position"};
+    const UniformName EMITTER_ROTATION {"emitter_rotation"};
+    const UniformName EMITTER_EULER {"emitter_euler"};
+    const UniformName SUBUV_FACTOR {"subuv_factor"};
+    const UniformName SUBUV_FRAME_COUNT {"subuv_frame_count"};
+    const UniformName SUBUV_FPS {"subuv_fps"};
+
+    constexpr uint32_t UPDATE_STAGE = 0;
+    constexpr uint32_t EMIT_STAGE = 1;
+
+    class RangeUniform {
+    public:
+        UniformName min;
+        UniformName max;
+    };
+
+    const std::map<ModuleType, RangeUniform> RANGE_UNIFORMS = {
+        {ModuleType::InitialLocation,       {UniformName{"initial_location_min"}, UniformName{"initial_location_max"}}},
+        {ModuleType::InitialRotation,       {UniformName{"initial_rotation_min"}, UniformName{"initial_rotation_max"}}},
+        {ModuleType::InitialVelocity,       {UniformName{"initial_velocity_min"}, UniformName{"initial_velocity_max"}}},
+        {ModuleType::InitialColor,          {UniformName{"initial_color_min"}, UniformName{"initial_color_max"}}},
+        {ModuleType::InitialSize,           {UniformName{"initial_size_min"}, UniformName{"initial_size_max"}}},
+        {ModuleType::InitialAcceleration,   {UniformName{"initial_acceleration_min"}, UniformName{"initial_acceleration_max"}}},
+        {ModuleType::VelocityByLife,        {UniformName{"velocity_by_life_min"}, UniformName{"velocity_by_life_max"}}},
+        {ModuleType::ColorByLife,           {UniformName{"color_by_life_min"}, UniformName{"color_by_life_max"}}},
+        {ModuleType::RotationRate,          {UniformName{"rotation_rate_min"}, UniformName{"rotation_rate_max"}}},
+        {ModuleType::SizeByLife,            {UniformName{"size_by_life_min"}, UniformName{"size_by_life_max"}}},
+        {ModuleType::Lifetime,              {UniformName{"lifetime_min"}, UniformName{"lifetime_max"}}},
+    };
+
+    // shader samples uniformly between min and max
+    template<typename T>
+    std::optional<std::pair<T, T>> getRange(const Distribution<T>& distribution) noexcept {
+        switch (distribution.getType()) {
+            case DistributionType::Const:
+                return std::pair {distribution.get(), distribution.get()};
+            case DistributionType::Range: {
+                const auto& range = static_cast<const RangeDistribution<T>&>(distribution); //NOLINT
+                return std::pair {range.getMin(), range.getMax()};
+            }
+            case DistributionType::Curve:
+                break;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Invokes function with every <module type, distribution> of modules
+     *
+     * returns false if there is module without shader implementation
+     */
+    template<typename P, typename Function>
+    bool visitDistributions(const EmitterModules<P>& modules, Function&& f) {
+        for (const auto& module : modules) {
+            const auto type = module->getType();
+            switch (type) {
+                case ModuleType::InitialLocation:
+                    f(type, *static_cast<const InitialLocation<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::InitialRotation:
+                    f(type, *static_cast<const InitialRotation<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::InitialVelocity:
+                    f(type, *static_cast<const InitialVelocity<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::InitialColor:
+                    f(type, *static_cast<const InitialColor<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::InitialSize:
+                    f(type, *static_cast<const InitialSize<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::InitialAcceleration:
+                    f(type, *static_cast<const InitialAcceleration<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::VelocityByLife:
+                    f(type, *static_cast<const VelocityByLife<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::ColorByLife:
+                    f(type, *static_cast<const ColorByLife<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::RotationRate:
+                    f(type, *static_cast<const RotationRate<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::SizeByLife:
+                    f(type, *static_cast<const SizeByLife<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::Lifetime:
+                    f(type, *static_cast<const Lifetime<P>&>(*module).getDistribution()); //NOLINT
+                    break;
+                case ModuleType::SubUV:
+                case ModuleType::Time:
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+}
+
+template<typename P>
+ParticleSimulation<P>::ParticleSimulation(uint32_t _max_count) noexcept
+    : max_count {_max_count} {
+}
+
+template<typename P>
+ParticleSimulation<P>::~ParticleSimulation() = default;
+
+template<typename P>
+bool ParticleSimulation<P>::isSupported() noexcept {
+    static const bool supported = ContextInitializer::isExtensionSupported(compute_shader) &&
+                                  ContextInitializer::isExtensionSupported(shader_storage_buffer_object) &&
+                                  ContextInitializer::isExtensionSupported(draw_indirect);
+    return supported;
+}
+
+template<typename P>
+bool ParticleSimulation<P>::isSupported(const Emitter<P>& emitter) noexcept {
+    if constexpr (std::is_same_v<P, BeamParticle>) {
+        return false;
+    } else {
+        if (!isSupported() || emitter.getLocalSpace() || emitter.getSpawn().max_count == 0) {
+            return false;
+        }
+
+        bool supported = true;
+        const auto modules = visitDistributions(emitter.getModules(), [&] ([[maybe_unused]] ModuleType type, const auto& distribution) {
+            supported = supported && getRange(distribution).has_value();
+        });
+
+        return modules && supported;
+    }
+}
+
+template<typename P>
+void ParticleSimulation<P>::emit(uint32_t count) noexcept {
+    pending_emit = std::min(pending_emit + count, max_count);
+}
+
+template<typename P>
+void ParticleSimulation<P>::advance(float dt) noexcept {
+    pending_time = std::min(pending_time + dt, MAX_STEP);
+}
+
+template<typename P>
+void ParticleSimulation<P>::initialize() {
+    // all slots are dead and free
+    std::vector<P> particles(max_count);
+    for (auto& particle : particles) {
+        particle.lifetime = 0.0f;
+    }
+
+    std::vector<uint32_t> free_slots(max_count + 1);
+    free_slots[0] = max_count;
+    std::iota(free_slots.begin() + 1, free_slots.end(), 0);
+
+    // sprite particles are vertices, first and count words are filled by shader and stream
+    const std::array<uint32_t, 5> draw_command = std::is_same_v<P, SpriteParticle> ? std::array<uint32_t, 5> {0, 1, 0, 0, 0} : std::array<uint32_t, 5> {};
+
+    state = Buffer::builder()
+            .target(Buffer::Type::ShaderStorage)
+            .usage(Buffer::Usage::DynamicCopy)
+            .access(Buffer::MutableAccess::None)
+            .data(particles.data())
+            .size(sizeof(P) * max_count)
+            .build();
+
+    free_list = Buffer::builder()
+            .target(Buffer::Type::ShaderStorage)
+            .usage(Buffer::Usage::DynamicCopy)
+            .access(Buffer::MutableAccess::None)
+            .data(free_slots.data())
+            .size(sizeof(uint32_t) * free_slots.size())
+            .build();
+
+    draw_particles = Buffer::builder()
+            .target(std::is_same_v<P, SpriteParticle> ? Buffer::Type::Array : Buffer::Type::ShaderStorage)
+            .usage(Buffer::Usage::DynamicCopy)
+            .access(Buffer::MutableAccess::None)
+            .size(sizeof(P) * max_count)
+            .build();
+
+    command = Buffer::builder()
+            .target(Buffer::Type::IndirectDraw)
+            .usage(Buffer::Usage::DynamicCopy)
+            .access(Buffer::MutableAccess::None)
+            .data(draw_command.data())
+            .size(sizeof(uint32_t) * draw_command.size())
+            .build();
+
+    if constexpr (std::is_same_v<P, SpriteParticle>) {
+        vertex_array = std::make_unique<VertexArray>();
+        *vertex_array << std::pair<SpriteParticle, const std::shared_ptr<Buffer>&>(SpriteParticle{}, draw_particles);
+    }
+}
+
+template<typename P>
+void ParticleSimulation<P>::dispatch(ShaderProgram& program, uint32_t stage, uint32_t count) {
+    program.setUniform(STAGE, stage)
+           .setUniform(INVOCATION_COUNT, count);
+
+    program.use();
+
+    glDispatchCompute((count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    // next stage, vertex fetch and indirect draw read what this stage has written
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+}
+
+template<typename P>
+void ParticleSimulation<P>::update(ShaderProgram& program, const Emitter<P>& emitter) {
+    if (!state) {
+        initialize();
+    }
+
+    // alive count is accumulated from zero every step; instance count for meshes, vertex count for sprites
+    const uint32_t zero = 0;
+    command->bufferSubData(std::is_same_v<P, MeshParticle> ? sizeof(uint32_t) : 0, sizeof(uint32_t), &zero);
+
+    const auto emitter_rotation = emitter.getRotation() * emitter.getLocalRotation();
+
+    program.setUniform(DELTA_TIME, pending_time)
+           .setUniform(SEED, seed++)
+           .setUniform(EMITTER_POSITION, emitter.getLocalPosition() + emitter.getPosition())
+           .setUniform(EMITTER_ROTATION, glm::mat3_cast(emitter_rotation))
+           .setUniform(EMITTER_EULER, glm::eulerAngles(emitter_rotation));
+
+    visitDistributions(emitter.getModules(), [&] (ModuleType type, const auto& distribution) {
+        if (const auto range = getRange(distribution); range) {
+            const auto& uniform = RANGE_UNIFORMS.at(type);
+            program.setUniform(uniform.min, range->first)
+                   .setUniform(uniform.max, range->second);
+        }
+    });
+
+    for (const auto& module : emitter.getModules()) {
+        if (module->getType() == ModuleType::SubUV) {
+            const auto& subuv = static_cast<const SubUV<P>&>(*module); //NOLINT
+            const auto frame_size = glm::floor(subuv.getTextureSize() / subuv.getFrameCount());
+            program.setUniform(SUBUV_FACTOR, frame_size / subuv.getTextureSize())
+                   .setUniform(SUBUV_FRAME_COUNT, subuv.getFrameCount())
+                   .setUniform(SUBUV_FPS, subuv.getFPS());
+        }
+    }
+
+    Context::apply([this] (Context& ctx) {
+        auto& buffers = ctx.getIndexedBuffers();
+        state->bindBaseAs(Buffer::Type::ShaderStorage, buffers.getBindingPoint(IndexedBuffer::Type::ShaderStorage, STATE_BUFFER_NAME));
+        free_list->bindBaseAs(Buffer::Type::ShaderStorage, buffers.getBindingPoint(IndexedBuffer::Type::ShaderStorage, FREE_LIST_BUFFER_NAME));
+        draw_particles->bindBaseAs(Buffer::Type::ShaderStorage, buffers.getBindingPoint(IndexedBuffer::Type::ShaderStorage, DRAW_BUFFER_NAME));
+        command->bindBaseAs(Buffer::Type::ShaderStorage, buffers.getBindingPoint(IndexedBuffer::Type::ShaderStorage, COMMAND_BUFFER_NAME));
+    });
+
+    // particles emitted in this step are not simulated until the next one, as on CPU
+    dispatch(program, UPDATE_STAGE, max_count);
+
+    if (pending_emit != 0) {
+        dispatch(program, EMIT_STAGE, pending_emit);
+    }
+
+    pending_emit = 0;
+    pending_time = 0.0f;
+}
+
+template<typename P>
+void ParticleSimulation<P>::draw() {
+    if (!vertex_array) {
+        return;
+    }
+
+    vertex_array->bind();
+    command->bindAs(Buffer::Type::IndirectDraw);
+
+    glDrawArraysIndirect(GL_POINTS, nullptr);
+}
+
+template<typename P>
+void ParticleSimulation<P>::draw(AbstractMesh& mesh) {
+    if (!draw_particles) {
+        return;
+    }
+
+    Context::apply([this] (Context& ctx) {
+        draw_particles->bindBaseAs(Buffer::Type::ShaderStorage, ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "mesh_emitter_particles"));
+    });
+
+    mesh.draw_instanced_indirect(*command);
+}
+
+namespace Limitless::fx {
+    template class ParticleSimulation<SpriteParticle>;
+    template class ParticleSimulation<MeshParticle>;
+    template class ParticleSimulation<BeamParticle>;
+}
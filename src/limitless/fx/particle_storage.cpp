@@ -0,0 +1,126 @@
+#include <limitless/fx/particle_storage.hpp>
+
+#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/vertex_array.hpp>
+#include <limitless/fx/particle.hpp>
+
+#include <algorithm>
+
+using namespace Limitless::fx;
+using namespace Limitless;
+
+template<typename P>
+ParticleStorage<P>::ParticleStorage() noexcept = default;
+
+template<typename P>
+ParticleStorage<P>::~ParticleStorage() {
+    if (buffer && !persistent && mapped) {
+        buffer->unmapBuffer();
+    }
+}
+
+template<typename P>
+void ParticleStorage<P>::wait(Sync& fence) {
+    using namespace std::chrono_literals;
+
+    if (!fence.isAlreadyPlaced()) {
+        return;
+    }
+
+    while (fence.waitUntil(1ms) == Sync::State::Expired) {}
+
+    fence.remove();
+}
+
+template<typename P>
+void ParticleStorage<P>::allocate(size_t count) {
+    capacity = count;
+    frame = 0;
+
+    // old buffer is released by driver after pending draws are finished, so its fences are not needed
+    for (auto& fence : fences) {
+        fence.remove();
+    }
+
+    persistent = ContextInitializer::isExtensionSupported("GL_ARB_buffer_storage");
+
+    auto builder = Buffer::builder();
+    builder.target(std::is_same_v<P, MeshParticle> ? Buffer::Type::ShaderStorage : Buffer::Type::Array)
+           .data(nullptr)
+           .size(sizeof(P) * capacity * FRAME_COUNT);
+
+    if (persistent) {
+        builder.usage(Buffer::Storage::DynamicCoherentWrite)
+               .access(Buffer::ImmutableAccess::WriteCoherent);
+    } else {
+        builder.usage(Buffer::Usage::StreamDraw)
+               .access(Buffer::MutableAccess::WriteUnsync);
+    }
+
+    buffer = builder.build();
+
+    if constexpr (!std::is_same_v<P, MeshParticle>) {
+        vertex_array = std::make_unique<VertexArray>();
+        *vertex_array << std::pair<P, const std::shared_ptr<Buffer>&>(P{}, buffer);
+    }
+}
+
+template<typename P>
+void ParticleStorage<P>::begin() {
+    if (!buffer || requested > capacity) {
+        allocate(std::max({INITIAL_CAPACITY, requested, capacity * 2}));
+    } else {
+        // protects region written in previous frame until its draws are finished
+        fences[frame].place();
+        frame = (frame + 1) % FRAME_COUNT;
+        wait(fences[frame]);
+    }
+
+    used = 0;
+    requested = 0;
+
+    const auto region_size = static_cast<GLsizeiptr>(sizeof(P) * capacity);
+    if (persistent) {
+        mapped = static_cast<P*>(buffer->mapBufferRange(0, region_size * FRAME_COUNT)) + frame * capacity;
+    } else {
+        // region is guarded by fence, so it is mapped unsynchronized
+        mapped = static_cast<P*>(buffer->mapBufferRange(region_size * static_cast<GLsizeiptr>(frame), region_size));
+    }
+}
+
+template<typename P>
+typename ParticleStorage<P>::Range ParticleStorage<P>::reserve(size_t count) noexcept {
+    requested += count;
+
+    const auto fitting = std::min(count, capacity - used);
+    const Range range {mapped + used, frame * capacity + used, fitting};
+    used += fitting;
+
+    return range;
+}
+
+template<typename P>
+void ParticleStorage<P>::end() noexcept {
+    if (!persistent) {
+        buffer->unmapBuffer();
+        mapped = nullptr;
+    }
+}
+
+template<typename P>
+void ParticleStorage<P>::draw(VertexStreamDraw mode, const Range& range) const noexcept {
+    if (range.count == 0) {
+        return;
+    }
+
+    vertex_array->bind();
+
+    glDrawArrays(static_cast<GLenum>(mode), static_cast<GLint>(range.first), static_cast<GLsizei>(range.count));
+}
+
+namespace Limitless::fx {
+    template class ParticleStorage<SpriteParticle>;
+    template class ParticleStorage<MeshParticle>;
+    template class ParticleStorage<BeamParticleMapping>;
+}
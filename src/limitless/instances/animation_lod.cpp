@@ -0,0 +1,35 @@
+#include <limitless/instances/animation_lod.hpp>
+
+#include <algorithm>
+
+using namespace Limitless;
+
+AnimationLod::AnimationLod()
+    : AnimationLod {{
+        {20.0f, 2, ALL_DEPTHS},
+        {40.0f, 4, ALL_DEPTHS},
+        {80.0f, 8, 4}
+    }} {
+}
+
+AnimationLod::AnimationLod(std::vector<Level> _levels)
+    : levels {std::move(_levels)} {
+    std::sort(levels.begin(), levels.end(), [] (const auto& a, const auto& b) { return a.distance < b.distance; });
+
+    for (auto& level : levels) {
+        level.interval = std::max(level.interval, 1u);
+    }
+}
+
+AnimationLod::Level AnimationLod::select(float distance) const noexcept {
+    Level selected {0.0f, 1, ALL_DEPTHS};
+
+    for (const auto& level : levels) {
+        if (distance < level.distance) {
+            break;
+        }
+        selected = level;
+    }
+
+    return selected;
+}
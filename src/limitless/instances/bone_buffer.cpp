@@ -0,0 +1,148 @@
+#include <limitless/instances/bone_buffer.hpp>
+
+#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/core/buffer/triple_buffer.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/context.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace Limitless;
+
+BoneBuffer::Range::Range(uint32_t _count)
+    : offset {_count != 0 ? BoneBuffer::get().acquire(_count) : 0}
+    , count {_count} {
+}
+
+BoneBuffer::Range::~Range() {
+    if (count != 0) {
+        BoneBuffer::get().release(offset, count);
+    }
+}
+
+BoneBuffer::Range::Range(const Range& rhs)
+    : Range {rhs.count} {
+}
+
+BoneBuffer::Range::Range(Range&& rhs) noexcept
+    : offset {rhs.offset}
+    , count {rhs.count} {
+    rhs.count = 0;
+}
+
+BoneBuffer::Range& BoneBuffer::Range::operator=(Range&& rhs) noexcept {
+    std::swap(offset, rhs.offset);
+    std::swap(count, rhs.count);
+    return *this;
+}
+
+BoneBuffer& BoneBuffer::get() {
+    static BoneBuffer storage;
+    return storage;
+}
+
+BoneBuffer::~BoneBuffer() {
+    if (auto* ctx = Context::getCurrentContext(); ctx && ctx == owner) {
+        ctx->getIndexedBuffers().remove(BUFFER_NAME, buffer);
+    }
+}
+
+uint32_t BoneBuffer::acquire(uint32_t count) {
+    std::lock_guard lock(mutex);
+
+    const auto found = std::find_if(free_ranges.begin(), free_ranges.end(), [&] (const auto& range) {
+        return range.second == count;
+    });
+
+    if (found != free_ranges.end()) {
+        const auto offset = found->first;
+        free_ranges.erase(found);
+        return offset;
+    }
+
+    const auto offset = static_cast<uint32_t>(data.size());
+    data.resize(data.size() + count, glm::mat4(1.0f));
+    dirty = true;
+    return offset;
+}
+
+void BoneBuffer::release(uint32_t offset, uint32_t count) noexcept {
+    std::lock_guard lock(mutex);
+
+    free_ranges.emplace_back(offset, count);
+}
+
+void BoneBuffer::write(const Range& range, const glm::mat4* matrices) noexcept {
+    std::memcpy(data.data() + range.getOffset(), matrices, range.getCount() * sizeof(glm::mat4));
+    dirty.store(true, std::memory_order_relaxed);
+}
+
+bool BoneBuffer::ensureStorage(Context& ctx) {
+    const auto required = data.size() * sizeof(glm::mat4);
+
+    if (buffer && owner == &ctx && buffer->getSize() >= required) {
+        return false;
+    }
+
+    auto capacity = std::max<size_t>(INITIAL_CAPACITY, buffer && owner == &ctx ? buffer->getSize() / sizeof(glm::mat4) : 0);
+    while (capacity * sizeof(glm::mat4) < required) {
+        capacity *= 2;
+    }
+
+    if (buffer && owner == &ctx) {
+        buffer->resize(capacity * sizeof(glm::mat4));
+    } else {
+        persistent = ContextInitializer::isExtensionSupported("GL_ARB_buffer_storage");
+
+        if (persistent) {
+            auto builder = Buffer::builder()
+                    .target(Buffer::Type::ShaderStorage)
+                    .usage(Buffer::Storage::DynamicCoherentWrite)
+                    .access(Buffer::ImmutableAccess::WriteCoherent)
+                    .data(nullptr)
+                    .size(capacity * sizeof(glm::mat4));
+
+            buffer = std::make_shared<TripleBuffer>(std::array<std::shared_ptr<Buffer>, 3>{builder.build(), builder.build(), builder.build()});
+        } else {
+            buffer = Buffer::builder()
+                    .target(Buffer::Type::ShaderStorage)
+                    .usage(Buffer::Usage::DynamicDraw)
+                    .access(Buffer::MutableAccess::WriteOrphaning)
+                    .data(nullptr)
+                    .size(capacity * sizeof(glm::mat4))
+                    .build();
+        }
+
+        ctx.getIndexedBuffers().add(BUFFER_NAME, buffer);
+        owner = &ctx;
+    }
+
+    return true;
+}
+
+void BoneBuffer::upload(Context& ctx) {
+    std::lock_guard lock(mutex);
+
+    if (data.empty()) {
+        return;
+    }
+
+    const auto created = ensureStorage(ctx);
+
+    // storage is copied as a whole, current region keeps the last poses if none has changed
+    if (created || dirty.exchange(false)) {
+        if (persistent) {
+            // protects region used by previous frame and switches to the next one
+            buffer->fence();
+            buffer->waitFence();
+
+            auto* mapped = buffer->mapBufferRange(0, static_cast<GLsizeiptr>(buffer->getSize()));
+            std::memcpy(mapped, data.data(), data.size() * sizeof(glm::mat4));
+        } else {
+            buffer->mapData(data.data(), data.size() * sizeof(glm::mat4));
+        }
+        dirty = false;
+    }
+
+    buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, BUFFER_NAME));
+}
@@ -12,27 +12,26 @@ bool EffectInstance::isDone() const noexcept {
     return done;
 }
 
-void EffectInstance::updateEmitters(const Camera& camera) const noexcept {
-	// because we do not use final_matrix in emitter shaders explicitly
-	// we should decompose it to parameters
-	// and set it to emitters
-	glm::vec3 translation {0.0f};
-	glm::quat rotation {1.0f, 0.0f, 0.0f, 0.0f};
-	glm::vec3 scale {1.0f};
-	glm::vec3 skew {0.0f};
-	glm::vec4 perspective {1.0f};
-
-	glm::decompose(final_matrix, scale, rotation, translation, skew, perspective);
-	// gets inverted rotation, so we fix it
-	rotation = glm::conjugate(rotation);
-
-	for (auto& [_, emitter] : emitters) {
-		emitter->setPosition(translation);
-		emitter->setRotation(rotation);
-		//TODO
-		//emitter->setScale(scale);
-        emitter->update(camera);
-	}
+void EffectInstance::setEmittersTransform() const noexcept {
+    // because we do not use final_matrix in emitter shaders explicitly
+    // we should decompose it to parameters
+    // and set it to emitters
+    glm::vec3 translation {0.0f};
+    glm::quat rotation {1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec3 scale {1.0f};
+    glm::vec3 skew {0.0f};
+    glm::vec4 perspective {1.0f};
+
+    glm::decompose(final_matrix, scale, rotation, translation, skew, perspective);
+    // gets inverted rotation, so we fix it
+    rotation = glm::conjugate(rotation);
+
+    for (auto& [_, emitter] : emitters) {
+        emitter->setPosition(translation);
+        emitter->setRotation(rotation);
+        //TODO
+        //emitter->setScale(scale);
+    }
 }
 
 EffectInstance::EffectInstance() noexcept
@@ -59,8 +58,34 @@ std::unique_ptr<Instance> EffectInstance::clone() noexcept {
     return std::make_unique<EffectInstance>(*this);
 }
 
-void EffectInstance::update(const Camera &camera) {
+void EffectInstance::beginUpdate(const Camera& camera) {
+    // emitters get new transformation only if effect has moved, also when box was requested before update
+    updateTransform();
+    const bool has_moved = moved;
+
     Instance::update(camera);
-	updateEmitters(camera);
-	done = isDone();
+
+    if (has_moved) {
+        setEmittersTransform();
+    }
+}
+
+void EffectInstance::finishUpdate() noexcept {
+    done = isDone();
+}
+
+void EffectInstance::update(const Camera &camera) {
+    clock.tick();
+
+    update(camera, clock);
+}
+
+void EffectInstance::update(const Camera &camera, const FrameClock& frame_clock) {
+    beginUpdate(camera);
+
+    for (auto& [_, emitter] : emitters) {
+        emitter->update(camera, frame_clock);
+    }
+
+    finishUpdate();
 }
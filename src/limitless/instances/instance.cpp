@@ -1,20 +1,13 @@
 #include <limitless/instances/instance.hpp>
 #include <limitless/instances/instance_builder.hpp>
-#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/util/transform.hpp>
 
 using namespace Limitless;
 
 Instance::Instance(InstanceType _shader_type, const glm::vec3& _position) noexcept
 	: id {next_id++}
 	, shader_type {_shader_type}
-	, position {_position}
-    , instance_buffer {Buffer::builder()
-          .target(Buffer::Type::Uniform)
-          .usage(Buffer::Usage::DynamicDraw)
-          .access(Buffer::MutableAccess::WriteOrphaning)
-          .data(nullptr)
-          .size(sizeof(Data))
-          .build("model_buffer", *Context::getCurrentContext())} {
+	, position {_position} {
 }
 
 Instance::Instance(const Instance& rhs)
@@ -35,22 +28,11 @@ Instance::Instance(const Instance& rhs)
     , outlined {rhs.outlined}
     , hidden {rhs.hidden}
     , done {rhs.done}
-    , pickable {rhs.pickable}
-    , instance_buffer {Buffer::builder()
-         .target(Buffer::Type::Uniform)
-         .usage(Buffer::Usage::DynamicDraw)
-         .access(Buffer::MutableAccess::WriteOrphaning)
-         .data(nullptr)
-         .size(sizeof(Data))
-         .build("model_buffer", *Context::getCurrentContext())} {
+    , pickable {rhs.pickable} {
 }
 
 void Instance::updateModelMatrix() noexcept {
-    const auto translation_matrix = glm::translate(glm::mat4{1.0f}, position);
-    const auto rotation_matrix = glm::toMat4(rotation);
-    const auto scale_matrix = glm::scale(glm::mat4{1.0f}, scale);
-
-    model_matrix = translation_matrix * rotation_matrix * scale_matrix;
+    model_matrix = composeTRS(position, rotation, scale);
 }
 
 void Instance::updateFinalMatrix() noexcept {
@@ -59,6 +41,9 @@ void Instance::updateFinalMatrix() noexcept {
 
 void Instance::reveal() noexcept {
     hidden = false;
+    if (observer) {
+        observer->onInstanceChanged(*this);
+    }
     for (const auto& [_, attachment]: getAttachments()) {
         attachment->reveal();
     }
@@ -66,6 +51,9 @@ void Instance::reveal() noexcept {
 
 void Instance::hide() noexcept {
     hidden = true;
+    if (observer) {
+        observer->onInstanceChanged(*this);
+    }
     for (const auto& [_, attachment]: getAttachments()) {
         attachment->hide();
     }
@@ -77,6 +65,9 @@ bool Instance::isHidden() const noexcept {
 
 void Instance::kill() noexcept {
     done = true;
+    if (observer) {
+        observer->onInstanceChanged(*this);
+    }
 }
 
 bool Instance::isKilled() const noexcept {
@@ -120,54 +111,99 @@ bool Instance::isPickable() const noexcept {
 }
 
 Instance& Instance::setPosition(const glm::vec3& _position) noexcept {
-    position = _position;
+    if (position != _position) {
+        position = _position;
+        model_changed = true;
+    }
     return *this;
 }
 
 Instance& Instance::setRotation(const glm::quat& _rotation) noexcept {
-    rotation = _rotation;
+    if (rotation != _rotation) {
+        rotation = _rotation;
+        model_changed = true;
+    }
     return *this;
 }
 
 Instance& Instance::rotateBy(const glm::quat& _rotation) noexcept {
     rotation = _rotation * rotation;
+    model_changed = true;
     return *this;
 }
 
 Instance& Instance::setScale(const glm::vec3& _scale) noexcept {
-    scale = _scale;
+    if (scale != _scale) {
+        scale = _scale;
+        model_changed = true;
+    }
     return *this;
 }
 
 Instance& Instance::setTransformation(const glm::mat4& transformation) {
-	transformation_matrix = transformation;
+    if (transformation_matrix != transformation) {
+        transformation_matrix = transformation;
+        transform_changed = true;
+    }
 	return *this;
 }
 
 Instance& Instance::setParent(const glm::mat4& _parent) noexcept {
-	parent = _parent;
+    if (parent != _parent) {
+        parent = _parent;
+        transform_changed = true;
+    }
 	return *this;
 }
 
 Instance& Instance::setBoundingBox(const Box& box) noexcept {
     custom_bounding_box = box;
+    transform_changed = true;
     return *this;
 }
 
+void Instance::updateTransform() noexcept {
+    // updates current model matrices only if something has moved
+    if (model_changed) {
+        updateModelMatrix();
+        model_changed = false;
+        transform_changed = true;
+    }
+
+    if (transform_changed) {
+        updateFinalMatrix();
+        updateBoundingBox();
+        transform_changed = false;
+        moved = true;
+
+        if (observer) {
+            observer->onInstanceChanged(*this);
+        }
+    }
+}
+
+const Box& Instance::getBoundingBox() noexcept {
+    // box is computed from current matrices, so they are updated before it
+    updateTransform();
+    return bounding_box;
+}
+
 void Instance::update(const Camera &camera) {
-	// updates current model matrices
-	updateModelMatrix();
-	updateFinalMatrix();
-	updateBoundingBox();
+    updateTransform();
+
     updateInstanceBuffer();
 
 	// propagates current instance values to attachments
+	// attachments recompute their transformation only if parent matrix differs
     InstanceAttachment::setAttachmentsParent(final_matrix);
     InstanceAttachment::updateAttachments(camera);
+
+    moved = false;
 }
 
 void Instance::removeOutline() noexcept {
 	outlined = false;
+    data_changed = true;
     for (const auto& [_, attachment]: getAttachments()) {
         attachment->removeOutline();
     }
@@ -175,6 +211,7 @@ void Instance::removeOutline() noexcept {
 
 void Instance::makeOutlined() noexcept {
 	outlined = true;
+    data_changed = true;
     for (const auto& [_, attachment]: getAttachments()) {
         attachment->makeOutlined();
     }
@@ -197,25 +234,37 @@ void Instance::updateBoundingBox() noexcept {
 
 Instance &Instance::setDecalMask(uint8_t mask) noexcept {
     decal_mask = mask;
+    data_changed = true;
     return *this;
 }
 
 Instance &Instance::setOutlineColor(glm::vec3 color) noexcept {
     outline_color = color;
+    data_changed = true;
     return *this;
 }
 
+void Instance::setBoneOffset(uint32_t offset) noexcept {
+    if (bone_offset != offset) {
+        bone_offset = offset;
+        data_changed = true;
+    }
+}
+
 void Instance::updateInstanceBuffer() noexcept {
-    Data data {
+    if (!moved && !data_changed) {
+        return;
+    }
+
+    current_data = {
         final_matrix,
         glm::vec4(outline_color, 1.0f),
         static_cast<uint32_t>(id),
         outlined,
-        decal_mask
+        decal_mask,
+        bone_offset
     };
 
-    if (data != current_data) {
-        instance_buffer->mapData(&data, sizeof(Data));
-        current_data = data;
-    }
+    InstanceBuffer::get().write(slot.getIndex(), current_data);
+    data_changed = false;
 }
\ No newline at end of file
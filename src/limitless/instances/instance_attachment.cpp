@@ -32,7 +32,12 @@ InstanceAttachment& InstanceAttachment::setAttachmentsParent(const glm::mat4& pa
 }
 
 void InstanceAttachment::attach(std::shared_ptr<Instance> attachment) {
-	attachments.emplace(AttachmentID {attachment->getId(), AttachmentType::Basic}, std::move(attachment));
+    const auto id = attachment->getId();
+	const auto [it, inserted] = attachments.emplace(AttachmentID {id, AttachmentType::Basic}, std::move(attachment));
+
+    if (inserted && observer) {
+        observer->onInstanceAttached(it->second);
+    }
 }
 
 void InstanceAttachment::detach(uint64_t id) {
@@ -41,6 +46,9 @@ void InstanceAttachment::detach(uint64_t id) {
     });
 
     if (it != attachments.end()) {
+        if (observer) {
+            observer->onInstanceDetached(*it->second);
+        }
         attachments.erase(it);
     }
 }
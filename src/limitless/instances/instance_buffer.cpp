@@ -0,0 +1,165 @@
+#include <limitless/instances/instance_buffer.hpp>
+
+#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/core/buffer/triple_buffer.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/context.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+InstanceBuffer::Slot::Slot()
+    : index {InstanceBuffer::get().acquire()} {
+}
+
+InstanceBuffer::Slot::~Slot() {
+    if (index != INVALID) {
+        InstanceBuffer::get().release(index);
+    }
+}
+
+InstanceBuffer::Slot::Slot(const Slot&)
+    : index {InstanceBuffer::get().acquire()} {
+}
+
+InstanceBuffer::Slot::Slot(Slot&& rhs) noexcept
+    : index {rhs.index} {
+    rhs.index = INVALID;
+}
+
+InstanceBuffer::Slot& InstanceBuffer::Slot::operator=(Slot&& rhs) noexcept {
+    std::swap(index, rhs.index);
+    return *this;
+}
+
+InstanceBuffer& InstanceBuffer::get() {
+    static InstanceBuffer storage;
+    return storage;
+}
+
+InstanceBuffer::~InstanceBuffer() {
+    if (auto* ctx = Context::getCurrentContext(); ctx && ctx == owner) {
+        ctx->getIndexedBuffers().remove(BUFFER_NAME, buffer);
+    }
+}
+
+uint32_t InstanceBuffer::acquire() {
+    std::lock_guard lock(mutex);
+
+    if (!free_slots.empty()) {
+        const auto slot = free_slots.back();
+        free_slots.pop_back();
+        return slot;
+    }
+
+    data.emplace_back();
+    pending.emplace_back(0);
+    return static_cast<uint32_t>(data.size() - 1);
+}
+
+void InstanceBuffer::release(uint32_t slot) noexcept {
+    std::lock_guard lock(mutex);
+
+    // released slot should not be drawn with stale data
+    data[slot] = {};
+    markDirty(slot);
+
+    free_slots.emplace_back(slot);
+}
+
+void InstanceBuffer::markDirty(uint32_t slot) noexcept {
+    if (pending[slot] == 0) {
+        dirty.emplace_back(slot);
+    }
+    pending[slot] = persistent ? FRAME_COUNT : 1;
+}
+
+void InstanceBuffer::write(uint32_t slot, const InstanceData& instance_data) {
+    std::lock_guard lock(mutex);
+
+    data[slot] = instance_data;
+    markDirty(slot);
+}
+
+void InstanceBuffer::ensureStorage(Context& ctx) {
+    const auto required = data.size() * sizeof(InstanceData);
+
+    if (buffer && owner == &ctx && buffer->getSize() >= required) {
+        return;
+    }
+
+    auto capacity = std::max<size_t>(INITIAL_CAPACITY, buffer && owner == &ctx ? buffer->getSize() / sizeof(InstanceData) : 0);
+    while (capacity * sizeof(InstanceData) < required) {
+        capacity *= 2;
+    }
+
+    if (buffer && owner == &ctx) {
+        // content is lost on resize
+        buffer->resize(capacity * sizeof(InstanceData));
+    } else {
+        persistent = ContextInitializer::isExtensionSupported("GL_ARB_buffer_storage");
+
+        if (persistent) {
+            auto builder = Buffer::builder()
+                    .target(Buffer::Type::ShaderStorage)
+                    .usage(Buffer::Storage::DynamicCoherentWrite)
+                    .access(Buffer::ImmutableAccess::WriteCoherent)
+                    .data(nullptr)
+                    .size(capacity * sizeof(InstanceData));
+
+            buffer = std::make_shared<TripleBuffer>(std::array<std::shared_ptr<Buffer>, 3>{builder.build(), builder.build(), builder.build()});
+        } else {
+            buffer = Buffer::builder()
+                    .target(Buffer::Type::ShaderStorage)
+                    .usage(Buffer::Usage::DynamicDraw)
+                    .access(Buffer::MutableAccess::WriteOrphaning)
+                    .data(nullptr)
+                    .size(capacity * sizeof(InstanceData))
+                    .build();
+        }
+
+        ctx.getIndexedBuffers().add(BUFFER_NAME, buffer);
+        owner = &ctx;
+    }
+
+    // whole storage has to be rewritten
+    dirty.clear();
+    for (uint32_t slot = 0; slot < data.size(); ++slot) {
+        pending[slot] = 0;
+        markDirty(slot);
+    }
+}
+
+void InstanceBuffer::upload(Context& ctx) {
+    std::lock_guard lock(mutex);
+
+    ensureStorage(ctx);
+
+    if (persistent) {
+        // protects region used by previous frame and switches to the next one
+        buffer->fence();
+        buffer->waitFence();
+
+        auto* mapped = static_cast<InstanceData*>(buffer->mapBufferRange(0, static_cast<GLsizeiptr>(buffer->getSize())));
+
+        // every frame region gets its own copy of changed slot
+        size_t kept = 0;
+        for (const auto slot : dirty) {
+            mapped[slot] = data[slot];
+            if (--pending[slot] != 0) {
+                dirty[kept++] = slot;
+            }
+        }
+        dirty.resize(kept);
+    } else if (!dirty.empty()) {
+        // orphaning mapping invalidates whole buffer, so it is mapped at once
+        buffer->mapData(data.data(), data.size() * sizeof(InstanceData));
+
+        for (const auto slot : dirty) {
+            pending[slot] = 0;
+        }
+        dirty.clear();
+    }
+
+    buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, BUFFER_NAME));
+}
@@ -9,6 +9,10 @@
 using namespace Limitless;
 using namespace Limitless::ms;
 
+namespace {
+    const UniformName MODEL_TRANSFORM {"_model_transform"};
+}
+
 MeshInstance::MeshInstance(std::shared_ptr<AbstractMesh> mesh, const std::shared_ptr<ms::Material>& material) noexcept
     : mesh {std::move(mesh)}
     , material {std::make_shared<Material>(*material)} {
@@ -65,7 +69,7 @@ void MeshInstance::draw(Context& ctx,
     auto& shader = assets.shaders.get(pass, model, material->getShaderIndex());
 
     // updates model/material uniforms
-    shader.setUniform("_model_transform", model_matrix)
+    shader.setUniform(MODEL_TRANSFORM, model_matrix)
           .setMaterial(*material);
 
     // sets custom pass-dependent uniforms
@@ -108,7 +112,7 @@ void MeshInstance::draw_instanced(Context& ctx,
     auto& shader = assets.shaders.get(pass, model, material->getShaderIndex());
 
     // updates model/material uniforms
-    shader.setUniform("_model_transform", model_matrix)
+    shader.setUniform(MODEL_TRANSFORM, model_matrix)
             .setMaterial(*material);
 
     // sets custom pass-dependent uniforms
@@ -0,0 +1,51 @@
+#include <limitless/instances/pose_cache.hpp>
+
+#include <limitless/instances/skeletal_instance.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <limitless/camera.hpp>
+
+using namespace Limitless;
+
+void PoseCache::update(const std::vector<SkeletalInstance*>& instances, const Camera& camera, const FrameClock& clock) {
+    evaluating.clear();
+    evaluated.clear();
+    shared.clear();
+    counters = {};
+    ++frame;
+
+    for (auto* instance : instances) {
+        if (!instance->advanceAnimation(clock)) {
+            continue;
+        }
+
+        const auto level = lod.select(glm::distance(camera.getPosition(), instance->getPosition()));
+        if (!AnimationLod::isDue(level, frame, instance->getId())) {
+            // bone buffer keeps the last pose
+            ++counters.skipped;
+            continue;
+        }
+
+        const Key key {instance->getCurrentAnimation(), instance->sampleAnimationTime(SAMPLE_RATE), level.max_depth};
+        if (const auto [found, inserted] = evaluating.try_emplace(key, instance); inserted) {
+            evaluated.emplace_back(instance, level.max_depth);
+        } else {
+            shared.emplace_back(instance, found->second);
+        }
+    }
+
+    counters.evaluated = static_cast<uint32_t>(evaluated.size());
+    counters.shared = static_cast<uint32_t>(shared.size());
+
+    ThreadPool::getShared().parallelFor(evaluated.size(), 1, [&] (size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            evaluated[i].first->evaluatePose(evaluated[i].second);
+        }
+    });
+
+    // copies are cheap, so they are grouped into larger chunks
+    ThreadPool::getShared().parallelFor(shared.size(), 16, [&] (size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            shared[i].first->setPose(*shared[i].second);
+        }
+    });
+}
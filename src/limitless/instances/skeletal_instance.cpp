@@ -12,94 +12,55 @@
 
 using namespace Limitless;
 
-[[maybe_unused]] constexpr auto SKELETAL_BUFFER_NAME = "bone_buffer";
+bool SkeletalInstance::advanceAnimation(const FrameClock& frame_clock) noexcept {
+    animation_advanced = true;
 
-void SkeletalInstance::initializeBuffer() {
-    bone_buffer = Buffer::builder()
-            .target(Buffer::Type::ShaderStorage)
-            .usage(Buffer::Usage::DynamicDraw)
-            .access(Buffer::MutableAccess::WriteOrphaning)
-            .data(bone_transform.data())
-            .size(bone_transform.size() * sizeof(glm::mat4))
-            .build();
-}
-
-void SkeletalInstance::updateAnimationFrame() {
     if (!animation || paused) {
-        return;
+        return false;
     }
 
-    auto& skeletal = dynamic_cast<SkeletalModel&>(*model);
-    auto& bones = skeletal.getBones();
-    const Animation& anim = *animation;
+    animation_duration += frame_clock.getDelta();
+    animation_time = glm::mod(animation_duration.count() * animation->tps, animation->duration);
 
-    const auto current_time = std::chrono::steady_clock::now();
-    if (last_time == std::chrono::time_point<std::chrono::steady_clock>()) {
-        last_time = current_time;
+    if (baked) {
+        // shader reads bone matrices from frame row of baked texture
+        const auto& skeletal = static_cast<const SkeletalModel&>(*model); //NOLINT
+        const auto index = static_cast<size_t>(animation - skeletal.getAnimations().data());
+        setBoneOffset(BakedAnimations::FRAME_FLAG | skeletal.getBakedAnimations()->getFrame(index, animation_time, animation->tps));
+        return false;
     }
-    const auto delta_time = current_time - last_time;
-    animation_duration += delta_time;
-    last_time = current_time;
-    const auto animation_time = glm::mod(animation_duration.count() * anim.tps, anim.duration);
-
-    std::function<void(const Tree<uint32_t>&, const glm::mat4&)> node_traversal;
-    node_traversal = [&](const Tree<uint32_t>& node, const glm::mat4& parent_mat) {
-        const auto bone_indice = *node;
-        auto& bone = bones[bone_indice];
 
-        auto local_transform = [&]() -> glm::mat4 {
-            auto* anim_node = findAnimationNode(bone);
-            if (!anim_node) {
-                return bone.node_transform;
-            }
-
-            auto maybe_anim_position = anim_node->positionLerp(animation_time);
-            auto maybe_anim_rotation = anim_node->rotationLerp(animation_time);
-            auto maybe_anim_scale = anim_node->scalingLerp(animation_time);
-
-            auto position = maybe_anim_position? *maybe_anim_position : bone.position;
-            auto rotation = maybe_anim_rotation? *maybe_anim_rotation : bone.rotation;
-            auto scale = maybe_anim_scale? *maybe_anim_scale : bone.scale;
+    return true;
+}
 
-            auto translate = glm::translate(glm::mat4(1.f), position);
-            auto rotate = glm::mat4_cast(rotation);
-            auto scale_mat = glm::scale(glm::mat4(1.f), scale);
+int64_t SkeletalInstance::sampleAnimationTime(double rate) noexcept {
+    if (animation->tps <= 0.0) {
+        return 0;
+    }
 
-            return translate * rotate * scale_mat;
-        }();
+    const auto sample = static_cast<int64_t>(animation_time / animation->tps * rate);
+    animation_time = static_cast<double>(sample) / rate * animation->tps;
+    return sample;
+}
 
-        auto global_transform = parent_mat * local_transform;
+void SkeletalInstance::setPose(const SkeletalInstance& instance) noexcept {
+    bone_transform = instance.bone_transform;
 
-        if (bone.joint_index) {
-            bone_transform[*bone.joint_index] = global_transform * bone.offset_matrix;
-        }
+    BoneBuffer::get().write(bone_range, bone_transform.data());
+}
 
-        for (const auto& n : node) {
-            node_traversal(n, global_transform);
-        }
-    };
+void SkeletalInstance::evaluatePose(uint32_t max_depth) {
+    const auto& skeletal = static_cast<const SkeletalModel&>(*model); //NOLINT
 
-    try {
-        for (auto& hierarchy : skeletal.getSkeletonTrees()) {
-            node_traversal(hierarchy, glm::mat4(1.f));
-        }
-    } catch (const std::exception& e) {
-        throw std::runtime_error("Wrong TPS/duration. " + std::string(e.what()));
-    }
+    skeletal.evaluatePose(*animation, animation_time, cursors, node_transform, bone_transform, max_depth);
 
-    bone_buffer->mapData(bone_transform.data(), sizeof(glm::mat4) * bone_transform.size());
+    BoneBuffer::get().write(bone_range, bone_transform.data());
 }
 
-const AnimationNode* SkeletalInstance::findAnimationNode(const Bone& bone) const noexcept {
-    if (animation) {
-        for (auto& node : animation->nodes) {
-            if (&node.bone == &bone) {
-                return &node;
-            }
-        }
-    }
-
-    return nullptr;
+void SkeletalInstance::setAnimation(const Animation& _animation) noexcept {
+    animation = &_animation;
+    animation_duration = std::chrono::seconds(0);
+    cursors.assign(_animation.nodes.size(), KeyframeCursor {});
 }
 
 SkeletalInstance::SkeletalInstance(std::shared_ptr<AbstractModel> m, const glm::vec3& position)
@@ -113,18 +74,28 @@ SkeletalInstance::SkeletalInstance(std::shared_ptr<AbstractModel> m, const glm::
     });
 
     bone_transform.resize(skinned_bones, glm::mat4(1.0f));
-    initializeBuffer();
+    node_transform.resize(skeletal.getSkeleton().size(), glm::mat4(1.0f));
+
+    bone_range = BoneBuffer::Range {static_cast<uint32_t>(skinned_bones)};
+    setBoneOffset(bone_range.getOffset());
+    BoneBuffer::get().write(bone_range, bone_transform.data());
 }
 
 SkeletalInstance::SkeletalInstance(const SkeletalInstance& rhs) noexcept
     : ModelInstance {rhs}
     , SocketAttachment {rhs}
     , bone_transform {rhs.bone_transform}
+    , node_transform {rhs.node_transform}
+    , cursors {rhs.cursors}
+    , bone_range {rhs.bone_range}
     , animation {rhs.animation}
     , paused {rhs.paused}
-    , last_time {rhs.last_time}
-    , animation_duration {rhs.animation_duration} {
-    initializeBuffer();
+    , clock {rhs.clock}
+    , animation_duration {rhs.animation_duration}
+    , animation_time {rhs.animation_time}
+    , baked {rhs.baked} {
+    setBoneOffset(baked ? rhs.bone_offset : bone_range.getOffset());
+    BoneBuffer::get().write(bone_range, bone_transform.data());
 }
 
 
@@ -133,7 +104,19 @@ std::unique_ptr<Instance> SkeletalInstance::clone() noexcept {
 }
 
 void SkeletalInstance::update(const Camera &camera) {
-    updateAnimationFrame();
+    // attached instances are not advanced by scene, they are stepped by own clock
+    if (!animation_advanced) {
+        if (!clock) {
+            clock.emplace();
+        }
+
+        clock->tick();
+
+        if (advanceAnimation(*clock)) {
+            evaluatePose();
+        }
+    }
+    animation_advanced = false;
 
     SocketAttachment::updateSocketAttachments();
 
@@ -144,9 +127,7 @@ SkeletalInstance &SkeletalInstance::play(uint32_t index) {
     const auto& skeletal = dynamic_cast<SkeletalModel&>(*model);
     const auto& animations = skeletal.getAnimations();
 
-    animation = &animations.at(index);
-    animation_duration = std::chrono::seconds(0);
-    last_time = std::chrono::time_point<std::chrono::steady_clock>();
+    setAnimation(animations.at(index));
 
     return *this;
 }
@@ -159,9 +140,7 @@ SkeletalInstance& SkeletalInstance::play(const std::string& name) {
     if (found == animations.end()) {
         throw no_such_animation("with name " + name);
     } else {
-        animation = &(*found);
-        animation_duration = std::chrono::seconds(0);
-        last_time = std::chrono::time_point<std::chrono::steady_clock>();
+        setAnimation(*found);
     }
 
     return *this;
@@ -179,6 +158,21 @@ SkeletalInstance& SkeletalInstance::resume() noexcept {
 
 SkeletalInstance& SkeletalInstance::stop() noexcept {
     animation = nullptr;
+    setBoneOffset(bone_range.getOffset());
+    return *this;
+}
+
+SkeletalInstance& SkeletalInstance::setBaked(bool _baked) {
+    const auto& skeletal = static_cast<const SkeletalModel&>(*model); //NOLINT
+    if (_baked && !skeletal.getBakedAnimations()) {
+        throw std::runtime_error("animations of " + skeletal.getName() + " are not baked");
+    }
+
+    baked = _baked;
+    if (!baked) {
+        setBoneOffset(bone_range.getOffset());
+    }
+
     return *this;
 }
 
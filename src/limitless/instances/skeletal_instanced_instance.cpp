@@ -0,0 +1,94 @@
+#include <limitless/instances/skeletal_instanced_instance.hpp>
+
+using namespace Limitless;
+
+SkeletalInstancedInstance::SkeletalInstancedInstance()
+    : Instance {InstanceType::SkeletalInstanced, glm::vec3{0.0f}}
+    , buffer {Buffer::builder()
+        .target(Buffer::Type::ShaderStorage)
+        .usage(Buffer::Usage::DynamicDraw)
+        .access(Buffer::MutableAccess::WriteOrphaning)
+        .data(nullptr)
+        .size(sizeof(Data))
+        .build("model_buffer", *Context::getCurrentContext())} {
+}
+
+SkeletalInstancedInstance::SkeletalInstancedInstance(const SkeletalInstancedInstance& rhs)
+    : Instance(rhs)
+    , buffer {Buffer::builder()
+        .target(Buffer::Type::ShaderStorage)
+        .usage(Buffer::Usage::DynamicDraw)
+        .access(Buffer::MutableAccess::WriteOrphaning)
+        .data(nullptr)
+        .size(sizeof(Data))
+        .build("model_buffer", *Context::getCurrentContext())} {
+    for (const auto& instance : rhs.instances) {
+        instances.emplace_back(static_cast<SkeletalInstance*>(instance->clone().release())); //NOLINT
+    }
+}
+
+std::unique_ptr<Instance> SkeletalInstancedInstance::clone() noexcept {
+    return std::make_unique<SkeletalInstancedInstance>(*this);
+}
+
+void SkeletalInstancedInstance::add(const std::shared_ptr<SkeletalInstance>& instance) {
+    if (!instances.empty() && &instances[0]->getAbstractModel() != &instance->getAbstractModel()) {
+        throw std::runtime_error {"SkeletalInstancedInstance: instance of different model " + instance->getAbstractModel().getName()};
+    }
+
+    instances.emplace_back(instance);
+}
+
+void SkeletalInstancedInstance::remove(uint64_t id) {
+    auto it = std::remove_if(instances.begin(), instances.end(), [&] (auto& i) { return i->getId() == id; });
+    instances.erase(it, instances.end());
+}
+
+void SkeletalInstancedInstance::updateInstanceBuffer() {
+    const auto changed = current_instance_data.size() != visible_instances.size() ||
+        !std::equal(visible_instances.begin(), visible_instances.end(), current_instance_data.begin(), [] (const auto& instance, const auto& data) {
+            return instance->getCurrentData() == data;
+        });
+
+    if (!changed) {
+        return;
+    }
+
+    current_instance_data.clear();
+    for (const auto& instance : visible_instances) {
+        current_instance_data.emplace_back(instance->getCurrentData());
+    }
+
+    // ensure buffer size
+    const auto size = sizeof(Data) * current_instance_data.size();
+    if (size == 0) {
+        return;
+    }
+
+    if (buffer->getSize() < size) {
+        buffer->resize(size);
+    }
+
+    buffer->mapData(current_instance_data.data(), size);
+}
+
+void SkeletalInstancedInstance::update(const Camera &camera) {
+    if (instances.empty()) {
+        return;
+    }
+
+    Instance::update(camera);
+
+    // animations are already advanced by scene, so this updates only transformations and sockets
+    for (const auto& instance : instances) {
+        instance->update(camera);
+    }
+
+    updateInstanceBuffer();
+}
+
+void SkeletalInstancedInstance::setVisible(const std::vector<std::shared_ptr<SkeletalInstance>>& visible) {
+    visible_instances = visible;
+
+    updateInstanceBuffer();
+}
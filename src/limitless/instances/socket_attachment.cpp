@@ -54,8 +54,12 @@ void SocketAttachment::attachToBone(std::string bone_name, std::shared_ptr<Insta
     }
 
     auto id = instance->getId();
-    skeletal_instance.getAttachments().emplace(InstanceAttachment::AttachmentID {id, InstanceAttachment::AttachmentType::Bone}, std::move(instance));
+    const auto [it, inserted] = skeletal_instance.getAttachments().emplace(InstanceAttachment::AttachmentID {id, InstanceAttachment::AttachmentType::Bone}, std::move(instance));
     attachment_data.emplace(id, std::move(bone_name));
+
+    if (auto* observer = skeletal_instance.getObserver(); inserted && observer) {
+        observer->onInstanceAttached(it->second);
+    }
 }
 
 void SocketAttachment::detachFromBone(uint64_t id) {
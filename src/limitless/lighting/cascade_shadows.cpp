@@ -19,6 +19,12 @@
 
 using namespace Limitless;
 
+namespace {
+    const UniformName LIGHT_SPACE {"light_space"};
+    const UniformName DIR_SHADOWS {"_dir_shadows"};
+    const UniformName FAR_BOUNDS {"_far_bounds"};
+}
+
 namespace {
     constexpr auto DIRECTIONAL_CSM_BUFFER_NAME = "directional_shadows";
 }
@@ -63,6 +69,7 @@ CascadeShadows::CascadeShadows(const RendererSettings& settings)
     frustums.resize(split_count);
     far_bounds.resize(split_count);
     light_space.reserve(split_count);
+    cullings.resize(split_count);
 }
 
 void CascadeShadows::updateFrustums(Context& ctx, const Camera& camera) {
@@ -126,7 +133,7 @@ void CascadeShadows::updateFrustums(Context& ctx, const Camera& camera) {
     }
 }
 
-void CascadeShadows::updateLightMatrices(const Light& light) {
+void CascadeShadows::updateLightMatrices(const Light& light, const Box& casters) {
     // clear matrices
     light_space.clear();
 
@@ -137,6 +144,16 @@ void CascadeShadows::updateLightMatrices(const Light& light) {
     }
 
     const auto view = glm::lookAt(-light.getDirection(), { 0.0f, 0.0f, 0.0f }, up);
+
+    // the closest to the light point of all indexed casters
+    auto casters_z = std::numeric_limits<float>::lowest();
+    {
+        const auto half = glm::abs(casters.size) * 0.5f;
+        for (int j = 0; j < 8; ++j) {
+            const auto corner = casters.center + half * glm::vec3{j & 1 ? 1.0f : -1.0f, j & 2 ? 1.0f : -1.0f, j & 4 ? 1.0f : -1.0f};
+            casters_z = glm::max(casters_z, (view * glm::vec4(corner, 1.0f)).z);
+        }
+    }
     for (auto& frustum : frustums) {
         glm::vec3 max = {std::numeric_limits<float>::min(), std::numeric_limits<float>::min(), 0.0f};
         glm::vec3 min = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 0.0f};
@@ -151,8 +168,8 @@ void CascadeShadows::updateLightMatrices(const Light& light) {
             min.z = glm::min(min.z, transform.z);
         }
 
-        // TODO: make sure all relevant shadow casters are included, solve this shit, add AABB
-        max.z += 50;
+        // extends volume toward the light to include casters outside of split
+        max.z = glm::max(max.z + CASTER_DISTANCE, casters_z);
 
         const auto projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -max.z, -min.z);
         const auto mvp = projection * view;
@@ -190,7 +207,12 @@ void CascadeShadows::draw(InstanceRenderer& renderer,
                           const Assets& assets,
                           const Camera& camera) {
     updateFrustums(ctx, camera);
-    updateLightMatrices(scene.getLighting().getDirectionalLight());
+    updateLightMatrices(scene.getLighting().getDirectionalLight(), scene.getSpatialIndex().getBounds());
+
+    // each split draws only casters inside of its light volume
+    for (uint32_t i = 0; i < split_count; ++i) {
+        cullings[i].update(scene, Frustum::fromMatrix(frustums[i].crop));
+    }
 
     framebuffer->bind();
 
@@ -204,10 +226,10 @@ void CascadeShadows::draw(InstanceRenderer& renderer,
         framebuffer->clear();
 
         const auto uniform_set = [&] (ShaderProgram& shader) {
-            shader.setUniform("light_space", frustums[i].crop);
+            shader.setUniform(LIGHT_SPACE, frustums[i].crop);
         };
 
-        renderer.renderScene({ctx, assets, ShaderType::DirectionalShadow, ms::Blending::Opaque, UniformSetter{uniform_set} });
+        renderer.renderScene({ctx, assets, ShaderType::DirectionalShadow, ms::Blending::Opaque, UniformSetter{uniform_set} }, cullings[i]);
     }
 
     framebuffer->unbind();
@@ -218,7 +240,7 @@ void CascadeShadows::setUniform(ShaderProgram& shader) const {
 		light_buffer->bindBase(ctx->getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, DIRECTIONAL_CSM_BUFFER_NAME));
 	}
 
-    shader.setUniform("_dir_shadows", framebuffer->get(FramebufferAttachment::Depth).texture);
+    shader.setUniform(DIR_SHADOWS, framebuffer->get(FramebufferAttachment::Depth).texture);
 
     // TODO: ?
     glm::vec4 bounds {0.0f};
@@ -226,7 +248,7 @@ void CascadeShadows::setUniform(ShaderProgram& shader) const {
         bounds[i] = far_bounds[i];
     }
 
-    shader.setUniform("_far_bounds", bounds);
+    shader.setUniform(FAR_BOUNDS, bounds);
 }
 
 void CascadeShadows::mapData() const {
@@ -241,6 +263,7 @@ void CascadeShadows::update(const RendererSettings& settings) {
 
     frustums.resize(split_count);
     far_bounds.resize(split_count);
+    cullings.resize(split_count);
 }
 
 CascadeShadows::~CascadeShadows() {
@@ -0,0 +1,207 @@
+#include <limitless/lighting/light_clusters.hpp>
+
+#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <limitless/camera.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace Limitless;
+
+namespace {
+    constexpr size_t LIGHTS_PER_JOB = 256;
+}
+
+LightClusters::LightClusters()
+    : slices (GRID_Z)
+    , data (HEADER_SIZE + CLUSTER_COUNT * 2, 0)
+    , header {{GRID_X, GRID_Y, GRID_Z, 0}, {0.1f, 1000.0f, 0.0f, 0.0f}} {
+    buffer = Buffer::builder()
+            .target(Buffer::Type::ShaderStorage)
+            .usage(Buffer::Usage::DynamicDraw)
+            .access(Buffer::MutableAccess::WriteOrphaning)
+            .size(data.size() * sizeof(uint32_t))
+            .build(BUFFER_NAME, *Context::getCurrentContext());
+
+    // empty clusters until first update
+    upload();
+}
+
+LightClusters::~LightClusters() {
+    if (auto* ctx = Context::getCurrentContext(); ctx) {
+        ctx->getIndexedBuffers().remove(BUFFER_NAME, buffer);
+    }
+}
+
+uint32_t LightClusters::getSlice(float depth) const noexcept {
+    const auto slice = static_cast<int32_t>(glm::log(depth) * header.depth.z + header.depth.w);
+    return static_cast<uint32_t>(glm::clamp(slice, 0, static_cast<int32_t>(GRID_Z) - 1));
+}
+
+LightClusters::ClusterRange LightClusters::getRange(const glm::mat4& projection, const glm::vec3& center, float radius) const noexcept {
+    const auto near = header.depth.x;
+    const auto far = header.depth.y;
+
+    // view space looks to -z
+    const auto min_depth = -center.z - radius;
+    const auto max_depth = -center.z + radius;
+
+    if (max_depth < near || min_depth > far) {
+        return {{}, {}, true};
+    }
+
+    ClusterRange range {};
+    range.min.z = getSlice(glm::max(min_depth, near));
+    range.max.z = getSlice(glm::min(max_depth, far));
+
+    // sphere crossing near plane can cover any part of the screen
+    if (min_depth <= near) {
+        range.min.x = 0;
+        range.min.y = 0;
+        range.max.x = GRID_X - 1;
+        range.max.y = GRID_Y - 1;
+        return range;
+    }
+
+    // projected corners of box around sphere bound it on the screen
+    glm::vec2 min {std::numeric_limits<float>::max()};
+    glm::vec2 max {std::numeric_limits<float>::lowest()};
+    for (int i = 0; i < 8; ++i) {
+        const auto corner = center + radius * glm::vec3{i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f};
+        const auto clip = projection * glm::vec4{corner, 1.0f};
+        const auto ndc = glm::vec2{clip} / clip.w;
+        min = glm::min(min, ndc);
+        max = glm::max(max, ndc);
+    }
+
+    if (max.x < -1.0f || max.y < -1.0f || min.x > 1.0f || min.y > 1.0f) {
+        return {{}, {}, true};
+    }
+
+    const auto grid = glm::vec2{GRID_X, GRID_Y};
+    const auto first = glm::clamp(glm::ivec2((min * 0.5f + 0.5f) * grid), glm::ivec2{0}, glm::ivec2(grid) - 1);
+    const auto last = glm::clamp(glm::ivec2((max * 0.5f + 0.5f) * grid), glm::ivec2{0}, glm::ivec2(grid) - 1);
+
+    range.min.x = first.x;
+    range.min.y = first.y;
+    range.max.x = last.x;
+    range.max.y = last.y;
+    return range;
+}
+
+void LightClusters::buildSlice(uint32_t z) {
+    auto& slice = slices[z];
+    auto& grid = slice.grid;
+
+    // counts lights per cluster
+    grid.assign(GRID_X * GRID_Y * 2, 0);
+    for (const auto& range : ranges) {
+        if (range.empty || z < range.min.z || z > range.max.z) {
+            continue;
+        }
+
+        for (uint32_t y = range.min.y; y <= range.max.y; ++y) {
+            for (uint32_t x = range.min.x; x <= range.max.x; ++x) {
+                ++grid[(y * GRID_X + x) * 2 + 1];
+            }
+        }
+    }
+
+    // converts counts to offsets
+    uint32_t offset = 0;
+    for (uint32_t cluster = 0; cluster < GRID_X * GRID_Y; ++cluster) {
+        grid[cluster * 2] = offset;
+        offset += grid[cluster * 2 + 1];
+        grid[cluster * 2 + 1] = 0;
+    }
+
+    // fills light lists
+    slice.indices.resize(offset);
+    for (uint32_t i = 0; i < ranges.size(); ++i) {
+        const auto& range = ranges[i];
+        if (range.empty || z < range.min.z || z > range.max.z) {
+            continue;
+        }
+
+        for (uint32_t y = range.min.y; y <= range.max.y; ++y) {
+            for (uint32_t x = range.min.x; x <= range.max.x; ++x) {
+                const auto cluster = (y * GRID_X + x) * 2;
+                slice.indices[grid[cluster] + grid[cluster + 1]++] = i;
+            }
+        }
+    }
+}
+
+void LightClusters::update(const Camera& camera, const std::map<uint64_t, Light>& lights) {
+    const auto near = camera.getNear();
+    const auto far = camera.getFar();
+    const auto log_ratio = glm::log(far / near);
+
+    header.depth = {near, far, static_cast<float>(GRID_Z) / log_ratio, -static_cast<float>(GRID_Z) * glm::log(near) / log_ratio};
+
+    // light spheres in view space
+    spheres.clear();
+    spheres.reserve(lights.size());
+    for (const auto& [_, light] : lights) {
+        spheres.emplace_back(glm::vec3{camera.getView() * glm::vec4{light.getPosition(), 1.0f}}, light.getRadius());
+    }
+
+    auto& pool = ThreadPool::getShared();
+
+    ranges.resize(spheres.size());
+    pool.parallelFor(spheres.size(), LIGHTS_PER_JOB, [&] (size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ranges[i] = getRange(camera.getProjection(), glm::vec3{spheres[i]}, spheres[i].w);
+        }
+    });
+
+    // every slice owns its clusters, so slices are built in parallel
+    pool.parallelFor(GRID_Z, 1, [&] (size_t begin, size_t end) {
+        for (size_t z = begin; z < end; ++z) {
+            buildSlice(static_cast<uint32_t>(z));
+        }
+    });
+
+    // merges slices into one list, offsets are relative to the grid start
+    size_t index_count = 0;
+    for (const auto& slice : slices) {
+        index_count += slice.indices.size();
+    }
+
+    data.resize(HEADER_SIZE + CLUSTER_COUNT * 2 + index_count);
+
+    auto offset = static_cast<uint32_t>(CLUSTER_COUNT * 2);
+    auto* grid = data.data() + HEADER_SIZE;
+    auto* indices = grid + CLUSTER_COUNT * 2;
+
+    for (const auto& slice : slices) {
+        for (uint32_t cluster = 0; cluster < GRID_X * GRID_Y; ++cluster) {
+            *grid++ = slice.grid[cluster * 2] + offset;
+            *grid++ = slice.grid[cluster * 2 + 1];
+        }
+
+        indices = std::copy(slice.indices.begin(), slice.indices.end(), indices);
+        offset += static_cast<uint32_t>(slice.indices.size());
+    }
+
+    upload();
+}
+
+void LightClusters::upload() {
+    std::memcpy(data.data(), &header, sizeof(Header));
+
+    const auto size = data.size() * sizeof(uint32_t);
+    if (buffer->getSize() < size) {
+        buffer->resize(std::max(size, buffer->getSize() * 2));
+    }
+
+    buffer->mapData(data.data(), size);
+}
+
+void LightClusters::bind() const {
+    Context::apply([this] (Context& ctx) {
+        buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, BUFFER_NAME));
+    });
+}
@@ -3,10 +3,12 @@
 #include <limitless/core/buffer/buffer_builder.hpp>
 #include <limitless/lighting/light.hpp>
 #include <limitless/core/context.hpp>
+#include <algorithm>
 
 using namespace Limitless;
 
 static constexpr auto SHADER_STORAGE_NAME = "LIGHTS_BUFFER";
+static constexpr auto INITIAL_CAPACITY = 1024;
 
 float LightContainer::InternalLight::radiusToFalloff(float r) {
     return 1.0f / (r * r);
@@ -60,7 +62,7 @@ LightContainer::LightContainer() {
             .target(Buffer::Type::ShaderStorage)
             .usage(Buffer::Usage::DynamicDraw)
             .access(Buffer::MutableAccess::WriteOrphaning)
-            .size(sizeof(InternalLight) * 1024)
+            .size(sizeof(InternalLight) * INITIAL_CAPACITY)
             .build(SHADER_STORAGE_NAME, *Context::getCurrentContext());
 }
 
@@ -85,9 +87,9 @@ Light& LightContainer::add(const Light& light) {
     return lights.at(copy.getId());
 }
 
-void LightContainer::update() {
+void LightContainer::update(const Camera& camera) {
     // check if there were an update to lights
-    bool changed {};
+    bool changed = visible_lights.size() != internal_lights.size();
     for (auto& [id, light]: lights) {
         // if changed since last update
         if (light.isChanged()) {
@@ -105,10 +107,20 @@ void LightContainer::update() {
             visible_lights.emplace_back(light);
         }
 
-        buffer->mapData(visible_lights.data(), sizeof(InternalLight) * visible_lights.size());
+        const auto size = sizeof(InternalLight) * visible_lights.size();
+        if (buffer->getSize() < size) {
+            buffer->resize(std::max(size, buffer->getSize() * 2));
+        }
+
+        buffer->mapData(visible_lights.data(), size);
     }
 
+    // cluster lists refer to lights by index in visible order
+    clusters.update(camera, lights);
+
     Context::apply([this] (Context& ctx) {
         buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, SHADER_STORAGE_NAME));
     });
+
+    clusters.bind();
 }
@@ -104,8 +104,8 @@ void Lighting::updateSceneLightBuffer() {
     buffer->mapData(&light_info, sizeof(SceneLighting));
 }
 
-void Lighting::update() {
-    punctual_lights.update();
+void Lighting::update(const Camera& camera) {
+    punctual_lights.update(camera);
 
     if (isChanged() || directional_light.isChanged()) {
         updateSceneLightBuffer();
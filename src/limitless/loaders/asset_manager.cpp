@@ -1,10 +1,15 @@
 #include <limitless/loaders/asset_manager.hpp>
 
-#include <limitless/loaders/threaded_model_loader.hpp>
+#include <limitless/loaders/gltf_model_loader.hpp>
 #include <limitless/loaders/texture_loader.hpp>
 #include <limitless/loaders/material_loader.hpp>
 #include <limitless/loaders/effect_loader.hpp>
+#include <limitless/core/texture/texture_builder.hpp>
+#include <limitless/instances/effect_instance.hpp>
+#include <limitless/models/abstract_model.hpp>
+#include <limitless/ms/material.hpp>
 #include <limitless/assets.hpp>
+#include <array>
 
 using namespace Limitless;
 
@@ -18,116 +23,153 @@ fs::path Limitless::getShadersDir() {
 
 AssetManager::AssetManager(Context& _context, Assets& _assets, uint32_t pool_size)
     : pool {_context, pool_size}
+    , workers {pool_size}
     , assets {_assets} {
+    if (assets.models.contains("cube")) {
+        model_placeholder = assets.models.at("cube");
+    }
+
+    const std::array<uint8_t, 4> gray {128, 128, 128, 255};
+    texture_placeholder = Texture::builder()
+            .target(Texture::Type::Tex2D)
+            .internal_format(Texture::InternalFormat::RGBA8)
+            .size(glm::uvec2 {1})
+            .format(Texture::Format::RGBA)
+            .data_type(Texture::DataType::UnsignedByte)
+            .data(gray.data())
+            .min_filter(Texture::Filter::Nearest)
+            .mag_filter(Texture::Filter::Nearest)
+            .mipmap(false)
+            .build();
 }
 
 AssetManager::~AssetManager() {
     wait();
 }
 
-void AssetManager::loadTexture(fs::path path, const TextureLoaderFlags& flags) {
-    auto load_texture = [&, path = std::move(path), fl = flags] () {
-        TextureLoader::load(assets, path, fl);
-    };
+void AssetManager::schedule(std::function<std::function<void()>()> work) {
+    auto fence = std::make_shared<Sync>();
+
+    auto future = pool.add([work = std::move(work), fence] () {
+        auto publish = work();
+        fence->place();
+        return publish;
+    });
 
-    asset_futures.emplace_back(pool.add(std::move(load_texture)));
+    jobs.push_back({std::move(future), std::move(fence)});
 }
 
-void AssetManager::loadModel(std::string asset_name, fs::path path, const ModelLoaderFlags& flags) {
-    auto load_model = [&, name = asset_name, path = std::move(path), fl = flags] () {
-        return ThreadedModelLoader::loadModel(assets, path, fl);
-    };
+bool AssetManager::isFinished(Job& job) {
+    using namespace std::chrono_literals;
 
-    auto addition = [&, name = std::move(asset_name)] (future_model& future) {
-        assets.models.add(name, future.get()());
-    };
+    if (job.future.wait_for(0ns) != std::future_status::ready) {
+        return false;
+    }
 
-    model_futures.emplace_back(model_postproc{pool.add(std::move(load_model)), std::move(addition)});
+    // fence is not placed if work threw
+    return !job.fence->isAlreadyPlaced() || job.fence->isDone();
 }
 
-bool AssetManager::isDone() {
-    using namespace std::chrono;
-
-    for (auto it = asset_futures.begin(); it != asset_futures.end();) {
-        if (it->wait_for(0ns) == std::future_status::ready) {
-            it->get();
-            it = asset_futures.erase(it);
-        } else {
-            return false;
-        }
-    }
+AssetHandle<Texture> AssetManager::loadTexture(fs::path path, const TextureLoaderFlags& flags) {
+    return loadAsync(texture_placeholder, [&assets = assets, path = std::move(path), flags] () {
+        return TextureLoader::load(assets, path, flags);
+    }, [] (std::shared_ptr<Texture> texture) {
+        return texture;
+    });
+}
 
-    return std::all_of(model_futures.begin(), model_futures.end(), [] (auto& post) {
-        return post.future.wait_for(0ns) == std::future_status::ready;
+AssetHandle<AbstractModel> AssetManager::loadModel(std::string asset_name, fs::path path, const ModelLoaderFlags& flags) {
+    return loadAsync(model_placeholder, [&assets = assets, path = std::move(path), flags] () {
+        return GltfModelLoader::loadModel(assets, path, flags);
+    }, [&assets = assets, name = std::move(asset_name)] (std::shared_ptr<AbstractModel> model) {
+        return assets.models.emplace(name, std::move(model));
     });
 }
 
-void AssetManager::wait() {
-    for (auto& future : asset_futures) {
-        future.wait();
-        future.get();
-    }
+AssetHandle<ms::Material> AssetManager::loadMaterial(std::string asset_name, fs::path path) {
+    return loadAsync(std::shared_ptr<ms::Material> {}, [&assets = assets, path = std::move(path)] () {
+        return MaterialLoader::load(assets, path);
+    }, [&assets = assets, name = std::move(asset_name)] (std::shared_ptr<ms::Material> material) {
+        return assets.materials.emplace(name, std::move(material));
+    });
+}
 
-    for (auto& [future, addition] : model_futures) {
-        future.wait();
-        addition(future);
-    }
+AssetHandle<EffectInstance> AssetManager::loadEffect(std::string asset_name, fs::path path) {
+    return loadAsync(std::shared_ptr<EffectInstance> {}, [&assets = assets, path = std::move(path)] () {
+        return EffectLoader::load(assets, path);
+    }, [&assets = assets, name = std::move(asset_name)] (std::shared_ptr<EffectInstance> effect) {
+        return assets.effects.emplace(name, std::move(effect));
+    });
+}
 
-    asset_futures.clear();
-    model_futures.clear();
+void AssetManager::build(std::function<void()> f) {
+    schedule([f = std::move(f)] () -> std::function<void()> {
+        f();
+        return [] {};
+    });
 }
 
-void AssetManager::doDelayedJob() {
-    using namespace std::chrono;
-    for (auto it = model_futures.begin(); it != model_futures.end();) {
-        auto& [future, addition] = *it;
+void AssetManager::update(std::chrono::microseconds budget) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto spent = [&] {
+        return std::chrono::steady_clock::now() - start >= budget;
+    };
+
+    // without workers queue is drained by calling thread
+    if (workers == 0) {
+        while (pool.runPendingTask() && !spent()) {}
+    }
 
-        if (future.wait_for(0ms) == std::future_status::ready) {
-            addition(future);
-            it = model_futures.erase(it);
-        } else {
+    bool published = false;
+    for (auto it = jobs.begin(); it != jobs.end() && !(published && spent()); ) {
+        if (!isFinished(*it)) {
             ++it;
+            continue;
         }
-    }
-}
 
-void AssetManager::build(std::function<void()> f) {
-    asset_futures.emplace_back(pool.add(std::move(f)));
+        auto job = std::move(*it);
+        it = jobs.erase(it);
+        published = true;
+
+        job.future.get()();
+    }
 }
 
-void AssetManager::loadMaterial(std::string asset_name, fs::path path) {
-    auto load_material = [&, name = std::move(asset_name), path = std::move(path)] () {
-        assets.materials.add(name, MaterialLoader::load(assets, path));
-    };
+void AssetManager::wait() {
+    if (workers == 0) {
+        while (pool.runPendingTask()) {}
+    }
 
-    asset_futures.emplace_back(pool.add(std::move(load_material)));
-}
+    auto finished = std::move(jobs);
+    jobs.clear();
 
-void AssetManager::loadEffect(std::string asset_name, fs::path path) {
-    auto load_effect = [&, name = std::move(asset_name), path = std::move(path)] () {
-        assets.effects.add(name, EffectLoader::load(assets, path));
-    };
+    for (auto& job : finished) {
+        job.future.wait();
+        while (!isFinished(job)) {
+            std::this_thread::yield();
+        }
+    }
 
-    asset_futures.emplace_back(pool.add(std::move(load_effect)));
+    for (auto& job : finished) {
+        job.future.get()();
+    }
 }
 
-void AssetManager::compileShaders(Context& ctx, const RenderSettings& settings) {
-	//assets.initialize(ctx, settings);
-
+void AssetManager::compileShaders(Context& ctx, const RendererSettings& settings) {
     for (const auto& [_, material] : assets.materials) {
-        build([&, &ctx = ctx, &settings = settings, &material = material] () {
+        build([&, material = material] () {
             assets.compileMaterial(ctx, settings, material);
         });
     }
 
     for (const auto& [_, effect] : assets.effects) {
-        build([&, &ctx = ctx, &settings = settings, &effect = effect] () {
+        build([&, effect = effect] () {
             assets.compileEffect(ctx, settings, effect);
         });
     }
 
     for (const auto& [_, skybox] : assets.skyboxes) {
-        build([&, &ctx = ctx, &settings = settings, &skybox = skybox] () {
+        build([&, skybox = skybox] () {
             assets.compileSkybox(ctx, settings, skybox);
         });
     }
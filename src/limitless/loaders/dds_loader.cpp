@@ -1,9 +1,8 @@
 #include <limitless/loaders/dds_loader.hpp>
 #include <limitless/loaders/texture_loader.hpp>
-#include <limitless/core/texture/texture_builder.hpp>
+#include <limitless/util/mapped_file.hpp>
 #include <limitless/util/filesystem.hpp>
-#include <fstream>
-#include <iostream>
+#include <cstring>
 
 using namespace Limitless;
 
@@ -36,119 +35,182 @@ namespace {
         uint32_t dwReserved2[3];
     };
 
-    constexpr auto DDS_CODE = "DDS ";
-    constexpr auto DXT1_CODE = 0x31545844;
-    constexpr auto DXT3_CODE = 0x33545844;
-    constexpr auto DXT5_CODE = 0x35545844;
-    constexpr auto BC5u_CODE = 808540228;
-    constexpr auto DXT1_BLOCK_SIZE = 8;
-    constexpr auto DXT5_BLOCK_SIZE = 16;
-}
+    class DDSHEADERDXT10 {
+    public:
+        uint32_t dxgiFormat;
+        uint32_t resourceDimension;
+        uint32_t miscFlag;
+        uint32_t arraySize;
+        uint32_t miscFlags2;
+    };
 
-std::size_t DDSLoader::getDXTByteCount(glm::uvec2 size, std::size_t block_size) noexcept {
-    const auto s = (size + 3u) / 4u;
-    return s.x * s.y * block_size;
-}
+    constexpr uint32_t makeFourCC(const char (&code)[5]) noexcept {
+        return static_cast<uint32_t>(code[0]) | (static_cast<uint32_t>(code[1]) << 8u) |
+               (static_cast<uint32_t>(code[2]) << 16u) | (static_cast<uint32_t>(code[3]) << 24u);
+    }
 
-void DDSLoader::loadLevel(std::shared_ptr<Texture>& texture, std::ifstream& fs, uint32_t level, int channels) {
-    const auto s = glm::clamp(texture->getSize() >> level, 1u, std::numeric_limits<uint32_t>::max());
-    const auto byte_count = getDXTByteCount(s, channels == 3 ? DXT1_BLOCK_SIZE : DXT5_BLOCK_SIZE);
+    constexpr auto DDS_CODE = makeFourCC("DDS ");
+    constexpr auto DXT1_CODE = makeFourCC("DXT1");
+    constexpr auto DXT3_CODE = makeFourCC("DXT3");
+    constexpr auto DXT5_CODE = makeFourCC("DXT5");
+    constexpr auto ATI1_CODE = makeFourCC("ATI1");
+    constexpr auto BC4u_CODE = makeFourCC("BC4U");
+    constexpr auto BC4s_CODE = makeFourCC("BC4S");
+    constexpr auto ATI2_CODE = makeFourCC("ATI2");
+    constexpr auto BC5u_CODE = makeFourCC("BC5U");
+    constexpr auto BC5s_CODE = makeFourCC("BC5S");
+    constexpr auto DX10_CODE = makeFourCC("DX10");
+
+    constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+    constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+    constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+    constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+    enum class DXGIFormat : uint32_t {
+        BC1_UNORM = 71,
+        BC1_UNORM_SRGB = 72,
+        BC2_UNORM = 74,
+        BC2_UNORM_SRGB = 75,
+        BC3_UNORM = 77,
+        BC3_UNORM_SRGB = 78,
+        BC4_UNORM = 80,
+        BC4_SNORM = 81,
+        BC5_UNORM = 83,
+        BC5_SNORM = 84,
+        BC6H_UF16 = 95,
+        BC6H_SF16 = 96,
+        BC7_UNORM = 98,
+        BC7_UNORM_SRGB = 99
+    };
 
-    auto* data = new uint8_t[byte_count];
-    fs.read(reinterpret_cast<char*>(data), byte_count);
-    texture->compressedImage(level, static_cast<glm::uvec2>(s), data, byte_count);
-    delete[] data;
+    template<typename T>
+    T read(const std::byte* data, std::size_t size, std::size_t offset) {
+        if (offset + sizeof(T) > size) {
+            throw dds_loader_exception{"DDS file is truncated!"};
+        }
+
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+
+    Texture::InternalFormat getFormat(uint32_t fourcc, const TextureLoaderFlags& flags) {
+        const auto srgb = flags.space == TextureLoaderFlags::Space::sRGB;
+
+        switch (fourcc) {
+            case DXT1_CODE: return srgb ? Texture::InternalFormat::sRGBA_DXT1 : Texture::InternalFormat::RGBA_DXT1;
+            case DXT3_CODE: return srgb ? Texture::InternalFormat::sRGBA_DXT3 : Texture::InternalFormat::RGBA_DXT3;
+            case DXT5_CODE: return srgb ? Texture::InternalFormat::sRGBA_DXT5 : Texture::InternalFormat::RGBA_DXT5;
+            case ATI1_CODE:
+            case BC4u_CODE: return Texture::InternalFormat::R_RGTC;
+            case BC4s_CODE: return Texture::InternalFormat::R_RGTC_SNORM;
+            case ATI2_CODE:
+            case BC5u_CODE: return Texture::InternalFormat::RG_RGTC;
+            case BC5s_CODE: return Texture::InternalFormat::RG_RGTC_SNORM;
+            default:
+                throw dds_loader_exception{"Unsupported compression code " + std::to_string(fourcc)};
+        }
+    }
+
+    // UNORM color formats follow loader space, as most tools do not write SRGB ones
+    Texture::InternalFormat getFormat(DXGIFormat format, const TextureLoaderFlags& flags) {
+        const auto srgb = flags.space == TextureLoaderFlags::Space::sRGB;
+
+        switch (format) {
+            case DXGIFormat::BC1_UNORM: return srgb ? Texture::InternalFormat::sRGBA_DXT1 : Texture::InternalFormat::RGBA_DXT1;
+            case DXGIFormat::BC1_UNORM_SRGB: return Texture::InternalFormat::sRGBA_DXT1;
+            case DXGIFormat::BC2_UNORM: return srgb ? Texture::InternalFormat::sRGBA_DXT3 : Texture::InternalFormat::RGBA_DXT3;
+            case DXGIFormat::BC2_UNORM_SRGB: return Texture::InternalFormat::sRGBA_DXT3;
+            case DXGIFormat::BC3_UNORM: return srgb ? Texture::InternalFormat::sRGBA_DXT5 : Texture::InternalFormat::RGBA_DXT5;
+            case DXGIFormat::BC3_UNORM_SRGB: return Texture::InternalFormat::sRGBA_DXT5;
+            case DXGIFormat::BC4_UNORM: return Texture::InternalFormat::R_RGTC;
+            case DXGIFormat::BC4_SNORM: return Texture::InternalFormat::R_RGTC_SNORM;
+            case DXGIFormat::BC5_UNORM: return Texture::InternalFormat::RG_RGTC;
+            case DXGIFormat::BC5_SNORM: return Texture::InternalFormat::RG_RGTC_SNORM;
+            case DXGIFormat::BC6H_UF16: return Texture::InternalFormat::RGB_BC6H_UF;
+            case DXGIFormat::BC6H_SF16: return Texture::InternalFormat::RGB_BC6H_SF;
+            case DXGIFormat::BC7_UNORM: return srgb ? Texture::InternalFormat::sRGBA_BC7 : Texture::InternalFormat::RGBA_BC7;
+            case DXGIFormat::BC7_UNORM_SRGB: return Texture::InternalFormat::sRGBA_BC7;
+            default:
+                throw dds_loader_exception{"Unsupported DXGI format " + std::to_string(static_cast<uint32_t>(format))};
+        }
+    }
 }
 
-std::shared_ptr<Texture> DDSLoader::load(Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
-    auto path = convertPathSeparators(_path);
+TextureLoader::CompressedImage DDSLoader::parse(const std::byte* data, std::size_t size, const TextureLoaderFlags& flags) {
+    if (read<uint32_t>(data, size, 0) != DDS_CODE) {
+        throw dds_loader_exception{"It is not a DDS file!"};
+    }
 
-    if (assets.textures.contains(path.stem().string())) {
-        return assets.textures[path.stem().string()];
+    const auto header = read<DDSHEADER>(data, size, sizeof(uint32_t));
+    auto offset = sizeof(uint32_t) + sizeof(DDSHEADER);
+
+    if (header.dwCaps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) {
+        throw dds_loader_exception{"Only 2D DDS textures are supported!"};
     }
 
-    std::ifstream fs;
-	fs.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    TextureLoader::CompressedImage image;
 
-	try {
-		fs.open(path, std::ios::binary);
-	} catch (const std::exception& e) {
-		throw dds_loader_exception{"Cant open " + path.string()};
-	}
+    if (header.ddspf.dwFourCC == DX10_CODE) {
+        const auto dx10 = read<DDSHEADERDXT10>(data, size, offset);
+        offset += sizeof(DDSHEADERDXT10);
 
-    std::array<char, 4> code {0};
-    fs.read(code.data(), code.size());
-    if (std::string(code.data(), code.size()) != DDS_CODE) {
-        throw dds_loader_exception{"It is not a DDS file!"};
+        if (dx10.resourceDimension != DDS_DIMENSION_TEXTURE2D || (dx10.miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) || dx10.arraySize > 1) {
+            throw dds_loader_exception{"Only 2D DDS textures are supported!"};
+        }
+
+        image.format = getFormat(static_cast<DXGIFormat>(dx10.dxgiFormat), flags);
+    } else {
+        image.format = getFormat(header.ddspf.dwFourCC, flags);
     }
 
-    DDSHEADER header {};
-    fs.read(reinterpret_cast<char*>(&header), sizeof(DDSHEADER));
-
-    Texture::Builder& builder = Texture::builder().target(Texture::Type::Tex2D);
-
-    uint32_t channels {};
-    switch (header.ddspf.dwFourCC) {
-        case DXT1_CODE:
-	        flags.space == TextureLoaderFlags::Space::Linear ? builder.internal_format(
-                    Texture::InternalFormat::RGBA_DXT1) : builder.internal_format(
-                    Texture::InternalFormat::sRGBA_DXT1);
-            channels = 3;
-            break;
-	    case DXT3_CODE:
-		    flags.space == TextureLoaderFlags::Space::Linear ? builder.internal_format(
-                    Texture::InternalFormat::RGBA_DXT3) : builder.internal_format(
-                    Texture::InternalFormat::sRGBA_DXT3);
-		    channels = 4;
-		    break;
-        case DXT5_CODE:
-		    flags.space == TextureLoaderFlags::Space::Linear ? builder.internal_format(
-                    Texture::InternalFormat::RGBA_DXT5) : builder.internal_format(
-                    Texture::InternalFormat::sRGBA_DXT5);
-            channels = 4;
-            break;
-    	case BC5u_CODE:
-            builder.internal_format(Texture::InternalFormat::RG_RGTC);
-		    channels = 4;
-    		break;
-        default:
-            throw dds_loader_exception{"Unsupported compression code. Contact the admin! " + std::to_string(header.ddspf.dwFourCC)};
+    image.size = {header.dwWidth, header.dwHeight};
+    if (image.size.x == 0 || image.size.y == 0) {
+        throw dds_loader_exception{"DDS file has empty size!"};
     }
 
-	glm::uvec2 size = { header.dwWidth, header.dwHeight };
-	const auto downscale_level = static_cast<uint32_t>(flags.downscale);
-	const auto level = (downscale_level > header.dwMipMapCount - 1) ? header.dwMipMapCount - 1 : downscale_level;
-
-	if (flags.downscale != TextureLoaderFlags::DownScale::None) {
-		if (header.dwMipMapCount == 0) {
-			throw dds_loader_exception("Cant do dds texture downscaling w/o mipmaps in the file! " + path.string());
-		}
-
-		uint32_t byte_count = 0;
-		for (uint32_t i = 0; i < level; ++i) {
-			byte_count += getDXTByteCount(size, channels == 3 ? DXT1_BLOCK_SIZE : DXT5_BLOCK_SIZE);
-			size = size >> 1u;
-		}
-		fs.seekg(byte_count, std::ios_base::cur);
-	}
-    builder.size(size);
-	const auto byte_count = getDXTByteCount(size, channels == 3 ? DXT1_BLOCK_SIZE : DXT5_BLOCK_SIZE);
-	auto* data = new uint8_t[byte_count];
-	fs.read(reinterpret_cast<char*>(data), byte_count);
-    builder.compressed_data(data, byte_count);
-	TextureLoader::setTextureParameters(builder, flags);
-    builder.path(path);
-	auto texture = builder.buildMutable();
-	delete[] data;
-
-    if (flags.mipmap) {
-        const auto mipmap_count = (level == header.dwMipMapCount - 1) ? 0 : (header.dwMipMapCount - 1) - level;
-        for (uint32_t i = 0; i < mipmap_count; ++i) {
-            loadLevel(texture, fs, i + 1, channels);
+    // count is read regardless of DDSD_MIPMAPCOUNT flag, some writers do not set it
+    const auto levels = std::max(header.dwMipMapCount, 1u);
+
+    if (levels > TextureLoader::getMaxLevelCount(image.size)) {
+        throw dds_loader_exception{"DDS file has more mipmaps than its size allows!"};
+    }
+
+    for (uint32_t level = 0; level < levels; ++level) {
+        const auto level_size = glm::max(image.size >> level, glm::uvec2 {1});
+        const auto byte_count = TextureLoader::getCompressedByteCount(image.format, level_size);
+
+        if (offset + byte_count > size) {
+            throw dds_loader_exception{"DDS file is truncated!"};
         }
+
+        image.levels.push_back({data + offset, byte_count});
+        offset += byte_count;
     }
 
-    assets.textures.add(path.stem().string(), texture);
-    return texture;
+    return image;
 }
 
+std::shared_ptr<Texture> DDSLoader::load(Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(_path);
+
+    if (assets.textures.contains(path.stem().string())) {
+        return assets.textures[path.stem().string()];
+    }
+
+    std::unique_ptr<MappedFile> file;
+    try {
+        file = std::make_unique<MappedFile>(path);
+    } catch (const mapped_file_error&) {
+        throw dds_loader_exception{"Cant open " + path.string()};
+    }
+
+    auto image = parse(file->getData(), file->getSize(), flags);
+    image.path = path;
+
+    // levels are uploaded straight from the mapped file
+    auto texture = TextureLoader::build(image, flags);
+
+    // texture may be loaded by another worker meanwhile
+    return assets.textures.emplace(path.stem().string(), texture);
+}
@@ -1,6 +1,7 @@
 #include "cgltf.h"
 
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <iostream>
 #include <limitless/assets.hpp>
@@ -13,6 +14,7 @@
 #include <limitless/instances/model_instance.hpp>
 #include <limitless/instances/skeletal_instance.hpp>
 #include <limitless/loaders/gltf_model_loader.hpp>
+#include <limitless/loaders/model_cache.hpp>
 #include <limitless/models/abstract_mesh.hpp>
 #include <limitless/models/abstract_model.hpp>
 #include <limitless/models/bones.hpp>
@@ -20,11 +22,16 @@
 #include <limitless/models/mesh.hpp>
 #include <limitless/models/model.hpp>
 #include <limitless/models/skeletal_model.hpp>
+#include <limitless/loaders/texture_loader.hpp>
 #include <limitless/ms/material_builder.hpp>
 #include <limitless/ms/property.hpp>
 #include <limitless/renderer/shader_type.hpp>
 #include <limitless/renderer/renderer.hpp>
 #include <limitless/scene.hpp>
+#include <limitless/util/tangent_space.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <unordered_map>
+#include <exception>
 #include <memory>
 #include <cstring>
 #include <string>
@@ -240,254 +247,329 @@ static std::string generateMeshName(const std::string& model_name, size_t mesh_i
 	return model_name + "_mesh" + std::to_string(mesh_index);
 }
 
-// TODO: return std::vector of mesh + material.
-// Note that material pointer can be empty if mesh does not have material.
-static std::pair<std::vector<std::shared_ptr<AbstractMesh>>, std::vector<std::shared_ptr<ms::Material>>>
-loadMeshes(
-	const cgltf_node& node,
-	const cgltf_mesh& mesh,
+// CPU side of primitive, it does not touch GL, so primitives are converted in parallel.
+struct PrimitiveData {
+	std::string name;
+	std::vector<VertexNormalTangent> vertices;
+	std::vector<GLuint> indices;
+	std::vector<VertexBoneWeight> bone_weights;
+	bool skinned {};
+	const cgltf_material* material {};
+};
+
+// Tangents are generated from UVs, vertices shared by triangles take the last one.
+static void generateTangents(std::vector<VertexNormalTangent>& vertices, const std::vector<GLuint>& indices) {
+	calculateTangentSpaceTriangle(vertices, indices);
+
+	// degenerate UVs produce infinite tangents
+	for (auto& vertex : vertices) {
+		const auto& tangent = vertex.tangent;
+		if (!std::isfinite(tangent.x) || !std::isfinite(tangent.y) || !std::isfinite(tangent.z) || tangent == glm::vec3 {0.0f}) {
+			vertex.tangent = glm::vec3 {0.0f, 1.0f, 0.0f};
+		} else {
+			vertex.tangent = glm::normalize(vertex.tangent);
+		}
+	}
+}
+
+static PrimitiveData convertPrimitive(
+	const cgltf_primitive& primitive,
+	const glm::mat4& mesh_matrix,
 	const cgltf_skin* skin,
-	const std::string& model_name,
-	size_t mesh_index,
-	const std::vector<std::shared_ptr<ms::Material>>& materials,
-	const cgltf_data& data,
-    const ModelLoaderFlags& flags
+	std::string mesh_name,
+	const ModelLoaderFlags& flags
 ) {
-	auto base_mesh_name =
-		std::string(mesh.name ? mesh.name : generateMeshName(model_name, mesh_index));
-	std::vector<std::shared_ptr<AbstractMesh>> meshes;
-	std::vector<std::shared_ptr<ms::Material>> mesh_materials;
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec4> tangents;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> uvs;
+	std::vector<GLuint> indices;
+	std::vector<VertexNormalTangent> vertices;
+	std::vector<std::array<GLuint, 4>> bone_indices;
+	std::vector<std::array<float, 4>> bone_weights;
+
+	if (primitive.type != cgltf_primitive_type_triangles) {
+		throw ModelLoadError {"non-triangle primitives are not supported yet"};
+	}
 
-	auto select_mesh_material = [&](const cgltf_primitive& primitive) -> std::shared_ptr<ms::Material> {
-		if (!primitive.material) {
-			return {nullptr};
+	if (primitive.indices) {
+		if (primitive.indices->count % 3 != 0) {
+			throw ModelLoadError {"triangle indices count is not divisible by 3"};
 		}
-		return materials.at(cgltf_material_index(&data, primitive.material));
-	};
-
-	auto mesh_matrix = getNodeMatrix(node);
-
-	for (cgltf_size i = 0, n = mesh.primitives_count; i < n; ++i) {
-		auto mesh_name = base_mesh_name + (n == 1 ? std::string() : std::to_string(i));
-		std::vector<glm::vec3> positions;
-		std::vector<glm::vec4> tangents;
-		std::vector<glm::vec3> normals;
-		std::vector<glm::vec2> uvs;
-		std::vector<GLuint> indices;
-		std::vector<VertexNormalTangent> vertices;
-		std::vector<std::array<GLuint, 4>> bone_indices;
-		std::vector<std::array<float, 4>> bone_weights;
-
-		const cgltf_primitive& primitive = mesh.primitives[i];
 
-		if (primitive.type != cgltf_primitive_type_triangles) {
-			throw ModelLoadError {"non-triangle primitives are not supported yet"};
+		switch (primitive.indices->component_type) {
+		case cgltf_component_type_r_32u:
+			indices = copyFromAccessor<GLuint>(*primitive.indices);
+			break;
+		case cgltf_component_type_r_16u: {
+			auto trash_indices = copyFromAccessor<uint16_t>(*primitive.indices);
+			indices.reserve(trash_indices.size());
+			for (auto trash_indice : trash_indices) {
+				indices.emplace_back(static_cast<GLuint>(trash_indice));
+			}
+			break;
 		}
-
-		if (primitive.indices) {
-			if (primitive.indices->count % 3 != 0) {
-				throw ModelLoadError {"triangle indices count is not divisible by 3"};
+		case cgltf_component_type_r_8u: {
+			auto trash_indices = copyFromAccessor<uint8_t>(*primitive.indices);
+			indices.reserve(trash_indices.size());
+			for (auto trash_indice : trash_indices) {
+				indices.emplace_back(static_cast<GLuint>(trash_indice));
 			}
+			break;
+		}
+		case cgltf_component_type_invalid:
+		case cgltf_component_type_r_8:
+		case cgltf_component_type_r_16:
+		case cgltf_component_type_r_32f:
+		case cgltf_component_type_max_enum:
+			throw ModelLoadError {"invalid indice component type"};
+		}
+	} else {
+		// has no indices.
+		throw ModelLoadError {"no indices in model"};
+	}
 
-			switch (primitive.indices->component_type) {
-			case cgltf_component_type_r_32u:
-				indices = copyFromAccessor<GLuint>(*primitive.indices);
-				break;
-			case cgltf_component_type_r_16u: {
-				auto trash_indices = copyFromAccessor<uint16_t>(*primitive.indices);
-				for (auto trash_indice : trash_indices) {
-					indices.emplace_back(static_cast<GLuint>(trash_indice));
-				}
-				break;
+	for (cgltf_size j = 0; j < primitive.attributes_count; ++j) {
+		const cgltf_attribute& attribute = primitive.attributes[j];
+
+		switch (attribute.type) {
+		case cgltf_attribute_type_tangent:
+			tangents = copyFromAccessor<glm::vec4>(*attribute.data);
+			break;
+		case cgltf_attribute_type_normal:
+			normals = copyFromAccessor<glm::vec3>(*attribute.data);
+			break;
+		case cgltf_attribute_type_position:
+			positions = copyFromAccessor<glm::vec3>(*attribute.data);
+			break;
+		case cgltf_attribute_type_texcoord:
+			// TODO: load other texture coords.
+			if (attribute.index == 0) {
+				uvs = copyFromAccessor<glm::vec2>(*attribute.data);
+			} else {
+				std::cerr << "model has multiple UVs" << std::endl;
 			}
-			case cgltf_component_type_r_8u: {
-				auto trash_indices = copyFromAccessor<uint8_t>(*primitive.indices);
-				for (auto trash_indice : trash_indices) {
-					indices.emplace_back(static_cast<GLuint>(trash_indice));
+			break;
+		case cgltf_attribute_type_joints:
+			// TODO: handle host big endianess, as gltf data is little
+			// endian.
+			// TODO: make this more efficient by promoting in
+			// copyFromAccessor.
+			if (attribute.data->component_type == cgltf_component_type_r_16u) {
+				auto loaded_bone_indices =
+					copyFromAccessor<std::array<unsigned short, 4>>(*attribute.data);
+				for (auto& [u1, u2, u3, u4] : loaded_bone_indices) {
+					bone_indices.emplace_back(std::array<GLuint, 4> {u1, u2, u3, u4});
 				}
-				break;
-			}
-			case cgltf_component_type_invalid:
-			case cgltf_component_type_r_8:
-			case cgltf_component_type_r_16:
-			case cgltf_component_type_r_32f:
-			case cgltf_component_type_max_enum:
-				throw ModelLoadError {"invalid indice component type"};
+			} else if (attribute.data->component_type == cgltf_component_type_r_8u) {
+				auto loaded_bone_indices =
+					copyFromAccessor<std::array<unsigned char, 4>>(*attribute.data);
+				for (auto& [u1, u2, u3, u4] : loaded_bone_indices) {
+					bone_indices.emplace_back(std::array<GLuint, 4> {u1, u2, u3, u4});
+				}
+			} else {
+				throw ModelLoadError {
+					"unsupported accessor type "
+					+ std::to_string(attribute.data->component_type) + " for bone joint IDs"};
 			}
-		} else {
-			// has no indices.
-			throw ModelLoadError {"no indices in model"};
-		}
 
-		for (cgltf_size j = 0; j < primitive.attributes_count; ++j) {
-			const cgltf_attribute& attribute = primitive.attributes[j];
-
-			switch (attribute.type) {
-			case cgltf_attribute_type_tangent:
-				tangents = copyFromAccessor<glm::vec4>(*attribute.data);
-				break;
-			case cgltf_attribute_type_normal:
-				normals = copyFromAccessor<glm::vec3>(*attribute.data);
-				break;
-			case cgltf_attribute_type_position:
-				positions = copyFromAccessor<glm::vec3>(*attribute.data);
-				break;
-			case cgltf_attribute_type_texcoord:
-				// TODO: load other texture coords.
-				if (attribute.index == 0) {
-					uvs = copyFromAccessor<glm::vec2>(*attribute.data);
-				} else {
-					std::cerr << "model has multiple UVs" << std::endl;
-				}
-				break;
-			case cgltf_attribute_type_joints:
-				// TODO: handle host big endianess, as gltf data is little
-				// endian.
-				// TODO: make this more efficient by promoting in
-				// copyFromAccessor.
-				if (attribute.data->component_type == cgltf_component_type_r_16u) {
-					auto loaded_bone_indices =
-						copyFromAccessor<std::array<unsigned short, 4>>(*attribute.data);
-					for (auto& [u1, u2, u3, u4] : loaded_bone_indices) {
-						bone_indices.emplace_back(std::array<GLuint, 4> {u1, u2, u3, u4});
-					}
-				} else if (attribute.data->component_type == cgltf_component_type_r_8u) {
-					auto loaded_bone_indices =
-						copyFromAccessor<std::array<unsigned char, 4>>(*attribute.data);
-					for (auto& [u1, u2, u3, u4] : loaded_bone_indices) {
-						bone_indices.emplace_back(std::array<GLuint, 4> {u1, u2, u3, u4});
-					}
-				} else {
-					throw "unsupported accessor type "
-						+ std::to_string(attribute.data->component_type) + " for bone joint IDs";
-				}
+			break;
 
-				break;
-
-			case cgltf_attribute_type_weights:
-				if (attribute.data->component_type == cgltf_component_type_r_16u) {
-					auto loaded_bone_weights =
-						copyFromAccessor<std::array<unsigned short, 4>>(*attribute.data);
-
-					for (auto& [u1, u2, u3, u4] : loaded_bone_weights) {
-						bone_weights.emplace_back(std::array<float, 4> {
-							u1 / 65535.f, u2 / 65535.f, u3 / 65535.f, u4 / 65535.f});
-					}
-				} else if (attribute.data->component_type == cgltf_component_type_r_8u) {
-					auto loaded_bone_weights =
-						copyFromAccessor<std::array<unsigned char, 4>>(*attribute.data);
-					for (auto& [u1, u2, u3, u4] : loaded_bone_weights) {
-						bone_weights.emplace_back(std::array<float, 4> {
-							u1 / 255.f, u2 / 255.f, u3 / 255.f, u4 / 255.f});
-					}
-				} else if (attribute.data->component_type == cgltf_component_type_r_32f) {
-					bone_weights = copyFromAccessor<std::array<float, 4>>(*attribute.data);
-				} else {
-					throw ModelLoadError {
-						"unsupported accessor type "
-						+ std::to_string(attribute.data->component_type) + " for bone weights"};
+		case cgltf_attribute_type_weights:
+			if (attribute.data->component_type == cgltf_component_type_r_16u) {
+				auto loaded_bone_weights =
+					copyFromAccessor<std::array<unsigned short, 4>>(*attribute.data);
+
+				for (auto& [u1, u2, u3, u4] : loaded_bone_weights) {
+					bone_weights.emplace_back(std::array<float, 4> {
+						u1 / 65535.f, u2 / 65535.f, u3 / 65535.f, u4 / 65535.f});
 				}
-				break;
-            case cgltf_attribute_type_color: {
-//                copyFromAccessor<glm::vec4>(*attribute.data);
-                break;
-            }
-			default:
-				throw ModelLoadError {"unsupported attribute type " + std::to_string(attribute.type)};
-				break;
+			} else if (attribute.data->component_type == cgltf_component_type_r_8u) {
+				auto loaded_bone_weights =
+					copyFromAccessor<std::array<unsigned char, 4>>(*attribute.data);
+				for (auto& [u1, u2, u3, u4] : loaded_bone_weights) {
+					bone_weights.emplace_back(std::array<float, 4> {
+						u1 / 255.f, u2 / 255.f, u3 / 255.f, u4 / 255.f});
+				}
+			} else if (attribute.data->component_type == cgltf_component_type_r_32f) {
+				bone_weights = copyFromAccessor<std::array<float, 4>>(*attribute.data);
+			} else {
+				throw ModelLoadError {
+					"unsupported accessor type "
+					+ std::to_string(attribute.data->component_type) + " for bone weights"};
 			}
+			break;
+        case cgltf_attribute_type_color: {
+//                copyFromAccessor<glm::vec4>(*attribute.data);
+            break;
+        }
+		default:
+			throw ModelLoadError {"unsupported attribute type " + std::to_string(attribute.type)};
+			break;
 		}
+	}
 
-		if (normals.empty()) {
-			// model has no normals, generating dummy ones.
-			normals = std::vector<glm::vec3>(positions.size(), glm::vec3 {0.0f, 1.0f, 0.0f});
-		}
+	if (normals.empty()) {
+		// model has no normals, generating dummy ones.
+		normals = std::vector<glm::vec3>(positions.size(), glm::vec3 {0.0f, 1.0f, 0.0f});
+	}
 
-		if (tangents.empty()) {
-			// model has no tangents, generating dummy ones.
-			// TODO: calculate?
-			tangents = std::vector<glm::vec4>(positions.size(), glm::vec4 {0.0f, 1.0f, 0.0f, 0.0f});
-		}
+	// tangents are generated after vertices are assembled if model has UVs.
+	const bool generate_tangents = tangents.empty() && !uvs.empty();
+
+	if (tangents.empty()) {
+		tangents = std::vector<glm::vec4>(positions.size(), glm::vec4 {0.0f, 1.0f, 0.0f, 0.0f});
+	}
+
+	if (uvs.empty()) {
+		uvs = std::vector<glm::vec2>(positions.size(), glm::vec2 {0.0f, 0.0f});
+	}
+
+	if (positions.size() != normals.size() || positions.size() != tangents.size()
+	    || positions.size() != uvs.size()) {
+		throw ModelLoadError {
+			"mismatching count of vertex attributes: " + std::to_string(positions.size())
+			+ " positions, " + std::to_string(normals.size()) + " normals, "
+			+ std::to_string(tangents.size()) + " tangents, " + std::to_string(uvs.size())
+			+ " and UVs"};
+	}
 
-		if (uvs.empty()) {
-			uvs = std::vector<glm::vec2>(positions.size(), glm::vec2 {0.0f, 0.0f});
+	for (auto indice : indices) {
+		if (indice >= positions.size()) {
+			throw ModelLoadError {"indice " + std::to_string(indice) + " is out of vertices range"};
 		}
+	}
 
-		if (positions.size() != normals.size() || positions.size() != tangents.size()
-		    || positions.size() != uvs.size()) {
+	vertices.reserve(positions.size());
+	for (size_t i = 0; i < positions.size(); ++i) {
+        auto uv = flags.isPresent(Limitless::ModelLoaderOption::FlipUV) ? uvs[i] : glm::vec2(uvs[i].x, 1.0 - uvs[i].y);
+
+		vertices.emplace_back(VertexNormalTangent {
+			positions[i],
+			normals[i],
+			glm::vec3 {tangents[i]}, // TODO: handle tangent basis handedness in W.
+            // gltf 2.0 spec: uv origin in top left corner
+            // OpenGL uv origin in bottom left
+			uv});
+	}
+
+	if (generate_tangents) {
+		generateTangents(vertices, indices);
+	}
+
+	PrimitiveData data;
+	data.name = std::move(mesh_name);
+	data.material = primitive.material;
+
+	if (!skin) {
+		// plain mesh.
+
+		// move all vertices from mesh space into model space.
+		//　TODO: do we have to rotate normals here?
+		for (auto& vertice : vertices) {
+			auto model_position = mesh_matrix * glm::vec4(vertice.position, 1.f);
+			vertice.position = glm::vec3(model_position.x, model_position.y, model_position.z);
+		}
+	} else {
+		// skeletal mesh.
+		if (positions.size() != bone_weights.size()
+		    || positions.size() != bone_indices.size()) {
 			throw ModelLoadError {
-				"mismatching count of vertex attributes: " + std::to_string(positions.size())
-				+ " positions, " + std::to_string(normals.size()) + " normals, "
-				+ std::to_string(tangents.size()) + " tangents, " + std::to_string(uvs.size())
-				+ " and UVs"};
+				"mismatching count of vertex bone attributes: "
+				+ std::to_string(positions.size()) + " positions, "
+				+ std::to_string(bone_weights.size()) + " bone weights,"
+				+ std::to_string(bone_indices.size()) + " bone indices"};
 		}
 
-
-		vertices.reserve(positions.size());
+		data.bone_weights.reserve(positions.size());
 		for (size_t i = 0; i < positions.size(); ++i) {
-            auto uv = flags.isPresent(Limitless::ModelLoaderOption::FlipUV) ? uvs[i] : glm::vec2(uvs[i].x, 1.0 - uvs[i].y);
-
-			vertices.emplace_back(VertexNormalTangent {
-				positions[i],
-				normals[i],
-				glm::vec3 {tangents[i]}, // TODO: handle tangent basis handedness in W.
-                // gltf 2.0 spec: uv origin in top left corner
-                // OpenGL uv origin in bottom left
-				uv});
+			data.bone_weights.emplace_back(VertexBoneWeight {bone_indices[i], bone_weights[i]});
 		}
+		data.skinned = true;
+	}
 
-		if (!skin) {
-			// plain mesh.
+	data.vertices = std::move(vertices);
+	data.indices = std::move(indices);
 
-			// move all vertices from mesh space into model space.
-			//　TODO: do we have to rotate normals here?
-			for (auto& vertice : vertices) {
-				auto model_position = mesh_matrix * glm::vec4(vertice.position, 1.f);
-				vertice.position = glm::vec3(model_position.x, model_position.y, model_position.z);
-			}
+	return data;
+}
 
-			auto stream = std::make_unique<IndexedVertexStream<VertexNormalTangent>>(
-				std::move(vertices),
-				std::move(indices),
-				VertexStreamUsage::Static,
-				VertexStreamDraw::Triangles
-			);
+// Primitives of all nodes in model mesh order, converted later on thread pool.
+struct PrimitiveTask {
+	const cgltf_primitive* primitive;
+	const cgltf_skin* skin;
+	glm::mat4 mesh_matrix;
+	std::string mesh_name;
+};
+
+static std::vector<PrimitiveTask> collectPrimitives(const cgltf_data& src, bool skeletal, const std::string& model_name) {
+	std::vector<PrimitiveTask> tasks;
+
+	for (size_t i = 0; i < src.nodes_count; ++i) {
+		const cgltf_node& node = src.nodes[i];
 
-			auto result = std::make_shared<Mesh>(std::move(stream), mesh_name + std::to_string(i));
+		if (!node.mesh) {
+			continue;
+		}
 
-			meshes.emplace_back(std::move(result));
-			mesh_materials.emplace_back(select_mesh_material(primitive));
+		const cgltf_mesh& mesh = *node.mesh;
+		const auto base_mesh_name =
+			std::string(mesh.name ? mesh.name : generateMeshName(model_name, tasks.size()));
+		const auto mesh_matrix = getNodeMatrix(node);
 
-		} else {
-			// skeletal mesh.
-			std::vector<VertexBoneWeight> vertex_bone_weights;
-			if (positions.size() != bone_weights.size()
-			    || positions.size() != bone_indices.size()) {
-				throw "mismatching count of vertex bone attributes: "
-					+ std::to_string(positions.size()) + " positions, "
-					+ std::to_string(bone_weights.size()) + " bone weights,"
-					+ std::to_string(bone_indices.size()) + " bone indices";
-			}
+		for (cgltf_size j = 0, n = mesh.primitives_count; j < n; ++j) {
+			auto mesh_name = base_mesh_name + (n == 1 ? std::string() : std::to_string(j));
 
-			vertex_bone_weights.reserve(positions.size());
-			for (size_t i = 0; i < positions.size(); ++i) {
-				vertex_bone_weights.emplace_back(VertexBoneWeight {bone_indices[i], bone_weights[i]}
-				);
-			}
+			tasks.push_back({
+				&mesh.primitives[j],
+				skeletal ? node.skin : nullptr,
+				mesh_matrix,
+				mesh_name + std::to_string(j)
+			});
+		}
+	}
+
+	return tasks;
+}
+
+// Creates GL side of converted primitives, must be called on context thread.
+// Note that material pointer can be empty if mesh does not have material.
+static std::pair<std::vector<std::shared_ptr<AbstractMesh>>, std::vector<std::shared_ptr<ms::Material>>>
+loadMeshes(
+	std::vector<PrimitiveData>& primitives,
+	const std::vector<std::shared_ptr<ms::Material>>& materials,
+	const cgltf_data& data
+) {
+	std::vector<std::shared_ptr<AbstractMesh>> meshes;
+	std::vector<std::shared_ptr<ms::Material>> mesh_materials;
+
+	meshes.reserve(primitives.size());
+	mesh_materials.reserve(primitives.size());
 
-			auto stream = std::make_unique<SkinnedVertexStream<VertexNormalTangent>>(
-				std::move(vertices),
-				std::move(indices),
-				std::move(vertex_bone_weights),
+	for (auto& primitive : primitives) {
+		std::unique_ptr<AbstractVertexStream> stream;
+
+		if (primitive.skinned) {
+			stream = std::make_unique<SkinnedVertexStream<VertexNormalTangent>>(
+				std::move(primitive.vertices),
+				std::move(primitive.indices),
+				std::move(primitive.bone_weights),
+				VertexStreamUsage::Static,
+				VertexStreamDraw::Triangles
+			);
+		} else {
+			stream = std::make_unique<IndexedVertexStream<VertexNormalTangent>>(
+				std::move(primitive.vertices),
+				std::move(primitive.indices),
 				VertexStreamUsage::Static,
 				VertexStreamDraw::Triangles
 			);
-
-			auto result = std::make_shared<Mesh>(std::move(stream), mesh_name + std::to_string(i));
-
-			meshes.emplace_back(std::move(result));
-			mesh_materials.emplace_back(select_mesh_material(primitive));
 		}
+
+		meshes.emplace_back(std::make_shared<Mesh>(std::move(stream), std::move(primitive.name)));
+		mesh_materials.emplace_back(primitive.material
+			? materials.at(cgltf_material_index(&data, primitive.material))
+			: nullptr);
 	}
 
 	return {meshes, mesh_materials};
@@ -657,6 +739,138 @@ static std::string generateMaterialName(const std::string& model_name, size_t ma
 	return model_name + "_material" + std::to_string(material_index);
 }
 
+static std::string getMaterialName(const std::string& model_name, const cgltf_material& material, size_t material_index) {
+	return model_name + (material.name
+		? std::string(material.name)
+		: generateMaterialName(model_name, material_index));
+}
+
+static InstanceTypes getInstanceTypes(bool skeletal, const ModelLoaderFlags& flags) {
+	InstanceTypes instance_types = flags.additional_instance_types;
+
+	if (skeletal) {
+		instance_types.emplace(InstanceType::Skeletal);
+		// instanced skeletal models are drawn by SkeletalInstancedInstance
+		if (instance_types.erase(InstanceType::Instanced) != 0) {
+			instance_types.emplace(InstanceType::SkeletalInstanced);
+		}
+	} else {
+		instance_types.emplace(InstanceType::Model);
+	}
+
+	return instance_types;
+}
+
+static std::vector<uint8_t> bytesFromBase64(const char* cstr) {
+	auto decode_base64_char = [](char c) -> uint8_t {
+		if (c >= 'A' && c <= 'Z') return c - 'A';
+		if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+		if (c >= '0' && c <= '9') return c - '0' + 52;
+		if (c == '+') return 62;
+		if (c == '/') return 63;
+		if (c == '=') return 64;
+		throw ModelLoadError(std::string("Invalid base64 character ") + c + " aka " + std::to_string(static_cast<int>(c)));
+	};
+
+	std::vector<uint8_t> output;
+
+	while (*cstr) {
+		uint8_t sextet_a = *cstr ? decode_base64_char(*cstr++) : 0;
+		uint8_t sextet_b = *cstr ? decode_base64_char(*cstr++) : 0;
+		uint8_t sextet_c = *cstr ? decode_base64_char(*cstr++) : 0;
+		uint8_t sextet_d = *cstr ? decode_base64_char(*cstr++) : 0;
+
+		uint32_t triple = (static_cast<uint32_t>(sextet_a) << 18) |
+		                  (static_cast<uint32_t>(sextet_b) << 12) |
+		                  (static_cast<uint32_t>(sextet_c) << 6) |
+		                  static_cast<uint32_t>(sextet_d);
+
+		if (sextet_c == 64) {
+			output.push_back(static_cast<uint8_t>((triple >> 16) & 0xFF));
+		} else if (sextet_d == 64) {
+			output.push_back(static_cast<uint8_t>((triple >> 16) & 0xFF));
+			output.push_back(static_cast<uint8_t>((triple >> 8) & 0xFF));
+		} else {
+			output.push_back(static_cast<uint8_t>((triple >> 16) & 0xFF));
+			output.push_back(static_cast<uint8_t>((triple >> 8) & 0xFF));
+			output.push_back(static_cast<uint8_t>(triple & 0xFF));
+		}
+	}
+
+	return output;
+}
+
+static bool isDataUri(const char* uri) {
+	return uri && strncmp(uri, "data:", 5) == 0;
+}
+
+// Decodes image embedded into buffer or data uri, or referenced by file uri; does not touch GL.
+static TextureLoader::Image decodeImage(const cgltf_image& img, const fs::path& base_path) {
+	const auto name = std::string(img.name ? img.name : (img.uri && !isDataUri(img.uri) ? img.uri : "embedded image"));
+
+	if (img.buffer_view) {
+		const auto& view = *img.buffer_view;
+		if (!view.buffer || !view.buffer->data) {
+			throw ModelLoadError {"image " + name + " buffer is not loaded"};
+		}
+
+		const auto* bytes = static_cast<const uint8_t*>(view.buffer->data) + view.offset;
+		return TextureLoader::decode(name, bytes, view.size);
+	}
+
+	if (!img.uri) {
+		throw ModelLoadError {"image " + name + " has neither uri nor buffer view"};
+	}
+
+	if (isDataUri(img.uri)) {
+		const char* comma = strchr(img.uri, ',');
+
+		if (comma && comma - img.uri >= 7 && strncmp(comma - 7, ";base64", 7) == 0) {
+			auto buffer = bytesFromBase64(comma + 1);
+			return TextureLoader::decode(name, buffer.data(), buffer.size());
+		} else {
+			throw ModelLoadError {"unknown data uri"};
+		}
+	}
+
+	return TextureLoader::decode(base_path / fs::path(img.uri));
+}
+
+// Images decoded ahead of material loading, texture origin is the only decoding flag and it is the same for all of them.
+using DecodedImages = std::unordered_map<const cgltf_image*, TextureLoader::Image>;
+
+// Images of textures that materials load, except files that are already loaded or handled by other loaders.
+static std::vector<const cgltf_image*> collectImages(Assets& assets, const fs::path& base_path, const cgltf_data& src) {
+	std::vector<const cgltf_image*> images;
+
+	auto add = [&](const cgltf_texture* tex) {
+		if (!tex || !tex->image || !tex->sampler) {
+			return;
+		}
+
+		const auto* img = tex->image;
+		if (img->uri && !isDataUri(img->uri) && !img->buffer_view) {
+			const auto path = base_path / fs::path(img->uri);
+			if (path.extension().string() == ".dds" || assets.textures.contains(path.stem().string())) {
+				return;
+			}
+		}
+
+		if (std::find(images.begin(), images.end(), img) == images.end()) {
+			images.emplace_back(img);
+		}
+	};
+
+	for (size_t i = 0; i < src.materials_count; ++i) {
+		const auto& material = src.materials[i];
+		add(material.pbr_metallic_roughness.base_color_texture.texture);
+		add(material.normal_texture.texture);
+		add(material.emissive_texture.texture);
+	}
+
+	return images;
+}
+
 static std::shared_ptr<ms::Material> loadMaterial(
 	Assets& assets,
 	const InstanceTypes& instance_types,
@@ -664,12 +878,11 @@ static std::shared_ptr<ms::Material> loadMaterial(
 	const cgltf_material& material,
 	const std::string& model_name,
 	size_t material_index,
-    [[maybe_unused]] const ModelLoaderFlags& flags
+    [[maybe_unused]] const ModelLoaderFlags& flags,
+	const DecodedImages& images = {}
 ) {
 	ms::Material::Builder builder = ms::Material::builder();
-	const auto material_name = model_name + (material.name
-		? std::string(material.name)
-		: generateMaterialName(model_name, material_index));
+	const auto material_name = getMaterialName(model_name, material, material_index);
 
 	builder
 		.name(material_name)
@@ -697,45 +910,6 @@ static std::shared_ptr<ms::Material> loadMaterial(
 //		throw ModelLoadError {"missing PBR metallic roughness"};
 //	}
 
-	auto bytesFromBase64 = [](const char* cstr) -> std::vector<uint8_t> {    
-	    auto decode_base64_char = [](char c) -> uint8_t {
-	        if (c >= 'A' && c <= 'Z') return c - 'A';
-	        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
-	        if (c >= '0' && c <= '9') return c - '0' + 52;
-	        if (c == '+') return 62;
-	        if (c == '/') return 63;
-	        if (c == '=') return 64;
-	        throw ModelLoadError(std::string("Invalid base64 character ") + c + " aka " + std::to_string(static_cast<int>(c)));
-	    };
-    
-	    std::vector<uint8_t> output;
-    
-	    while (*cstr) {
-	        uint8_t sextet_a = *cstr ? decode_base64_char(*cstr++) : 0;
-	        uint8_t sextet_b = *cstr ? decode_base64_char(*cstr++) : 0;
-	        uint8_t sextet_c = *cstr ? decode_base64_char(*cstr++) : 0;
-	        uint8_t sextet_d = *cstr ? decode_base64_char(*cstr++) : 0;
-
-	        uint32_t triple = (static_cast<uint32_t>(sextet_a) << 18) |
-	                          (static_cast<uint32_t>(sextet_b) << 12) |
-	                          (static_cast<uint32_t>(sextet_c) << 6) |
-	                          static_cast<uint32_t>(sextet_d);
-	        
-	        if (sextet_c == 64) {
-	            output.push_back(static_cast<uint8_t>((triple >> 16) & 0xFF));
-	        } else if (sextet_d == 64) {
-	            output.push_back(static_cast<uint8_t>((triple >> 16) & 0xFF));
-	            output.push_back(static_cast<uint8_t>((triple >> 8) & 0xFF));
-	        } else {
-	            output.push_back(static_cast<uint8_t>((triple >> 16) & 0xFF));
-	            output.push_back(static_cast<uint8_t>((triple >> 8) & 0xFF));
-	            output.push_back(static_cast<uint8_t>(triple & 0xFF));
-	        }
-	    }
-	    
-	    return output;
-	};
-
 	auto loadTextureFrom = [&](cgltf_texture& tex, std::string name, TextureLoaderFlags flags) -> std::optional<std::shared_ptr<Texture>> {
 		if (!tex.image) {
 			return std::nullopt;
@@ -828,27 +1002,25 @@ static std::shared_ptr<ms::Material> loadMaterial(
 			flags.wrapping = *wrap_t_mode;
 		}
 
-		if (strncmp(img.uri, "data:", 5) == 0) {
-			const char* comma = strchr(img.uri, ',');
+		const auto decoded = images.find(&img);
 
-			if (comma && comma - img.uri >= 7 && strncmp(comma - 7, ";base64", 7) == 0) {
-				auto buffer = bytesFromBase64(comma + 1);
+		if (img.uri && !isDataUri(img.uri) && !img.buffer_view) {
+			const auto path = base_path / fs::path(img.uri);
 
-				return TextureLoader::load(
-					assets,
-					name,
-					buffer.data(),
-					buffer.size(),
-					flags
-				);
-			} else {
-				throw ModelLoadError {"unknown data uri"};
+			if (decoded != images.end()) {
+				return TextureLoader::load(assets, path.stem().string(), decoded->second, flags);
 			}
 
-		} else {
-			const auto path = base_path / fs::path(img.uri);
 			return TextureLoader::load(assets, path, flags);
 		}
+
+		// images are not decoded ahead when only materials are loaded
+		return TextureLoader::load(
+			assets,
+			name,
+			decoded != images.end() ? decoded->second : decodeImage(img, base_path),
+			flags
+		);
 	};
 
 	const auto& pbr_mr   = material.pbr_metallic_roughness;
@@ -924,13 +1096,14 @@ static std::vector<std::shared_ptr<ms::Material>> loadMaterials(
 	const InstanceTypes& instance_types,
 	const fs::path& path,
 	const cgltf_data& src,
-    const ModelLoaderFlags& flags
+    const ModelLoaderFlags& flags,
+	const DecodedImages& images
 ) {
 	std::vector<std::shared_ptr<ms::Material>> materials;
 
 	for (size_t i = 0; i < src.materials_count; ++i) {
 		materials.emplace_back(loadMaterial(
-			assets, instance_types, path.parent_path(), src.materials[i], model_name, i, flags
+			assets, instance_types, path.parent_path(), src.materials[i], model_name, i, flags, images
 		));
 	}
 
@@ -974,8 +1147,59 @@ static void fixMissingMaterials(
 	}
 }
 
-static SkeletalModel* loadSkeletalModel(
+// CPU side of import, images and primitives are decoded on thread pool before GL objects are created.
+struct DecodedModel {
+	DecodedImages images;
+	std::vector<PrimitiveData> primitives;
+};
+
+static DecodedModel decodeModel(
 	Assets& assets, const fs::path& path, const cgltf_data& src, const std::string& model_name, const ModelLoaderFlags& flags
+) {
+	const auto images = collectImages(assets, path.parent_path(), src);
+	const auto primitives = collectPrimitives(src, src.skins_count > 0, model_name);
+
+	std::vector<TextureLoader::Image> decoded_images(images.size());
+	DecodedModel decoded;
+	decoded.primitives.resize(primitives.size());
+
+	// images and primitives share one pass, so large images overlap with mesh conversion
+	const auto count = images.size() + primitives.size();
+	std::vector<std::exception_ptr> errors(count);
+
+	ThreadPool::getShared().parallelFor(count, 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			// errors are kept, so chunk of calling thread does not return before others finish
+			try {
+				if (i < images.size()) {
+					decoded_images[i] = decodeImage(*images[i], path.parent_path());
+				} else {
+					const auto& task = primitives[i - images.size()];
+					decoded.primitives[i - images.size()] =
+						convertPrimitive(*task.primitive, task.mesh_matrix, task.skin, task.mesh_name, flags);
+				}
+			} catch (...) {
+				errors[i] = std::current_exception();
+			}
+		}
+	});
+
+	for (const auto& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	for (size_t i = 0; i < images.size(); ++i) {
+		decoded.images.emplace(images[i], std::move(decoded_images[i]));
+	}
+
+	return decoded;
+}
+
+static SkeletalModel* loadSkeletalModel(
+	Assets& assets, const fs::path& path, const cgltf_data& src, const std::string& model_name, const ModelLoaderFlags& flags,
+	DecodedModel& decoded
 ) {
 	std::vector<Bone> bones;
 	std::unordered_map<const cgltf_node*, size_t> bone_indice_map;
@@ -1037,26 +1261,9 @@ static SkeletalModel* loadSkeletalModel(
 
 	auto bone_indices_tree = makeBoneIndiceTrees(root_nodes, bone_map);
 
-	InstanceTypes instance_types = flags.additional_instance_types;
-	instance_types.emplace(InstanceType::Skeletal);
-	auto loaded_materials = loadMaterials(model_name, assets, instance_types, path, src, flags);
-
-	std::vector<std::shared_ptr<AbstractMesh>> meshes;
-	std::vector<std::shared_ptr<ms::Material>> mesh_materials;
-
-	for (size_t i = 0; i < src.nodes_count; ++i) {
-		const cgltf_node& node = src.nodes[i];
-
-		if (node.mesh) {
-			auto [more_meshes, more_mesh_materials] = loadMeshes(
-				node, *node.mesh, node.skin, model_name, meshes.size(), loaded_materials, src, flags
-			);
-			meshes.insert(meshes.end(), more_meshes.begin(), more_meshes.end());
-			mesh_materials.insert(
-				mesh_materials.end(), more_mesh_materials.begin(), more_mesh_materials.end()
-			);
-		}
-	}
+	const auto instance_types = getInstanceTypes(true, flags);
+	auto loaded_materials = loadMaterials(model_name, assets, instance_types, path, src, flags, decoded.images);
+	auto [meshes, mesh_materials] = loadMeshes(decoded.primitives, loaded_materials, src);
 
 	fixMissingMaterials(mesh_materials, assets, model_name, instance_types);
 
@@ -1077,28 +1284,13 @@ static SkeletalModel* loadSkeletalModel(
 }
 
 static Model* loadPlainModel(
-	Assets& assets, const fs::path& path, const cgltf_data& src, const std::string& model_name, const ModelLoaderFlags& flags
+	Assets& assets, const fs::path& path, const cgltf_data& src, const std::string& model_name, const ModelLoaderFlags& flags,
+	DecodedModel& decoded
 ) {
-	std::vector<std::shared_ptr<AbstractMesh>> meshes;
-	std::vector<std::shared_ptr<ms::Material>> mesh_materials;
-	InstanceTypes instance_types = flags.additional_instance_types;
-	instance_types.emplace(InstanceType::Model);
-
-	auto loaded_materials = loadMaterials(model_name, assets, instance_types, path, src, flags);
+	const auto instance_types = getInstanceTypes(false, flags);
 
-	for (size_t i = 0; i < src.nodes_count; ++i) {
-		const cgltf_node& node = src.nodes[i];
-
-		if (node.mesh) {
-			auto [more_meshes, more_mesh_materials] = loadMeshes(
-				node, *node.mesh, nullptr, model_name, meshes.size(), loaded_materials, src, flags
-			);
-			meshes.insert(meshes.end(), more_meshes.begin(), more_meshes.end());
-			mesh_materials.insert(
-				mesh_materials.end(), more_mesh_materials.begin(), more_mesh_materials.end()
-			);
-		}
-	}
+	auto loaded_materials = loadMaterials(model_name, assets, instance_types, path, src, flags, decoded.images);
+	auto [meshes, mesh_materials] = loadMeshes(decoded.primitives, loaded_materials, src);
 
 	fixMissingMaterials(mesh_materials, assets, model_name, instance_types);
 
@@ -1108,16 +1300,19 @@ static Model* loadPlainModel(
 static std::shared_ptr<AbstractModel>
 loadModel(Assets& assets, const fs::path& path, const cgltf_data& src, const ModelLoaderFlags& flags) {
 	auto model_name = path.stem().string();
+	auto decoded = decodeModel(assets, path, src, model_name, flags);
 
 	if (src.skins_count > 0) {
-		return std::shared_ptr<AbstractModel>(loadSkeletalModel(assets, path, src, model_name, flags));
+		return std::shared_ptr<AbstractModel>(loadSkeletalModel(assets, path, src, model_name, flags, decoded));
 	} else {
-		return std::shared_ptr<AbstractModel>(loadPlainModel(assets, path, src, model_name, flags));
+		return std::shared_ptr<AbstractModel>(loadPlainModel(assets, path, src, model_name, flags, decoded));
 	}
 }
 
-std::shared_ptr<AbstractModel>
-GltfModelLoader::loadModel(Assets& assets, const fs::path& path, const ModelLoaderFlags& flags) {
+using GltfData = std::unique_ptr<cgltf_data, decltype(&cgltf_free)>;
+
+// Parsed data is released with the returned pointer, models keep only copied data.
+static GltfData parseFile(const fs::path& path, bool load_buffers) {
 	cgltf_options opts = cgltf_options {
 		cgltf_file_type_invalid, // autodetect
 		0, // auto json token count
@@ -1135,15 +1330,112 @@ GltfModelLoader::loadModel(Assets& assets, const fs::path& path, const ModelLoad
 			+ std::to_string(static_cast<int>(gltf))};
 	}
 
-	auto result = cgltf_load_buffers(&opts, out_data, path_str.c_str());
-	if (result != cgltf_result_success) {
-		throw ModelLoadError {
-			"failed to load buffers: " + std::to_string(static_cast<int>(result))};
+	GltfData data {out_data, &cgltf_free};
+
+	if (load_buffers) {
+		auto result = cgltf_load_buffers(&opts, out_data, path_str.c_str());
+		if (result != cgltf_result_success) {
+			throw ModelLoadError {
+				"failed to load buffers: " + std::to_string(static_cast<int>(result))};
+		}
 	}
 
 	if (out_data->scenes == nullptr) {
 		throw ModelLoadError {"no scene"};
 	}
 
-	return ::loadModel(assets, path, *out_data, flags);
+	return data;
+}
+
+// Loader options that change cooked model data.
+static uint32_t getCacheOptions(const ModelLoaderFlags& flags) {
+	return flags.isPresent(ModelLoaderOption::FlipUV) ? 1u : 0u;
+}
+
+// Loads model from its cache, glTF is parsed only for materials that are not loaded yet.
+static std::shared_ptr<AbstractModel> loadCachedModel(
+	Assets& assets, const fs::path& path, const ModelLoaderFlags& flags
+) {
+	const auto model_name = path.stem().string();
+	GltfData src {nullptr, &cgltf_free};
+
+	auto resolve_material = [&](const std::string& name) -> std::shared_ptr<ms::Material> {
+		if (assets.materials.contains(name)) {
+			return assets.materials.at(name);
+		}
+
+		// material textures are referenced by uri, so buffers are not needed
+		if (!src) {
+			src = parseFile(path, false);
+		}
+
+		const auto instance_types = getInstanceTypes(src->skins_count > 0, flags);
+		for (size_t i = 0; i < src->materials_count; ++i) {
+			if (getMaterialName(model_name, src->materials[i], i) == name) {
+				return loadMaterial(assets, instance_types, path.parent_path(), src->materials[i], model_name, i, flags);
+			}
+		}
+
+		if (name == generateMaterialName(model_name, 0)) {
+			return makeDummyMaterial(assets, model_name, instance_types);
+		}
+
+		throw ModelLoadError {"material " + name + " of cached model is not found"};
+	};
+
+	return ModelCache::load(
+		ModelCache::getPath(path),
+		ModelCache::getSource(path, getCacheOptions(flags)),
+		resolve_material
+	);
+}
+
+// Applies animation options after model is cached, cache keeps original keyframes.
+static void processAnimations(AbstractModel& model, const ModelLoaderFlags& flags) {
+	auto* skeletal = dynamic_cast<SkeletalModel*>(&model);
+	if (!skeletal) {
+		return;
+	}
+
+	for (auto& animation : skeletal->getAnimations()) {
+		if (flags.isPresent(ModelLoaderOption::CompressAnimations)) {
+			animation.compress(flags.animation_compression);
+		} else if (flags.isPresent(ModelLoaderOption::ReduceKeyframes)) {
+			for (auto& node : animation.nodes) {
+				reduceKeyframes(node, flags.animation_compression);
+			}
+		}
+	}
+}
+
+std::shared_ptr<AbstractModel>
+GltfModelLoader::loadModel(Assets& assets, const fs::path& path, const ModelLoaderFlags& flags) {
+	std::shared_ptr<AbstractModel> model;
+
+	if (flags.isPresent(ModelLoaderOption::Cache)) {
+		try {
+			model = loadCachedModel(assets, path, flags);
+		} catch (const std::runtime_error& error) {
+			// broken cache is rewritten from source
+			std::cerr << "failed to load model cache of " << path.string() << ": " << error.what() << std::endl;
+		}
+	}
+
+	if (!model) {
+		const auto src = parseFile(path, true);
+		model = ::loadModel(assets, path, *src, flags);
+
+		if (flags.isPresent(ModelLoaderOption::Cache)) {
+			try {
+				ModelCache::save(*model, ModelCache::getPath(path), ModelCache::getSource(path, getCacheOptions(flags)));
+			} catch (const std::exception& error) {
+				// model is loaded anyway, cache is written next time
+				std::cerr << "failed to write model cache of " << path.string() << ": " << error.what() << std::endl;
+			}
+		}
+	}
+
+	processAnimations(*model, flags);
+
+	return model;
 }
@@ -0,0 +1,170 @@
+#include <limitless/loaders/ktx_loader.hpp>
+#include <limitless/loaders/texture_loader.hpp>
+#include <limitless/util/mapped_file.hpp>
+#include <limitless/util/filesystem.hpp>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    class KTX2HEADER {
+    public:
+        uint8_t identifier[12];
+        uint32_t vkFormat;
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        uint32_t levelCount;
+        uint32_t supercompressionScheme;
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+
+    class KTX2LEVEL {
+    public:
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+
+    static_assert(sizeof(KTX2HEADER) == 80, "KTX2 header layout mismatch");
+
+    constexpr uint8_t KTX2_IDENTIFIER[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    enum class VkFormat : uint32_t {
+        BC1_RGB_UNORM = 131,
+        BC1_RGB_SRGB = 132,
+        BC1_RGBA_UNORM = 133,
+        BC1_RGBA_SRGB = 134,
+        BC2_UNORM = 135,
+        BC2_SRGB = 136,
+        BC3_UNORM = 137,
+        BC3_SRGB = 138,
+        BC4_UNORM = 139,
+        BC4_SNORM = 140,
+        BC5_UNORM = 141,
+        BC5_SNORM = 142,
+        BC6H_UFLOAT = 143,
+        BC6H_SFLOAT = 144,
+        BC7_UNORM = 145,
+        BC7_SRGB = 146,
+        ASTC_4x4_UNORM = 157,
+        ASTC_4x4_SRGB = 158
+    };
+
+    template<typename T>
+    T read(const std::byte* data, std::size_t size, std::size_t offset) {
+        if (offset + sizeof(T) > size) {
+            throw ktx_loader_exception{"KTX2 file is truncated!"};
+        }
+
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+
+    // UNORM color formats follow loader space, the same way DDS ones do
+    Texture::InternalFormat getFormat(VkFormat format, const TextureLoaderFlags& flags) {
+        const auto srgb = flags.space == TextureLoaderFlags::Space::sRGB;
+
+        switch (format) {
+            case VkFormat::BC1_RGB_UNORM: return srgb ? Texture::InternalFormat::sRGB_DXT1 : Texture::InternalFormat::RGB_DXT1;
+            case VkFormat::BC1_RGB_SRGB: return Texture::InternalFormat::sRGB_DXT1;
+            case VkFormat::BC1_RGBA_UNORM: return srgb ? Texture::InternalFormat::sRGBA_DXT1 : Texture::InternalFormat::RGBA_DXT1;
+            case VkFormat::BC1_RGBA_SRGB: return Texture::InternalFormat::sRGBA_DXT1;
+            case VkFormat::BC2_UNORM: return srgb ? Texture::InternalFormat::sRGBA_DXT3 : Texture::InternalFormat::RGBA_DXT3;
+            case VkFormat::BC2_SRGB: return Texture::InternalFormat::sRGBA_DXT3;
+            case VkFormat::BC3_UNORM: return srgb ? Texture::InternalFormat::sRGBA_DXT5 : Texture::InternalFormat::RGBA_DXT5;
+            case VkFormat::BC3_SRGB: return Texture::InternalFormat::sRGBA_DXT5;
+            case VkFormat::BC4_UNORM: return Texture::InternalFormat::R_RGTC;
+            case VkFormat::BC4_SNORM: return Texture::InternalFormat::R_RGTC_SNORM;
+            case VkFormat::BC5_UNORM: return Texture::InternalFormat::RG_RGTC;
+            case VkFormat::BC5_SNORM: return Texture::InternalFormat::RG_RGTC_SNORM;
+            case VkFormat::BC6H_UFLOAT: return Texture::InternalFormat::RGB_BC6H_UF;
+            case VkFormat::BC6H_SFLOAT: return Texture::InternalFormat::RGB_BC6H_SF;
+            case VkFormat::BC7_UNORM: return srgb ? Texture::InternalFormat::sRGBA_BC7 : Texture::InternalFormat::RGBA_BC7;
+            case VkFormat::BC7_SRGB: return Texture::InternalFormat::sRGBA_BC7;
+            case VkFormat::ASTC_4x4_UNORM: return srgb ? Texture::InternalFormat::sRGBA_ASTC_4x4 : Texture::InternalFormat::RGBA_ASTC_4x4;
+            case VkFormat::ASTC_4x4_SRGB: return Texture::InternalFormat::sRGBA_ASTC_4x4;
+            default:
+                throw ktx_loader_exception{"Unsupported Vulkan format " + std::to_string(static_cast<uint32_t>(format))};
+        }
+    }
+}
+
+TextureLoader::CompressedImage KTXLoader::parse(const std::byte* data, std::size_t size, const TextureLoaderFlags& flags) {
+    const auto header = read<KTX2HEADER>(data, size, 0);
+
+    if (std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        throw ktx_loader_exception{"It is not a KTX2 file!"};
+    }
+
+    if (header.supercompressionScheme != 0) {
+        throw ktx_loader_exception{"Supercompressed KTX2 files are not supported!"};
+    }
+
+    if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1) {
+        throw ktx_loader_exception{"Only 2D KTX2 textures are supported!"};
+    }
+
+    TextureLoader::CompressedImage image;
+    image.format = getFormat(static_cast<VkFormat>(header.vkFormat), flags);
+    image.size = {header.pixelWidth, header.pixelHeight};
+
+    if (image.size.x == 0 || image.size.y == 0) {
+        throw ktx_loader_exception{"KTX2 file has empty size!"};
+    }
+
+    // zero level count asks for generated mipmaps, only base one is stored then
+    const auto levels = std::max(header.levelCount, 1u);
+
+    if (levels > TextureLoader::getMaxLevelCount(image.size)) {
+        throw ktx_loader_exception{"KTX2 file has more mipmaps than its size allows!"};
+    }
+
+    // level index follows header and starts from full resolution
+    for (uint32_t level = 0; level < levels; ++level) {
+        const auto index = read<KTX2LEVEL>(data, size, sizeof(KTX2HEADER) + level * sizeof(KTX2LEVEL));
+        const auto level_size = glm::max(image.size >> level, glm::uvec2 {1});
+        const auto byte_count = TextureLoader::getCompressedByteCount(image.format, level_size);
+
+        if (index.byteLength < byte_count || index.byteOffset > size || index.byteLength > size - index.byteOffset) {
+            throw ktx_loader_exception{"KTX2 file is truncated!"};
+        }
+
+        image.levels.push_back({data + index.byteOffset, byte_count});
+    }
+
+    return image;
+}
+
+std::shared_ptr<Texture> KTXLoader::load(Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(_path);
+
+    if (assets.textures.contains(path.stem().string())) {
+        return assets.textures[path.stem().string()];
+    }
+
+    std::unique_ptr<MappedFile> file;
+    try {
+        file = std::make_unique<MappedFile>(path);
+    } catch (const mapped_file_error&) {
+        throw ktx_loader_exception{"Cant open " + path.string()};
+    }
+
+    auto image = parse(file->getData(), file->getSize(), flags);
+    image.path = path;
+
+    // levels are uploaded straight from the mapped file
+    auto texture = TextureLoader::build(image, flags);
+
+    // texture may be loaded by another worker meanwhile
+    return assets.textures.emplace(path.stem().string(), texture);
+}
@@ -0,0 +1,489 @@
+#include <limitless/loaders/model_cache.hpp>
+
+#include <limitless/loaders/gltf_model_loader.hpp>
+#include <limitless/models/skeletal_model.hpp>
+#include <limitless/models/model.hpp>
+#include <limitless/models/mesh.hpp>
+#include <limitless/core/skeletal_stream.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/util/mapped_file.hpp>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <cstring>
+#include <array>
+
+using namespace Limitless;
+
+namespace {
+    constexpr std::array<char, 4> MAGIC {'L', 'M', 'D', 'L'};
+
+    // blobs are aligned for vector loads and direct buffer uploads
+    constexpr size_t ALIGNMENT = 16;
+
+    constexpr uint32_t NO_JOINT = static_cast<uint32_t>(-1);
+
+    // name and material lengths, stream type, bounding box, vertex and index counts
+    constexpr size_t MIN_MESH_SIZE = 4 * sizeof(uint64_t) + sizeof(uint32_t) + sizeof(Box);
+
+    // name length, index, joint index, transforms and local position, rotation and scale
+    constexpr size_t MIN_BONE_SIZE = sizeof(uint64_t) + 2 * sizeof(uint32_t) + 2 * sizeof(glm::mat4) + 2 * sizeof(glm::vec3) + sizeof(glm::fquat);
+
+    // name length, duration, tps and node count
+    constexpr size_t MIN_ANIMATION_SIZE = 2 * sizeof(uint64_t) + 2 * sizeof(double);
+
+    // bone index and key frame counts
+    constexpr size_t MIN_NODE_SIZE = sizeof(uint32_t) + 3 * sizeof(uint64_t);
+
+    enum class CachedModelType : uint32_t {
+        Plain,
+        Skeletal
+    };
+
+    enum class CachedStreamType : uint32_t {
+        Indexed,
+        Skinned
+    };
+
+    struct alignas(ALIGNMENT) CacheHeader {
+        std::array<char, 4> magic;
+        uint32_t version;
+        CachedModelType type;
+        uint32_t options;
+        uint64_t write_time;
+        uint64_t source_size;
+        uint64_t mesh_count;
+        uint64_t size;
+    };
+
+    class CacheWriter {
+    private:
+        std::vector<std::byte> data;
+    public:
+        template<typename T>
+        void write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        void write(const std::string& str) {
+            write(static_cast<uint64_t>(str.size()));
+            const auto* bytes = reinterpret_cast<const std::byte*>(str.data());
+            data.insert(data.end(), bytes, bytes + str.size());
+        }
+
+        /**
+         * Writes element count and aligned blob of elements
+         */
+        template<typename T>
+        void write(const std::vector<T>& array) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            write(static_cast<uint64_t>(array.size()));
+            align();
+            const auto* bytes = reinterpret_cast<const std::byte*>(array.data());
+            data.insert(data.end(), bytes, bytes + array.size() * sizeof(T));
+        }
+
+        void align() {
+            data.resize((data.size() + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+        }
+
+        auto& getData() noexcept { return data; }
+    };
+
+    class CacheReader {
+    private:
+        const std::byte* data;
+        size_t size;
+        size_t offset {};
+
+        void require(size_t bytes) const {
+            if (offset > size || bytes > size - offset) {
+                throw ModelLoadError {"model cache is truncated"};
+            }
+        }
+    public:
+        CacheReader(const std::byte* _data, size_t _size, size_t _offset) noexcept
+            : data {_data}
+            , size {_size}
+            , offset {_offset} {
+        }
+
+        [[nodiscard]] size_t getRemaining() const noexcept {
+            return offset < size ? size - offset : 0;
+        }
+
+        /**
+         * Reads count of records that take at least min_size bytes each, so it can not exceed the rest of file
+         */
+        uint64_t readCount(size_t min_size) {
+            const auto count = read<uint64_t>();
+            if (count > getRemaining() / min_size) {
+                throw ModelLoadError {"model cache has invalid record count"};
+            }
+            return count;
+        }
+
+        template<typename T>
+        T read() {
+            static_assert(std::is_trivially_copyable_v<T>);
+            require(sizeof(T));
+            T value;
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        std::string readString() {
+            const auto length = read<uint64_t>();
+            require(length);
+            std::string str {reinterpret_cast<const char*>(data + offset), length};
+            offset += length;
+            return str;
+        }
+
+        /**
+         * Copies aligned blob of elements as a whole
+         */
+        template<typename T>
+        std::vector<T> readArray() {
+            const auto count = read<uint64_t>();
+            align();
+            if (count > (size - offset) / sizeof(T)) {
+                throw ModelLoadError {"model cache is truncated"};
+            }
+
+            const auto* first = reinterpret_cast<const T*>(data + offset); //NOLINT
+            offset += count * sizeof(T);
+            return std::vector<T> (first, first + count);
+        }
+
+        void align() {
+            offset = (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+            require(0);
+        }
+    };
+
+    void writeTree(CacheWriter& writer, const Tree<uint32_t>& tree) {
+        writer.write(*tree);
+        writer.write(static_cast<uint64_t>(tree.size()));
+        for (const auto& child : tree) {
+            writeTree(writer, child);
+        }
+    }
+
+    Tree<uint32_t> readTree(CacheReader& reader, uint32_t bone_count) {
+        Tree<uint32_t> tree {reader.read<uint32_t>()};
+        if (*tree >= bone_count) {
+            throw ModelLoadError {"model cache has invalid skeleton"};
+        }
+
+        const auto count = reader.read<uint64_t>();
+        for (uint64_t i = 0; i < count; ++i) {
+            tree.add(readTree(reader, bone_count));
+        }
+        return tree;
+    }
+
+    void writeMesh(CacheWriter& writer, const AbstractMesh& abstract_mesh, const std::shared_ptr<ms::Material>& material) {
+        const auto* mesh = dynamic_cast<const Mesh*>(&abstract_mesh);
+        if (!mesh) {
+            throw ModelLoadError {"mesh " + abstract_mesh.getName() + " can not be cached"};
+        }
+
+        const auto& stream = mesh->getVertexStream();
+        const auto* indexed = dynamic_cast<const IndexedVertexStream<VertexNormalTangent>*>(&stream);
+        if (!indexed) {
+            throw ModelLoadError {"vertex stream of mesh " + mesh->getName() + " can not be cached"};
+        }
+
+        const auto* skinned = dynamic_cast<const SkinnedVertexStream<VertexNormalTangent>*>(&stream);
+
+        writer.write(mesh->getName());
+        writer.write(material ? material->getName() : std::string {});
+        writer.write(skinned ? CachedStreamType::Skinned : CachedStreamType::Indexed);
+        writer.write(const_cast<Mesh&>(*mesh).getBoundingBox()); //NOLINT
+        writer.write(indexed->getVertices());
+        writer.write(indexed->getIndices());
+        if (skinned) {
+            writer.write(skinned->getBoneWeights());
+        }
+    }
+
+    std::shared_ptr<AbstractMesh> readMesh(CacheReader& reader, std::shared_ptr<ms::Material>& material, const ModelCache::MaterialResolver& resolver) {
+        auto name = reader.readString();
+        const auto material_name = reader.readString();
+        const auto type = reader.read<CachedStreamType>();
+        const auto box = reader.read<Box>();
+        auto vertices = reader.readArray<VertexNormalTangent>();
+        auto indices = reader.readArray<uint32_t>();
+
+        material = material_name.empty() ? nullptr : resolver(material_name);
+
+        std::unique_ptr<AbstractVertexStream> stream;
+        switch (type) {
+            case CachedStreamType::Indexed:
+                stream = std::make_unique<IndexedVertexStream<VertexNormalTangent>>(
+                    std::move(vertices),
+                    std::move(indices),
+                    VertexStreamUsage::Static,
+                    VertexStreamDraw::Triangles
+                );
+                break;
+            case CachedStreamType::Skinned: {
+                auto weights = reader.readArray<VertexBoneWeight>();
+                if (weights.size() != vertices.size()) {
+                    throw ModelLoadError {"model cache has mismatching bone weights of mesh " + name};
+                }
+
+                stream = std::make_unique<SkinnedVertexStream<VertexNormalTangent>>(
+                    std::move(vertices),
+                    std::move(indices),
+                    std::move(weights),
+                    VertexStreamUsage::Static,
+                    VertexStreamDraw::Triangles
+                );
+                break;
+            }
+            default:
+                throw ModelLoadError {"model cache has unknown vertex stream of mesh " + name};
+        }
+
+        return std::make_shared<Mesh>(std::move(stream), std::move(name), box);
+    }
+
+    void writeSkeleton(CacheWriter& writer, const SkeletalModel& model) {
+        const auto& bones = model.getBones();
+        writer.write(static_cast<uint64_t>(bones.size()));
+        for (const auto& bone : bones) {
+            writer.write(bone.name);
+            writer.write(bone.index);
+            writer.write(bone.joint_index.value_or(NO_JOINT));
+            writer.write(bone.node_transform);
+            writer.write(bone.offset_matrix);
+            writer.write(bone.position);
+            writer.write(bone.rotation);
+            writer.write(bone.scale);
+        }
+
+        const auto& trees = model.getSkeletonTrees();
+        writer.write(static_cast<uint64_t>(trees.size()));
+        for (const auto& tree : trees) {
+            writeTree(writer, tree);
+        }
+
+        const auto& animations = model.getAnimations();
+        writer.write(static_cast<uint64_t>(animations.size()));
+        for (const auto& animation : animations) {
+            if (animation.compressed) {
+                throw ModelLoadError {"compressed animation " + animation.name + " can not be cached"};
+            }
+
+            writer.write(animation.name);
+            writer.write(animation.duration);
+            writer.write(animation.tps);
+            writer.write(static_cast<uint64_t>(animation.nodes.size()));
+            for (const auto& node : animation.nodes) {
+                writer.write(node.bone.index);
+                writer.write(node.positions);
+                writer.write(node.rotations);
+                writer.write(node.scales);
+            }
+        }
+    }
+
+    std::shared_ptr<AbstractModel> readSkeletalModel(
+        CacheReader& reader,
+        std::vector<std::shared_ptr<AbstractMesh>>&& meshes,
+        std::vector<std::shared_ptr<ms::Material>>&& materials,
+        std::string name
+    ) {
+        const auto bone_count = reader.readCount(MIN_BONE_SIZE);
+        std::vector<Bone> bones;
+        bones.reserve(bone_count);
+
+        std::unordered_map<std::string, uint32_t> bone_map;
+        for (uint64_t i = 0; i < bone_count; ++i) {
+            auto bone_name = reader.readString();
+            const auto index = reader.read<uint32_t>();
+            const auto joint_index = reader.read<uint32_t>();
+            const auto node_transform = reader.read<glm::mat4>();
+            const auto offset_matrix = reader.read<glm::mat4>();
+
+            auto& bone = bones.emplace_back(index, bone_name, node_transform, offset_matrix);
+            bone.position = reader.read<glm::vec3>();
+            bone.rotation = reader.read<glm::fquat>();
+            bone.scale = reader.read<glm::vec3>();
+            if (joint_index != NO_JOINT) {
+                bone.joint_index = joint_index;
+            }
+
+            bone_map.emplace(std::move(bone_name), static_cast<uint32_t>(i));
+        }
+
+        const auto tree_count = reader.read<uint64_t>();
+        std::vector<Tree<uint32_t>> trees;
+        for (uint64_t i = 0; i < tree_count; ++i) {
+            trees.emplace_back(readTree(reader, static_cast<uint32_t>(bone_count)));
+        }
+
+        // animation nodes refer to bones, which keep their addresses when vector is moved into model
+        const auto animation_count = reader.readCount(MIN_ANIMATION_SIZE);
+        std::vector<Animation> animations;
+        animations.reserve(animation_count);
+        for (uint64_t i = 0; i < animation_count; ++i) {
+            auto animation_name = reader.readString();
+            const auto duration = reader.read<double>();
+            const auto tps = reader.read<double>();
+
+            const auto node_count = reader.readCount(MIN_NODE_SIZE);
+            std::vector<AnimationNode> nodes;
+            nodes.reserve(node_count);
+            for (uint64_t j = 0; j < node_count; ++j) {
+                const auto bone_index = reader.read<uint32_t>();
+                if (bone_index >= bone_count) {
+                    throw ModelLoadError {"model cache has invalid animation node of " + animation_name};
+                }
+
+                auto positions = reader.readArray<KeyFrame<glm::vec3>>();
+                auto rotations = reader.readArray<KeyFrame<glm::fquat>>();
+                auto scales = reader.readArray<KeyFrame<glm::vec3>>();
+                nodes.emplace_back(std::move(positions), std::move(rotations), std::move(scales), bones[bone_index]);
+            }
+
+            animations.emplace_back(std::move(animation_name), duration, tps, std::move(nodes));
+        }
+
+        return std::make_shared<SkeletalModel>(
+            std::move(meshes),
+            std::move(materials),
+            std::move(bones),
+            std::move(bone_map),
+            std::move(trees),
+            std::move(animations),
+            std::move(name)
+        );
+    }
+}
+
+fs::path ModelCache::getPath(const fs::path& source) {
+    auto path = source;
+    path += EXTENSION;
+    return path;
+}
+
+ModelCache::Source ModelCache::getSource(const fs::path& source, uint32_t options) {
+    return {
+        static_cast<uint64_t>(fs::last_write_time(source).time_since_epoch().count()),
+        static_cast<uint64_t>(fs::file_size(source)),
+        options
+    };
+}
+
+void ModelCache::save(const AbstractModel& model, const fs::path& path, const Source& source) {
+    const auto* plain = dynamic_cast<const Model*>(&model);
+    if (!plain) {
+        throw ModelLoadError {"model " + model.getName() + " can not be cached"};
+    }
+
+    const auto* skeletal = dynamic_cast<const SkeletalModel*>(&model);
+    const auto& meshes = model.getMeshes();
+    const auto& materials = plain->getMaterials();
+
+    CacheWriter writer;
+    writer.write(CacheHeader {});
+    writer.write(model.getName());
+
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        writeMesh(writer, *meshes[i], i < materials.size() ? materials[i] : nullptr);
+    }
+
+    if (skeletal) {
+        writeSkeleton(writer, *skeletal);
+    }
+
+    auto& data = writer.getData();
+
+    const CacheHeader header {
+        MAGIC,
+        VERSION,
+        skeletal ? CachedModelType::Skeletal : CachedModelType::Plain,
+        source.options,
+        source.write_time,
+        source.size,
+        meshes.size(),
+        data.size()
+    };
+    std::memcpy(data.data(), &header, sizeof(CacheHeader));
+
+    // unique name keeps concurrent writers of the same cache from sharing temporary file
+    auto temporary = path;
+    temporary += "." + std::to_string(std::hash<std::thread::id> {}(std::this_thread::get_id()))
+               + "." + std::to_string(std::random_device {}()) + ".tmp";
+
+    {
+        std::ofstream file {temporary, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size())); //NOLINT
+        file.close();
+        if (!file) {
+            fs::remove(temporary);
+            throw ModelLoadError {"failed to write model cache " + temporary.string()};
+        }
+    }
+
+    try {
+        fs::rename(temporary, path);
+    } catch (const fs::filesystem_error&) {
+        fs::remove(temporary);
+        throw;
+    }
+}
+
+std::shared_ptr<AbstractModel> ModelCache::load(const fs::path& path, const Source& source, const MaterialResolver& resolver) {
+    if (!fs::exists(path)) {
+        return nullptr;
+    }
+
+    const MappedFile file {path};
+    if (file.getSize() < sizeof(CacheHeader)) {
+        return nullptr;
+    }
+
+    CacheHeader header {};
+    std::memcpy(&header, file.getData(), sizeof(CacheHeader));
+
+    if (header.magic != MAGIC || header.version != VERSION || header.options != source.options
+        || header.write_time != source.write_time || header.source_size != source.size) {
+        return nullptr;
+    }
+
+    if (header.size != file.getSize()) {
+        throw ModelLoadError {"model cache " + path.string() + " is truncated"};
+    }
+
+    CacheReader reader {file.getData(), file.getSize(), sizeof(CacheHeader)};
+    auto name = reader.readString();
+
+    if (header.mesh_count > reader.getRemaining() / MIN_MESH_SIZE) {
+        throw ModelLoadError {"model cache " + path.string() + " has invalid mesh count"};
+    }
+
+    std::vector<std::shared_ptr<AbstractMesh>> meshes;
+    std::vector<std::shared_ptr<ms::Material>> materials;
+    meshes.reserve(header.mesh_count);
+    materials.reserve(header.mesh_count);
+
+    for (uint64_t i = 0; i < header.mesh_count; ++i) {
+        meshes.emplace_back(readMesh(reader, materials.emplace_back(), resolver));
+    }
+
+    switch (header.type) {
+        case CachedModelType::Plain:
+            return std::make_shared<Model>(std::move(meshes), std::move(materials), std::move(name));
+        case CachedModelType::Skeletal:
+            return readSkeletalModel(reader, std::move(meshes), std::move(materials), std::move(name));
+        default:
+            throw ModelLoadError {"model cache " + path.string() + " has unknown model type"};
+    }
+}
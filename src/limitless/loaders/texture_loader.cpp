@@ -9,6 +9,7 @@
 #include <stb_image_resize.h>
 #include <limitless/assets.hpp>
 #include <limitless/loaders/dds_loader.hpp>
+#include <limitless/loaders/ktx_loader.hpp>
 
 #if LIMITLESS_OPENGL_DEBUG
 	#include <iostream>
@@ -21,6 +22,7 @@ namespace {
     constexpr auto S3TC_EXTENSION = "GL_EXT_texture_compression_s3tc";
     constexpr auto BPTC_EXTENSION = "GL_ARB_texture_compression_bptc";
     constexpr auto RGTC_EXTENSION = "GL_ARB_texture_compression_rgtc";
+    constexpr auto ASTC_EXTENSION = "GL_KHR_texture_compression_astc_ldr";
 }
 
 void TextureLoader::setFormat(Texture::Builder& builder, const TextureLoaderFlags& flags, int channels) {
@@ -124,6 +126,90 @@ void TextureLoader::setFormat(Texture::Builder& builder, const TextureLoaderFlag
             .format(format);
 }
 
+void TextureLoader::checkCompressionSupport(Texture::InternalFormat format) {
+    switch (format) {
+        case Texture::InternalFormat::RGB_DXT1:
+        case Texture::InternalFormat::RGBA_DXT1:
+        case Texture::InternalFormat::sRGB_DXT1:
+        case Texture::InternalFormat::sRGBA_DXT1:
+        case Texture::InternalFormat::RGBA_DXT3:
+        case Texture::InternalFormat::sRGBA_DXT3:
+        case Texture::InternalFormat::RGBA_DXT5:
+        case Texture::InternalFormat::sRGBA_DXT5:
+            if (!ContextInitializer::isExtensionSupported(S3TC_EXTENSION)) {
+                throw texture_loader_exception("Compression S3TC is not supported!");
+            }
+            break;
+        case Texture::InternalFormat::RGBA_BC7:
+        case Texture::InternalFormat::sRGBA_BC7:
+        case Texture::InternalFormat::RGB_BC6H_UF:
+        case Texture::InternalFormat::RGB_BC6H_SF:
+            if (!ContextInitializer::isExtensionSupported(BPTC_EXTENSION)) {
+                throw texture_loader_exception("Compression BPTC is not supported!");
+            }
+            break;
+        case Texture::InternalFormat::R_RGTC:
+        case Texture::InternalFormat::RG_RGTC:
+        case Texture::InternalFormat::R_RGTC_SNORM:
+        case Texture::InternalFormat::RG_RGTC_SNORM:
+            if (!ContextInitializer::isExtensionSupported(RGTC_EXTENSION)) {
+                throw texture_loader_exception("Compression RGTC is not supported!");
+            }
+            break;
+        case Texture::InternalFormat::RGBA_ASTC_4x4:
+        case Texture::InternalFormat::sRGBA_ASTC_4x4:
+            if (!ContextInitializer::isExtensionSupported(ASTC_EXTENSION)) {
+                throw texture_loader_exception("Compression ASTC is not supported!");
+            }
+            break;
+        default:
+            throw texture_loader_exception("Format is not block compressed!");
+    }
+}
+
+std::size_t TextureLoader::getCompressedByteCount(Texture::InternalFormat format, glm::uvec2 size) {
+    std::size_t block_size {};
+
+    switch (format) {
+        case Texture::InternalFormat::RGB_DXT1:
+        case Texture::InternalFormat::RGBA_DXT1:
+        case Texture::InternalFormat::sRGB_DXT1:
+        case Texture::InternalFormat::sRGBA_DXT1:
+        case Texture::InternalFormat::R_RGTC:
+        case Texture::InternalFormat::R_RGTC_SNORM:
+            block_size = 8;
+            break;
+        case Texture::InternalFormat::RGBA_DXT3:
+        case Texture::InternalFormat::sRGBA_DXT3:
+        case Texture::InternalFormat::RGBA_DXT5:
+        case Texture::InternalFormat::sRGBA_DXT5:
+        case Texture::InternalFormat::RGBA_BC7:
+        case Texture::InternalFormat::sRGBA_BC7:
+        case Texture::InternalFormat::RGB_BC6H_UF:
+        case Texture::InternalFormat::RGB_BC6H_SF:
+        case Texture::InternalFormat::RG_RGTC:
+        case Texture::InternalFormat::RG_RGTC_SNORM:
+        case Texture::InternalFormat::RGBA_ASTC_4x4:
+        case Texture::InternalFormat::sRGBA_ASTC_4x4:
+            block_size = 16;
+            break;
+        default:
+            throw texture_loader_exception("Format is not block compressed!");
+    }
+
+    // all supported formats use 4x4 blocks
+    const auto blocks = (size + 3u) / 4u;
+    return static_cast<std::size_t>(blocks.x) * blocks.y * block_size;
+}
+
+uint32_t TextureLoader::getMaxLevelCount(glm::uvec2 size) noexcept {
+    uint32_t count = 1;
+    for (auto side = glm::max(size.x, size.y); side > 1; side >>= 1u) {
+        ++count;
+    }
+    return count;
+}
+
 void TextureLoader::setAnisotropicFilter(const std::shared_ptr<Texture>& texture, const TextureLoaderFlags& flags) {
     if (flags.anisotropic_filter && ContextInitializer::isExtensionSupported(ANIS_EXTENSION)) {
         if (flags.anisotropic_value == 0.0f) {
@@ -134,18 +220,22 @@ void TextureLoader::setAnisotropicFilter(const std::shared_ptr<Texture>& texture
     }
 }
 
-std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
-    auto path = convertPathSeparators(_path);
+TextureLoader::Image TextureLoader::wrap(unsigned char* data, int width, int height, int channels, const TextureLoaderFlags& flags) {
+    setDownScale(width, height, channels, data, flags);
 
-    if (assets.textures.contains(path.stem().string())) {
-        return assets.textures[path.stem().string()];
-    }
+    // downscaled data is allocated by resizer
+    std::shared_ptr<unsigned char> owned = flags.downscale != TextureLoaderFlags::DownScale::None
+        ? std::shared_ptr<unsigned char>(data, std::default_delete<unsigned char[]>())
+        : std::shared_ptr<unsigned char>(data, stbi_image_free);
 
-    if (path.extension().string() == ".dds") {
-    	return DDSLoader::load(assets, path, flags);
-    }
+    return {std::move(owned), width, height, channels, {}};
+}
 
-    stbi_set_flip_vertically_on_load(static_cast<bool>((int)flags.origin));
+TextureLoader::Image TextureLoader::decode(const fs::path& _path, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(_path);
+
+    // flip setting is per thread, so images can be decoded concurrently
+    stbi_set_flip_vertically_on_load_thread(static_cast<bool>((int)flags.origin));
 
     int width = 0, height = 0, channels = 0;
     unsigned char* data = stbi_load(path.string().c_str(), &width, &height, &channels, 0);
@@ -160,71 +250,163 @@ std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const fs::path& _pa
         }
 	#endif
 
-    setDownScale(width, height, channels, data, flags);
+    auto image = wrap(data, width, height, channels, flags);
+    image.path = path;
+    return image;
+}
+
+TextureLoader::Image TextureLoader::decode(const std::string& name, const uint8_t* buffer, size_t size, const TextureLoaderFlags& flags) {
+    stbi_set_flip_vertically_on_load_thread(static_cast<bool>((int)flags.origin));
+
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* data = stbi_load_from_memory(buffer, static_cast<int>(size), &width, &height, &channels, 0);
+
+    if (!data) {
+        throw std::runtime_error("Failed to load texture " + name + " from memory: " + stbi_failure_reason());
+    }
+
+    return wrap(data, width, height, channels, flags);
+}
+
+TextureLoader::Image TextureLoader::resize(const Image& image, glm::uvec2 size) {
+    if (size == glm::uvec2 {static_cast<uint32_t>(image.width), static_cast<uint32_t>(image.height)}) {
+        return image;
+    }
+
+    std::shared_ptr<unsigned char> resized {
+        new unsigned char[static_cast<size_t>(image.channels) * size.x * size.y],
+        std::default_delete<unsigned char[]>()
+    };
+
+    stbir_resize_uint8(
+        image.data.get(), image.width, image.height, 0,
+        resized.get(), static_cast<int>(size.x), static_cast<int>(size.y), 0,
+        image.channels
+    );
+
+    return {std::move(resized), static_cast<int>(size.x), static_cast<int>(size.y), image.channels, image.path};
+}
 
+std::shared_ptr<Texture> TextureLoader::build(const Image& image, const TextureLoaderFlags& flags) {
     Texture::Builder builder = Texture::builder();
 
     builder.target(Texture::Type::Tex2D)
-            .levels(glm::floor(glm::log2(static_cast<float>(glm::max(width, height)))) + 1)
-            .size({width, height})
+            .levels(glm::floor(glm::log2(static_cast<float>(glm::max(image.width, image.height)))) + 1)
+            .size({image.width, image.height})
             .data_type(Texture::DataType::UnsignedByte)
-            .data(data)
-            .path(path);
+            .data(image.data.get());
 
-    setFormat(builder, flags, channels);
+    if (!image.path.empty()) {
+        builder.path(image.path);
+    }
+
+    setFormat(builder, flags, image.channels);
     setTextureParameters(builder, flags);
 
     auto texture = builder.build();
     setAnisotropicFilter(texture, flags);
 
-    if (flags.downscale != TextureLoaderFlags::DownScale::None) {
-        delete data;
-    } else {
-        stbi_image_free(data);
-    }
-
-    assets.textures.add(path.stem().string(), texture);
     return texture;
 }
 
-std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const std::string& name, const uint8_t* buffer, size_t size, const TextureLoaderFlags& flags) {
-    stbi_set_flip_vertically_on_load(static_cast<bool>((int)flags.origin));
-
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    unsigned char* data = stbi_load_from_memory(buffer, size, &width, &height, &channels, 0);
+std::shared_ptr<Texture> TextureLoader::build(const CompressedImage& image, const TextureLoaderFlags& flags) {
+    if (image.levels.empty()) {
+        throw texture_loader_exception("Compressed image has no levels!");
+    }
 
-    if (!data) {
-        throw std::runtime_error("Failed to load texture " + name + " from memory: " + stbi_failure_reason());
+    if (flags.downscale != TextureLoaderFlags::DownScale::None && image.levels.size() == 1) {
+        throw texture_loader_exception("Cant do compressed texture downscaling w/o mipmaps in the file!");
     }
 
-    setDownScale(width, height, channels, data, flags);
+    checkCompressionSupport(image.format);
+
+    // levels below 1x1 are ignored
+    const auto stored = std::min<std::size_t>(image.levels.size(), getMaxLevelCount(image.size));
+
+    // downscaled texture starts from lower stored level
+    const auto base = std::min(static_cast<std::size_t>(flags.downscale), stored - 1);
+    const auto levels = flags.mipmap ? static_cast<uint32_t>(stored - base) : 1u;
+    const auto size = glm::max(image.size >> static_cast<uint32_t>(base), glm::uvec2 {1});
+
+    // compressed levels cannot be generated, so only stored ones are sampled
+    auto level_flags = flags;
+    level_flags.mipmap = levels > 1;
 
     Texture::Builder builder = Texture::builder();
 
     builder.target(Texture::Type::Tex2D)
-            .levels(glm::floor(glm::log2(static_cast<float>(glm::max(width, height)))) + 1)
-            .size({width, height})
-            .data_type(Texture::DataType::UnsignedByte)
-            .data(data);
+            .internal_format(image.format)
+            .levels(levels)
+            .size(size)
+            .compressed_data(image.levels[base].data, image.levels[base].byte_count);
 
-    setFormat(builder, flags, channels);
-    setTextureParameters(builder, flags);
+    if (!image.path.empty()) {
+        builder.path(image.path);
+    }
+
+    setTextureParameters(builder, level_flags);
 
     auto texture = builder.build();
+
+    for (uint32_t level = 1; level < levels; ++level) {
+        const auto& level_data = image.levels[base + level];
+        const auto level_size = glm::max(size >> level, glm::uvec2 {1});
+
+        if (texture->isImmutable()) {
+            texture->compressedSubImage(level, {0, 0}, level_size, level_data.data, level_data.byte_count);
+        } else {
+            texture->compressedImage(level, level_size, level_data.data, level_data.byte_count);
+        }
+    }
+
+    // mutable texture is incomplete unless sampled levels are limited to the uploaded ones
+    if (!texture->isImmutable()) {
+        texture->setLevelRange(0, levels - 1);
+    }
+
     setAnisotropicFilter(texture, flags);
 
-    if (flags.downscale != TextureLoaderFlags::DownScale::None) {
-        delete data;
-    } else {
-        stbi_image_free(data);
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(_path);
+
+    if (assets.textures.contains(path.stem().string())) {
+        return assets.textures[path.stem().string()];
+    }
+
+    if (path.extension().string() == ".dds") {
+    	return DDSLoader::load(assets, path, flags);
     }
 
+    if (path.extension().string() == ".ktx2") {
+        return KTXLoader::load(assets, path, flags);
+    }
+
+    auto texture = build(decode(path, flags), flags);
+
+    // texture may be loaded by another worker meanwhile
+    return assets.textures.emplace(path.stem().string(), texture);
+}
+
+std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const std::string& name, const uint8_t* buffer, size_t size, const TextureLoaderFlags& flags) {
+    auto texture = build(decode(name, buffer, size, flags), flags);
+
     assets.textures.add(name, texture);
     return texture;
 }
 
+std::shared_ptr<Texture> TextureLoader::load(Assets& assets, const std::string& name, const Image& image, const TextureLoaderFlags& flags) {
+    if (assets.textures.contains(name)) {
+        return assets.textures[name];
+    }
+
+    return assets.textures.emplace(name, build(image, flags));
+}
+
 std::shared_ptr<Texture> TextureLoader::loadCubemap([[maybe_unused]] Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
     auto path = convertPathSeparators(_path);
 
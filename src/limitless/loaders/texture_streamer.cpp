@@ -0,0 +1,427 @@
+#include <limitless/loaders/texture_streamer.hpp>
+
+#include <limitless/core/texture/extension_texture.hpp>
+#include <limitless/core/uniform/uniform_sampler.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/assets.hpp>
+#include <algorithm>
+#include <iostream>
+
+using namespace Limitless;
+
+namespace {
+    glm::uvec2 getMipSize(glm::uvec2 size, uint32_t mip) noexcept {
+        return glm::max(size >> mip, glm::uvec2 {1});
+    }
+
+    // same chain TextureLoader allocates
+    uint32_t getLevels(glm::uvec2 size) noexcept {
+        uint32_t levels = 1;
+        while ((glm::max(size.x, size.y) >> levels) != 0) {
+            ++levels;
+        }
+        return levels;
+    }
+
+    bool isBlockCompressed(Texture::InternalFormat format) noexcept {
+        switch (format) {
+            case Texture::InternalFormat::RGB_DXT1:
+            case Texture::InternalFormat::RGBA_DXT1:
+            case Texture::InternalFormat::sRGB_DXT1:
+            case Texture::InternalFormat::sRGBA_DXT1:
+            case Texture::InternalFormat::RGBA_DXT3:
+            case Texture::InternalFormat::sRGBA_DXT3:
+            case Texture::InternalFormat::RGBA_DXT5:
+            case Texture::InternalFormat::sRGBA_DXT5:
+            case Texture::InternalFormat::RGBA_BC7:
+            case Texture::InternalFormat::sRGBA_BC7:
+            case Texture::InternalFormat::RGB_BC6H_UF:
+            case Texture::InternalFormat::RGB_BC6H_SF:
+            case Texture::InternalFormat::R_RGTC:
+            case Texture::InternalFormat::RG_RGTC:
+            case Texture::InternalFormat::R_RGTC_SNORM:
+            case Texture::InternalFormat::RG_RGTC_SNORM:
+            case Texture::InternalFormat::RGBA_ASTC_4x4:
+            case Texture::InternalFormat::sRGBA_ASTC_4x4:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    uint32_t getBitsPerTexel(Texture::InternalFormat format) noexcept {
+        switch (format) {
+            case Texture::InternalFormat::R:
+            case Texture::InternalFormat::R8:
+                return 8;
+            case Texture::InternalFormat::RG8:
+            case Texture::InternalFormat::RG8_SNORM:
+            case Texture::InternalFormat::Depth16:
+                return 16;
+            case Texture::InternalFormat::RGB_DXT1:
+            case Texture::InternalFormat::RGBA_DXT1:
+            case Texture::InternalFormat::sRGB_DXT1:
+            case Texture::InternalFormat::sRGBA_DXT1:
+            case Texture::InternalFormat::R_RGTC:
+            case Texture::InternalFormat::R_RGTC_SNORM:
+                return 4;
+            case Texture::InternalFormat::RGBA_DXT3:
+            case Texture::InternalFormat::sRGBA_DXT3:
+            case Texture::InternalFormat::RGBA_DXT5:
+            case Texture::InternalFormat::sRGBA_DXT5:
+            case Texture::InternalFormat::RGBA_BC7:
+            case Texture::InternalFormat::sRGBA_BC7:
+            case Texture::InternalFormat::RGB_BC6H_UF:
+            case Texture::InternalFormat::RGB_BC6H_SF:
+            case Texture::InternalFormat::RG_RGTC:
+            case Texture::InternalFormat::RG_RGTC_SNORM:
+            case Texture::InternalFormat::RGBA_ASTC_4x4:
+            case Texture::InternalFormat::sRGBA_ASTC_4x4:
+                return 8;
+            case Texture::InternalFormat::RGB16:
+            case Texture::InternalFormat::RGBA16:
+            case Texture::InternalFormat::RGB16F:
+            case Texture::InternalFormat::RGBA16F:
+            case Texture::InternalFormat::RGB16_SNORM:
+            case Texture::InternalFormat::RGBA16_SNORM:
+                return 64;
+            case Texture::InternalFormat::RGB32F:
+            case Texture::InternalFormat::RGBA32F:
+                return 128;
+            default:
+                // 8-bit RGB is padded to 4 bytes by drivers
+                return 32;
+        }
+    }
+
+    uint64_t getMemorySize(Texture::InternalFormat format, glm::uvec2 size, uint32_t levels) noexcept {
+        uint64_t bits = 0;
+
+        for (uint32_t level = 0; level < levels; ++level) {
+            auto level_size = getMipSize(size, level);
+
+            // compressed levels occupy whole 4x4 blocks
+            if (isBlockCompressed(format)) {
+                level_size = (level_size + 3u) / 4u * 4u;
+            }
+
+            bits += static_cast<uint64_t>(level_size.x) * level_size.y * getBitsPerTexel(format);
+        }
+
+        return bits / 8;
+    }
+}
+
+TextureStreamer::TextureStreamer(uint64_t _budget, uint32_t _tail_size, uint32_t workers)
+    : pool {std::max(workers, 1u)}
+    , budget {_budget}
+    , tail_size {std::max(_tail_size, 1u)} {
+}
+
+TextureStreamer::~TextureStreamer() = default;
+
+std::shared_ptr<Texture> TextureStreamer::load(Assets& assets, const fs::path& _path, const TextureLoaderFlags& flags) {
+    auto path = convertPathSeparators(_path);
+    const auto name = path.stem().string();
+
+    if (assets.textures.contains(name)) {
+        return assets.textures[name];
+    }
+
+    // top mips are dropped by copying lower ones, so the chain has to be filled;
+    // compressed containers are uploaded with their stored levels
+    if (!flags.mipmap || path.extension().string() == ".dds" || path.extension().string() == ".ktx2") {
+        return TextureLoader::load(assets, path, flags);
+    }
+
+    const auto image = TextureLoader::decode(path, flags);
+    const glm::uvec2 size {static_cast<uint32_t>(image.width), static_cast<uint32_t>(image.height)};
+
+    uint32_t tail_mip = 0;
+    while (glm::max(size.x, size.y) >> tail_mip > tail_size) {
+        ++tail_mip;
+    }
+
+    auto tail = TextureLoader::build(TextureLoader::resize(image, getMipSize(size, tail_mip)), flags);
+
+    // texture may be loaded by another worker meanwhile
+    auto texture = assets.textures.emplace(name, tail);
+    if (texture != tail) {
+        return texture;
+    }
+
+    std::unique_lock lock {mutex};
+
+    Entry entry;
+    entry.format = texture->getInternalFormat();
+    entry.texture = texture;
+    entry.path = path;
+    entry.flags = flags;
+    entry.size = size;
+    entry.tail_mip = tail_mip;
+    entry.resident_mip = tail_mip;
+    entry.requested_mip = tail_mip;
+    entry.last_used = frame;
+    entry.memory = getMemorySize(*texture);
+    entry.tail_memory = entry.memory;
+
+    usage += entry.memory;
+    entries.emplace(texture.get(), std::move(entry));
+
+    return texture;
+}
+
+void TextureStreamer::request(const Texture& texture, uint32_t mip) {
+    std::unique_lock lock {mutex};
+
+    if (auto it = entries.find(&texture); it != entries.end()) {
+        auto& entry = it->second;
+        entry.requested_mip = std::min(entry.requested_mip, mip);
+        entry.last_used = frame;
+    }
+}
+
+void TextureStreamer::request(const ms::Material& material, float screen_size) {
+    std::unique_lock lock {mutex};
+
+    auto use = [&] (const Uniform& uniform) {
+        if (uniform.getType() != UniformType::Sampler) {
+            return;
+        }
+
+        const auto& texture = static_cast<const UniformSampler&>(uniform).getSampler(); //NOLINT
+        if (auto it = entries.find(texture.get()); it != entries.end()) {
+            auto& entry = it->second;
+            entry.requested_mip = std::min(entry.requested_mip, getRequiredMip(entry.size, screen_size));
+            entry.last_used = frame;
+        }
+    };
+
+    for (const auto& [_, property] : material.getProperties()) {
+        use(*property);
+    }
+
+    for (const auto& [_, uniform] : material.getUniforms()) {
+        use(*uniform);
+    }
+}
+
+void TextureStreamer::replace(Entry& entry, Texture& texture, std::shared_ptr<Texture> storage) {
+    const auto memory = getMemorySize(*storage);
+
+    usage = usage - entry.memory + memory;
+    entry.memory = memory;
+
+    // texture object is kept, so materials and assets see new storage
+    std::swap(texture, *storage);
+    retired.push_back({std::move(storage), frame});
+}
+
+bool TextureStreamer::evict(uint64_t required, const Entry* except) {
+    if (usage + required <= budget) {
+        return true;
+    }
+
+    std::vector<Entry*> candidates;
+    std::vector<Residency> residencies;
+
+    for (auto& [_, entry] : entries) {
+        if (&entry != except && !entry.texture.expired()) {
+            candidates.emplace_back(&entry);
+            residencies.emplace_back(entry);
+        }
+    }
+
+    const auto evictions = selectEvictions(std::move(residencies), usage, required, budget, frame);
+    if (!evictions) {
+        return false;
+    }
+
+    for (const auto index : *evictions) {
+        auto& entry = *candidates[index];
+        auto texture = entry.texture.lock();
+        replace(entry, *texture, texture->shrink(1));
+        ++entry.resident_mip;
+    }
+
+    return true;
+}
+
+void TextureStreamer::finishPending(Entry& entry, uint32_t& uploads) {
+    using namespace std::chrono_literals;
+
+    if (!entry.pending.valid() || uploads >= uploads_per_update || entry.pending.wait_for(0ns) != std::future_status::ready) {
+        return;
+    }
+
+    TextureLoader::Image image;
+    try {
+        image = entry.pending.get();
+    } catch (const std::exception& e) {
+        // texture stays with its current mips
+        std::cerr << "failed to stream texture " << entry.path.string() << ": " << e.what() << std::endl;
+        return;
+    }
+
+    auto texture = entry.texture.lock();
+    if (!texture || entry.pending_mip >= entry.resident_mip) {
+        return;
+    }
+
+    const auto memory = getMemorySize(entry.format, entry.size, entry.pending_mip);
+
+    if (!evict(memory > entry.memory ? memory - entry.memory : 0, &entry)) {
+        return;
+    }
+
+    replace(entry, *texture, TextureLoader::build(image, entry.flags));
+    entry.resident_mip = entry.pending_mip;
+    ++uploads;
+}
+
+void TextureStreamer::startPending(Entry& entry, uint64_t& available) {
+    if (entry.texture.expired()) {
+        return;
+    }
+
+    const auto mip = selectMip(entry, entry.requested_mip, available);
+    if (mip >= entry.resident_mip) {
+        return;
+    }
+
+    const auto memory = getMemorySize(entry.format, entry.size, mip);
+    available -= memory > entry.memory ? memory - entry.memory : 0;
+
+    entry.pending_mip = mip;
+    entry.pending = pool.add([path = entry.path, flags = entry.flags, size = getMipSize(entry.size, mip)] () {
+        return TextureLoader::resize(TextureLoader::decode(path, flags), size);
+    });
+}
+
+void TextureStreamer::update() {
+    std::unique_lock lock {mutex};
+
+    // storage retired that long ago is not sampled by frames in flight anymore
+    retired.erase(std::remove_if(retired.begin(), retired.end(), [&] (const auto& r) {
+        return frame - r.frame >= RETIRE_FRAMES;
+    }), retired.end());
+
+    uint32_t uploads = 0;
+    std::vector<Entry*> requested;
+
+    for (auto it = entries.begin(); it != entries.end(); ) {
+        auto& entry = it->second;
+
+        if (entry.texture.expired()) {
+            usage -= entry.memory;
+            it = entries.erase(it);
+            continue;
+        }
+
+        finishPending(entry, uploads);
+
+        if (entry.last_used == frame && entry.requested_mip < entry.resident_mip && !entry.pending.valid()) {
+            requested.emplace_back(&entry);
+        }
+
+        ++it;
+    }
+
+    // memory for new decodes is what is free and what top mips of textures unused at this frame take
+    uint64_t available = budget > usage ? budget - usage : 0;
+    for (const auto& [_, entry] : entries) {
+        if (entry.last_used < frame && entry.resident_mip < entry.tail_mip) {
+            available += entry.memory - std::min(entry.memory, entry.tail_memory);
+        }
+    }
+
+    // largest quality difference first
+    std::sort(requested.begin(), requested.end(), [] (const auto* a, const auto* b) {
+        return a->resident_mip - a->requested_mip > b->resident_mip - b->requested_mip;
+    });
+
+    for (auto* entry : requested) {
+        startPending(*entry, available);
+    }
+
+    for (auto& [_, entry] : entries) {
+        entry.requested_mip = entry.tail_mip;
+    }
+
+    ++frame;
+}
+
+uint32_t TextureStreamer::getRequiredMip(glm::uvec2 size, float screen_size) noexcept {
+    const auto texels = static_cast<float>(glm::max(size.x, size.y));
+    screen_size = std::max(screen_size, 1.0f);
+
+    if (screen_size >= texels) {
+        return 0;
+    }
+
+    return static_cast<uint32_t>(std::floor(std::log2(texels / screen_size)));
+}
+
+uint64_t TextureStreamer::getMemorySize(const Texture& texture) noexcept {
+    return ::getMemorySize(texture.getInternalFormat(), glm::uvec2 {texture.getSize()}, texture.getLevels());
+}
+
+uint64_t TextureStreamer::getMemorySize(Texture::InternalFormat format, glm::uvec2 size, uint32_t mip) noexcept {
+    const auto mip_size = getMipSize(size, mip);
+    return ::getMemorySize(format, mip_size, getLevels(mip_size));
+}
+
+uint32_t TextureStreamer::selectMip(const Residency& residency, uint32_t requested_mip, uint64_t available) noexcept {
+    const auto resident_memory = getMemorySize(residency.format, residency.size, residency.resident_mip);
+
+    for (auto mip = requested_mip; mip < residency.resident_mip; ++mip) {
+        const auto memory = getMemorySize(residency.format, residency.size, mip);
+        if (memory <= resident_memory + available) {
+            return mip;
+        }
+    }
+
+    return residency.resident_mip;
+}
+
+std::optional<std::vector<size_t>> TextureStreamer::selectEvictions(std::vector<Residency> residencies, uint64_t usage, uint64_t required, uint64_t budget, uint64_t frame) {
+    std::vector<size_t> evictions;
+
+    while (usage + required > budget) {
+        std::optional<size_t> lru;
+
+        for (size_t i = 0; i < residencies.size(); ++i) {
+            const auto& residency = residencies[i];
+            if (residency.last_used >= frame || residency.resident_mip >= residency.tail_mip) {
+                continue;
+            }
+
+            if (!lru || residency.last_used < residencies[*lru].last_used) {
+                lru = i;
+            }
+        }
+
+        if (!lru) {
+            return std::nullopt;
+        }
+
+        auto& residency = residencies[*lru];
+        const auto memory = getMemorySize(residency.format, residency.size, residency.resident_mip);
+        ++residency.resident_mip;
+        usage -= std::min(usage, memory - getMemorySize(residency.format, residency.size, residency.resident_mip));
+
+        evictions.emplace_back(*lru);
+    }
+
+    return evictions;
+}
+
+uint32_t TextureStreamer::getResidentMip(const Texture& texture) {
+    std::unique_lock lock {mutex};
+
+    if (auto it = entries.find(&texture); it != entries.end()) {
+        return it->second.resident_mip;
+    }
+
+    return 0;
+}
@@ -0,0 +1,260 @@
+#include <limitless/models/animation_compression.hpp>
+
+#include <limitless/models/skeletal_model.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace Limitless;
+
+namespace {
+    constexpr uint16_t QUAT_COMPONENT_MAX = 0x7FFF;
+    constexpr uint16_t QUAT_INDEX_BIT = 0x8000;
+    constexpr float QUAT_COMPONENT_RANGE = 0.70710678f;
+    constexpr float VECTOR_COMPONENT_MAX = 65535.0f;
+
+    uint16_t quantize(float value, float min, float extent, float max) noexcept {
+        const auto normalized = extent > 0.0f ? std::clamp((value - min) / extent, 0.0f, 1.0f) : 0.0f;
+        return static_cast<uint16_t>(std::lround(normalized * max));
+    }
+
+    float dequantize(uint16_t value, float min, float extent, float max) noexcept {
+        return min + static_cast<float>(value) / max * extent;
+    }
+
+    float vectorError(const glm::vec3& a, const glm::vec3& b) noexcept {
+        return glm::length(a - b);
+    }
+
+    // 1 - cos of half angle between rotations, zero for equal ones regardless of sign
+    float rotationError(const glm::fquat& a, const glm::fquat& b) noexcept {
+        return 1.0f - std::abs(glm::dot(a, b));
+    }
+
+    glm::vec3 lerp(const glm::vec3& a, const glm::vec3& b, float factor) noexcept {
+        return a * (1.0f - factor) + b * factor;
+    }
+
+    glm::fquat lerp(const glm::fquat& a, const glm::fquat& b, float factor) noexcept {
+        return glm::normalize(glm::slerp(a, b, factor));
+    }
+
+    /**
+     * Greedy linear fit: keyframe is dropped if every keyframe between last kept one and the next
+     * is restored by interpolation between them within error
+     */
+    template<typename T, typename Error>
+    void reduce(std::vector<KeyFrame<T>>& keyframes, float error, Error&& distance) {
+        if (keyframes.size() < 2) {
+            return;
+        }
+
+        std::vector<KeyFrame<T>> reduced;
+        reduced.push_back(keyframes.front());
+
+        size_t anchor = 0;
+        for (size_t i = 1; i + 1 < keyframes.size(); ++i) {
+            const auto& a = keyframes[anchor];
+            const auto& b = keyframes[i + 1];
+
+            bool fits = true;
+            for (size_t j = anchor + 1; j <= i && fits; ++j) {
+                const auto factor = static_cast<float>((keyframes[j].time - a.time) / (b.time - a.time));
+                fits = distance(lerp(a.data, b.data, factor), keyframes[j].data) <= error;
+            }
+
+            if (!fits) {
+                reduced.push_back(keyframes[i]);
+                anchor = i;
+            }
+        }
+
+        // constant track keeps single keyframe
+        if (reduced.size() > 1 || distance(reduced.front().data, keyframes.back().data) > error) {
+            reduced.push_back(keyframes.back());
+        }
+
+        keyframes = std::move(reduced);
+    }
+}
+
+QuantizedQuat QuantizedQuat::pack(const glm::fquat& quat) noexcept {
+    const float components[4] = {quat.x, quat.y, quat.z, quat.w};
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::abs(components[i]) > std::abs(components[largest])) {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, so dropped component is always positive
+    const auto sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+    QuantizedQuat packed;
+    for (uint32_t i = 0, j = 0; i < 4; ++i) {
+        if (i != largest) {
+            packed.data[j++] = quantize(components[i] * sign, -QUAT_COMPONENT_RANGE, 2.0f * QUAT_COMPONENT_RANGE, QUAT_COMPONENT_MAX);
+        }
+    }
+
+    packed.data[0] |= (largest & 2u) ? QUAT_INDEX_BIT : 0u;
+    packed.data[1] |= (largest & 1u) ? QUAT_INDEX_BIT : 0u;
+
+    return packed;
+}
+
+glm::fquat QuantizedQuat::unpack() const noexcept {
+    const uint32_t largest = ((data[0] & QUAT_INDEX_BIT) ? 2u : 0u) | ((data[1] & QUAT_INDEX_BIT) ? 1u : 0u);
+
+    float components[4] {};
+    float sum = 0.0f;
+    for (uint32_t i = 0, j = 0; i < 4; ++i) {
+        if (i != largest) {
+            const auto value = static_cast<uint16_t>(data[j++] & QUAT_COMPONENT_MAX);
+            components[i] = dequantize(value, -QUAT_COMPONENT_RANGE, 2.0f * QUAT_COMPONENT_RANGE, QUAT_COMPONENT_MAX);
+            sum += components[i] * components[i];
+        }
+    }
+    components[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+    return glm::normalize(glm::fquat {components[3], components[0], components[1], components[2]});
+}
+
+CompressedAnimation::CompressedAnimation(const Animation& animation, const AnimationCompression& settings) {
+    const auto ticks_per_second = animation.tps > 0.0 ? animation.tps : 1.0;
+    step = ticks_per_second / settings.sample_rate;
+    sample_count = static_cast<uint32_t>(std::ceil(animation.duration / step)) + 1;
+
+    std::vector<glm::vec3> vector_samples(sample_count);
+    std::vector<glm::fquat> rotation_samples(sample_count);
+
+    const auto compressVector = [&] (VectorTrack& track, float error) {
+        track.offset = static_cast<uint32_t>(vectors.size());
+        track.count = sample_count;
+        track.min = vector_samples[0];
+
+        auto max = vector_samples[0];
+        bool constant = true;
+        for (const auto& value : vector_samples) {
+            track.min = glm::min(track.min, value);
+            max = glm::max(max, value);
+            constant = constant && vectorError(value, vector_samples[0]) <= error;
+        }
+
+        if (constant) {
+            track.count = 1;
+            track.min = vector_samples[0];
+            max = vector_samples[0];
+        }
+
+        track.extent = max - track.min;
+        for (uint32_t i = 0; i < track.count; ++i) {
+            QuantizedVec3 quantized {};
+            for (int c = 0; c < 3; ++c) {
+                quantized.data[c] = quantize(vector_samples[i][c], track.min[c], track.extent[c], VECTOR_COMPONENT_MAX);
+            }
+            vectors.emplace_back(quantized);
+        }
+    };
+
+    tracks.resize(animation.nodes.size());
+    for (size_t n = 0; n < animation.nodes.size(); ++n) {
+        const auto& node = animation.nodes[n];
+        auto& node_tracks = tracks[n];
+        KeyframeCursor cursor;
+
+        const auto sampleTime = [&] (uint32_t i) { return std::min(static_cast<double>(i) * step, animation.duration); };
+
+        if (!node.positions.empty()) {
+            for (uint32_t i = 0; i < sample_count; ++i) {
+                vector_samples[i] = *node.positionLerp(sampleTime(i), cursor);
+            }
+            compressVector(node_tracks.position, settings.position_error);
+        }
+
+        if (!node.scales.empty()) {
+            for (uint32_t i = 0; i < sample_count; ++i) {
+                vector_samples[i] = *node.scalingLerp(sampleTime(i), cursor);
+            }
+            compressVector(node_tracks.scale, settings.scale_error);
+        }
+
+        if (!node.rotations.empty()) {
+            bool constant = true;
+            for (uint32_t i = 0; i < sample_count; ++i) {
+                rotation_samples[i] = *node.rotationLerp(sampleTime(i), cursor);
+                constant = constant && rotationError(rotation_samples[i], rotation_samples[0]) <= settings.rotation_error;
+            }
+
+            node_tracks.rotation.offset = static_cast<uint32_t>(rotations.size());
+            node_tracks.rotation.count = constant ? 1 : sample_count;
+            for (uint32_t i = 0; i < node_tracks.rotation.count; ++i) {
+                rotations.emplace_back(QuantizedQuat::pack(rotation_samples[i]));
+            }
+        }
+    }
+
+    vectors.shrink_to_fit();
+    rotations.shrink_to_fit();
+}
+
+CompressedAnimation::Sample CompressedAnimation::locate(double anim_time) const noexcept {
+    if (sample_count < 2) {
+        return {0, 0.0f};
+    }
+
+    const auto position = std::clamp(anim_time / step, 0.0, static_cast<double>(sample_count - 1));
+    const auto index = std::min(static_cast<uint32_t>(position), sample_count - 2);
+
+    return {index, static_cast<float>(position - index)};
+}
+
+glm::vec3 CompressedAnimation::sample(const VectorTrack& track, const Sample& sample) const noexcept {
+    const auto unpack = [&] (uint32_t index) {
+        const auto& quantized = vectors[track.offset + index];
+
+        glm::vec3 value;
+        for (int c = 0; c < 3; ++c) {
+            value[c] = dequantize(quantized.data[c], track.min[c], track.extent[c], VECTOR_COMPONENT_MAX);
+        }
+        return value;
+    };
+
+    if (track.count == 1) {
+        return unpack(0);
+    }
+
+    return lerp(unpack(sample.index), unpack(sample.index + 1), sample.factor);
+}
+
+std::optional<glm::vec3> CompressedAnimation::position(size_t node, const Sample& sample) const noexcept {
+    const auto& track = tracks[node].position;
+    return track.count != 0 ? std::optional {this->sample(track, sample)} : std::nullopt;
+}
+
+std::optional<glm::vec3> CompressedAnimation::scale(size_t node, const Sample& sample) const noexcept {
+    const auto& track = tracks[node].scale;
+    return track.count != 0 ? std::optional {this->sample(track, sample)} : std::nullopt;
+}
+
+std::optional<glm::fquat> CompressedAnimation::rotation(size_t node, const Sample& sample) const noexcept {
+    const auto& track = tracks[node].rotation;
+    switch (track.count) {
+        case 0:
+            return std::nullopt;
+        case 1:
+            return rotations[track.offset].unpack();
+        default:
+            return lerp(rotations[track.offset + sample.index].unpack(), rotations[track.offset + sample.index + 1].unpack(), sample.factor);
+    }
+}
+
+size_t CompressedAnimation::getSize() const noexcept {
+    return tracks.size() * sizeof(NodeTracks) + vectors.size() * sizeof(QuantizedVec3) + rotations.size() * sizeof(QuantizedQuat);
+}
+
+void Limitless::reduceKeyframes(AnimationNode& node, const AnimationCompression& settings) {
+    reduce(node.positions, settings.position_error, vectorError);
+    reduce(node.scales, settings.scale_error, vectorError);
+    reduce(node.rotations, settings.rotation_error, rotationError);
+}
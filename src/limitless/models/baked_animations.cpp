@@ -0,0 +1,86 @@
+#include <limitless/models/baked_animations.hpp>
+
+#include <limitless/models/skeletal_model.hpp>
+#include <limitless/core/texture/texture_builder.hpp>
+#include <limitless/core/state_query.hpp>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+using namespace Limitless;
+
+namespace {
+    constexpr uint32_t TEXELS_PER_JOINT = 3;
+
+    double secondsPerTick(double tps) noexcept {
+        return tps > 0.0 ? 1.0 / tps : 1.0;
+    }
+}
+
+BakedAnimations::BakedAnimations(const SkeletalModel& model, double _sample_rate)
+    : sample_rate {_sample_rate} {
+    const auto& bones = model.getBones();
+    const auto joint_count = static_cast<uint32_t>(std::count_if(bones.begin(), bones.end(), [] (const auto& bone) {
+        return bone.joint_index.has_value();
+    }));
+
+    uint32_t frame_count = 0;
+    for (const auto& animation : model.getAnimations()) {
+        const auto frames = static_cast<uint32_t>(std::ceil(animation.duration * secondsPerTick(animation.tps) * sample_rate)) + 1;
+        clips.push_back({frame_count, frames});
+        frame_count += frames;
+    }
+
+    const auto width = std::max(joint_count * TEXELS_PER_JOINT, 1u);
+    const auto height = std::max(frame_count, 1u);
+    const auto max_size = static_cast<uint32_t>(StateQuery().geti(QueryState::MaxTextureSize));
+    if (width > max_size || height > max_size) {
+        throw std::runtime_error("baked animations of " + model.getName() + " do not fit into texture");
+    }
+
+    std::vector<glm::vec4> texels(static_cast<size_t>(width) * height);
+    std::vector<glm::mat4> node_transform(model.getSkeleton().size(), glm::mat4(1.0f));
+    std::vector<glm::mat4> bone_transform(joint_count, glm::mat4(1.0f));
+    std::vector<KeyframeCursor> cursors;
+
+    const auto& animations = model.getAnimations();
+    for (size_t a = 0; a < animations.size(); ++a) {
+        const auto& animation = animations[a];
+        cursors.assign(animation.nodes.size(), KeyframeCursor {});
+
+        for (uint32_t f = 0; f < clips[a].frame_count; ++f) {
+            const auto anim_time = std::min(f / sample_rate / secondsPerTick(animation.tps), animation.duration);
+            model.evaluatePose(animation, anim_time, cursors, node_transform, bone_transform);
+
+            auto* row = texels.data() + static_cast<size_t>(clips[a].first_frame + f) * width;
+            for (uint32_t j = 0; j < joint_count; ++j) {
+                // last row of bone matrix is always (0, 0, 0, 1)
+                const auto transposed = glm::transpose(bone_transform[j]);
+                for (uint32_t r = 0; r < TEXELS_PER_JOINT; ++r) {
+                    row[j * TEXELS_PER_JOINT + r] = transposed[r];
+                }
+            }
+        }
+    }
+
+    texture = Texture::builder()
+            .target(Texture::Type::Tex2D)
+            .internal_format(Texture::InternalFormat::RGBA32F)
+            .size(glm::uvec2{width, height})
+            .format(Texture::Format::RGBA)
+            .data_type(Texture::DataType::Float)
+            .data(texels.data())
+            .mipmap(false)
+            .levels(1)
+            .min_filter(Texture::Filter::Nearest)
+            .mag_filter(Texture::Filter::Nearest)
+            .wrap_s(Texture::Wrap::ClampToEdge)
+            .wrap_t(Texture::Wrap::ClampToEdge)
+            .build();
+}
+
+uint32_t BakedAnimations::getFrame(size_t animation, double anim_time, double tps) const noexcept {
+    const auto& clip = clips[animation];
+    const auto frame = static_cast<uint32_t>(std::lround(anim_time * secondsPerTick(tps) * sample_rate));
+    return clip.first_frame + std::min(frame, clip.frame_count - 1);
+}
@@ -1,8 +1,35 @@
 #include <limitless/models/skeletal_model.hpp>
 #include <stdexcept>
+#include <algorithm>
 
 using namespace Limitless;
 
+namespace {
+    /**
+     * Moves cursor to keyframe that starts segment containing time
+     *
+     * segment is never past the last one, so time after the last keyframe is clamped
+     */
+    template<typename T>
+    size_t advanceKeyframe(const std::vector<KeyFrame<T>>& keyframes, double anim_time, size_t cursor) noexcept {
+        if (cursor + 1 >= keyframes.size() || anim_time < keyframes[cursor].time) {
+            cursor = 0;
+        }
+
+        while (cursor + 2 < keyframes.size() && anim_time > keyframes[cursor + 1].time) {
+            ++cursor;
+        }
+
+        return cursor;
+    }
+
+    template<typename T>
+    float keyframeFactor(const KeyFrame<T>& a, const KeyFrame<T>& b, double anim_time) noexcept {
+        const auto dt = b.time - a.time;
+        return dt > 0.0 ? static_cast<float>(std::clamp((anim_time - a.time) / dt, 0.0, 1.0)) : 0.0f;
+    }
+}
+
 AnimationNode::AnimationNode(decltype(positions) _positions, decltype(rotations) _rotations, decltype(scales) _scales, Bone& _bone) noexcept
     : rotations(std::move(_rotations))
     , positions(std::move(_positions))
@@ -107,6 +134,157 @@ std::optional<glm::vec3> AnimationNode::scalingLerp(double anim_time) const {
     return glm::mix(a.data, b.data, norm);
 }
 
+std::optional<glm::vec3> AnimationNode::positionLerp(double anim_time, KeyframeCursor& cursor) const noexcept {
+    if (positions.empty()) {
+        return std::nullopt;
+    }
+
+    if (positions.size() == 1) {
+        return positions[0].data;
+    }
+
+    cursor.position = advanceKeyframe(positions, anim_time, cursor.position);
+    const auto& a = positions[cursor.position];
+    const auto& b = positions[cursor.position + 1];
+
+    const auto factor = keyframeFactor(a, b, anim_time);
+    return a.data * (1.0f - factor) + b.data * factor;
+}
+
+std::optional<glm::fquat> AnimationNode::rotationLerp(double anim_time, KeyframeCursor& cursor) const noexcept {
+    if (rotations.empty()) {
+        return std::nullopt;
+    }
+
+    if (rotations.size() == 1) {
+        return rotations[0].data;
+    }
+
+    cursor.rotation = advanceKeyframe(rotations, anim_time, cursor.rotation);
+    const auto& a = rotations[cursor.rotation];
+    const auto& b = rotations[cursor.rotation + 1];
+
+    return glm::normalize(glm::slerp(a.data, b.data, keyframeFactor(a, b, anim_time)));
+}
+
+std::optional<glm::vec3> AnimationNode::scalingLerp(double anim_time, KeyframeCursor& cursor) const noexcept {
+    if (scales.empty()) {
+        return std::nullopt;
+    }
+
+    if (scales.size() == 1) {
+        return scales[0].data;
+    }
+
+    cursor.scale = advanceKeyframe(scales, anim_time, cursor.scale);
+    const auto& a = scales[cursor.scale];
+    const auto& b = scales[cursor.scale + 1];
+
+    const auto factor = keyframeFactor(a, b, anim_time);
+    return a.data * (1.0f - factor) + b.data * factor;
+}
+
+Animation::Animation(std::string _name, double _duration, double _tps, decltype(nodes) _nodes)
+    : nodes(std::move(_nodes))
+    , name(std::move(_name))
+    , duration(_duration)
+    , tps(_tps) {
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        const auto bone_index = nodes[i].bone.index;
+        if (bone_index >= channels.size()) {
+            channels.resize(bone_index + 1, NO_CHANNEL);
+        }
+        channels[bone_index] = i;
+    }
+}
+
+void Animation::compress(const AnimationCompression& settings) {
+    compressed.emplace(*this, settings);
+
+    for (auto& node : nodes) {
+        decltype(node.positions) {}.swap(node.positions);
+        decltype(node.rotations) {}.swap(node.rotations);
+        decltype(node.scales) {}.swap(node.scales);
+    }
+}
+
+void SkeletalModel::evaluatePose(
+    const Animation& animation,
+    double anim_time,
+    std::vector<KeyframeCursor>& cursors,
+    std::vector<glm::mat4>& node_transform,
+    std::vector<glm::mat4>& bone_transform,
+    uint32_t max_depth
+) const noexcept {
+    std::optional<CompressedAnimation::Sample> sample;
+    if (animation.compressed) {
+        sample = animation.compressed->locate(anim_time);
+    }
+
+    for (size_t i = 0; i < skeleton.size(); ++i) {
+        const auto& node = skeleton[i];
+        const auto& bone = bones[node.bone];
+
+        auto local_transform = bone.node_transform;
+        const auto* channel = node.depth <= max_depth ? animation.findChannel(node.bone) : nullptr;
+        if (channel) {
+            const auto channel_index = animation.channels[node.bone];
+
+            glm::vec3 position;
+            glm::fquat rotation;
+            glm::vec3 scale;
+            if (sample) {
+                position = animation.compressed->position(channel_index, *sample).value_or(bone.position);
+                rotation = animation.compressed->rotation(channel_index, *sample).value_or(bone.rotation);
+                scale = animation.compressed->scale(channel_index, *sample).value_or(bone.scale);
+            } else {
+                auto& cursor = cursors[channel_index];
+                position = channel->positionLerp(anim_time, cursor).value_or(bone.position);
+                rotation = channel->rotationLerp(anim_time, cursor).value_or(bone.rotation);
+                scale = channel->scalingLerp(anim_time, cursor).value_or(bone.scale);
+            }
+
+            // same as translate * rotate * scale without matrix products
+            const auto rotate = glm::mat3_cast(rotation);
+            local_transform = glm::mat4 {
+                glm::vec4 {rotate[0] * scale.x, 0.0f},
+                glm::vec4 {rotate[1] * scale.y, 0.0f},
+                glm::vec4 {rotate[2] * scale.z, 0.0f},
+                glm::vec4 {position, 1.0f}
+            };
+        }
+
+        node_transform[i] = node.parent == SkeletonNode::NO_PARENT ? local_transform : node_transform[node.parent] * local_transform;
+
+        if (bone.joint_index) {
+            bone_transform[*bone.joint_index] = node_transform[i] * bone.offset_matrix;
+        }
+    }
+}
+
+void SkeletalModel::bakeAnimations(double sample_rate) {
+    baked_animations = std::make_shared<BakedAnimations>(*this, sample_rate);
+}
+
+void SkeletalModel::flattenSkeletons() {
+    skeleton.clear();
+    skeleton.reserve(bones.size());
+
+    // breadth first order keeps every parent before its children
+    std::vector<const Tree<uint32_t>*> trees;
+    for (const auto& tree : skeletons) {
+        skeleton.push_back({*tree, SkeletonNode::NO_PARENT, 0});
+        trees.push_back(&tree);
+    }
+
+    for (uint32_t i = 0; i < trees.size(); ++i) {
+        for (const auto& child : *trees[i]) {
+            skeleton.push_back({*child, i, skeleton[i].depth + 1});
+            trees.push_back(&child);
+        }
+    }
+}
+
 SkeletalModel::SkeletalModel(
     decltype(meshes)&& meshes,
     decltype(materials)&& materials,
@@ -121,4 +299,5 @@ SkeletalModel::SkeletalModel(
     , animations {std::move(_animations)}
     , bones {std::move(_bones)}
     , skeletons {std::move(_skeletons)} {
+    flattenSkeletons();
 }
@@ -251,6 +251,21 @@ bool Limitless::ms::operator<(const Material& lhs, const Material& rhs) noexcept
 }
 
 void Material::update() {
+    // bindless handles of replaced texture storage have to be mapped again
+    if (ContextInitializer::isBindlessTextureSupported()) {
+        for (auto& [_, property] : properties) {
+            if (property->getType() == UniformType::Sampler) {
+                static_cast<UniformSampler&>(*property).refresh(); //NOLINT
+            }
+        }
+
+        for (auto& [_, uniform] : uniforms) {
+            if (uniform->getType() == UniformType::Sampler) {
+                static_cast<UniformSampler&>(*uniform).refresh(); //NOLINT
+            }
+        }
+    }
+
     const auto properties_changed = std::any_of(properties.begin(), properties.end(), [] (auto& property) {
         return property.second->isChanged();
     });
@@ -6,6 +6,11 @@
 
 using namespace Limitless;
 
+namespace {
+    const UniformName DEPTH_TEXTURE {"depth_texture"};
+    const UniformName INFO_TEXTURE {"info_texture"};
+}
+
 DecalPass::DecalPass(Renderer& renderer)
     : RendererPass {renderer} {
 }
@@ -30,8 +35,8 @@ void DecalPass::render(
     });
 
     setter.add([&](ShaderProgram& shader){
-        shader.setUniform("depth_texture", gbuffer.getDepth());
-        shader.setUniform("info_texture", gbuffer.getInfo());
+        shader.setUniform(DEPTH_TEXTURE, gbuffer.getDepth());
+        shader.setUniform(INFO_TEXTURE, gbuffer.getInfo());
     });
 
     instance_renderer.renderDecals({ctx, assets, ShaderType::Decal, ms::Blending::Opaque, setter});
@@ -0,0 +1,114 @@
+#include <limitless/renderer/instance_batcher.hpp>
+
+#include <limitless/instances/model_instance.hpp>
+#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/core/uniform/uniform.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/ms/material.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+InstanceBatcher::InstanceBatcher() {
+    buffer = Buffer::builder()
+            .target(Buffer::Type::ShaderStorage)
+            .usage(Buffer::Usage::DynamicDraw)
+            .access(Buffer::MutableAccess::WriteOrphaning)
+            .size(sizeof(uint32_t) * 1024)
+            .build(BUFFER_NAME, *Context::getCurrentContext());
+}
+
+InstanceBatcher::~InstanceBatcher() {
+    if (auto* ctx = Context::getCurrentContext(); ctx) {
+        ctx->getIndexedBuffers().remove(BUFFER_NAME, buffer);
+    }
+}
+
+bool InstanceBatcher::isBatchable(const ms::Material& lhs, const ms::Material& rhs) noexcept {
+    if (&lhs == &rhs) {
+        return true;
+    }
+
+    if (lhs.getTwoSided() != rhs.getTwoSided()) {
+        return false;
+    }
+
+    // material buffer and samplers are made of these values
+    const auto equal = [] (const auto& a, const auto& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [] (const auto& l, const auto& r) {
+            return l.first == r.first && *l.second == *r.second;
+        });
+    };
+
+    return equal(lhs.getProperties(), rhs.getProperties()) && equal(lhs.getUniforms(), rhs.getUniforms());
+}
+
+void InstanceBatcher::add(ModelInstance& instance, MeshInstance& mesh) {
+    draws.push_back({&instance, &mesh, mesh.getMaterial()->getShaderIndex(), instance.getInstanceSlot()});
+}
+
+void InstanceBatcher::build() {
+    batches.clear();
+    slots.clear();
+
+    if (draws.empty()) {
+        return;
+    }
+
+    // draws that can be batched become neighbours
+    std::stable_sort(draws.begin(), draws.end(), [] (const Draw& lhs, const Draw& rhs) {
+        if (lhs.shader_index != rhs.shader_index) {
+            return lhs.shader_index < rhs.shader_index;
+        }
+        return lhs.mesh->getMesh().get() < rhs.mesh->getMesh().get();
+    });
+
+    slots.reserve(draws.size());
+
+    std::vector<Draw*> pending;
+    for (size_t begin = 0; begin < draws.size(); ) {
+        // run of draws with the same shader and mesh
+        auto end = begin + 1;
+        while (end < draws.size() && draws[end].shader_index == draws[begin].shader_index && draws[end].mesh->getMesh() == draws[begin].mesh->getMesh()) {
+            ++end;
+        }
+
+        // splits run by material values, most runs share one material
+        pending.clear();
+        for (auto i = begin; i < end; ++i) {
+            pending.emplace_back(&draws[i]);
+        }
+
+        while (!pending.empty()) {
+            const auto* leader = pending.front();
+            const auto offset = static_cast<uint32_t>(slots.size());
+
+            auto rest = std::stable_partition(pending.begin(), pending.end(), [&] (const Draw* draw) {
+                return isBatchable(*leader->mesh->getMaterial(), *draw->mesh->getMaterial());
+            });
+
+            for (auto it = pending.begin(); it != rest; ++it) {
+                slots.emplace_back((*it)->slot);
+            }
+
+            batches.push_back({leader->instance, leader->mesh, offset, static_cast<uint32_t>(slots.size()) - offset});
+
+            pending.erase(pending.begin(), rest);
+        }
+
+        begin = end;
+    }
+
+    const auto size = slots.size() * sizeof(uint32_t);
+    if (buffer->getSize() < size) {
+        buffer->resize(std::max(size, buffer->getSize() * 2));
+    }
+
+    buffer->mapData(slots.data(), size);
+}
+
+void InstanceBatcher::clear() noexcept {
+    draws.clear();
+    batches.clear();
+    slots.clear();
+}
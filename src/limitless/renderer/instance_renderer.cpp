@@ -2,7 +2,33 @@
 
 using namespace Limitless;
 
-void InstanceRenderer::setRenderState(const Instance& instance, const MeshInstance& mesh, const DrawParameters& drawp) {
+namespace {
+    const UniformName INSTANCE_INDEX {"instance_index"};
+    const UniformName BATCH_OFFSET {"batch_offset"};
+    const UniformName DECAL_VP {"decal_VP"};
+    const UniformName PROJECTION_MASK {"projection_mask"};
+    const UniformName BAKED_ANIMATION {"baked_animation"};
+
+    const BakedAnimations* findBakedAnimations(const Instance& instance) noexcept {
+        const SkeletalInstance* skeletal {};
+        switch (instance.getInstanceType()) {
+            case InstanceType::Skeletal:
+                skeletal = static_cast<const SkeletalInstance*>(&instance); //NOLINT
+                break;
+            case InstanceType::SkeletalInstanced: {
+                const auto& instances = static_cast<const SkeletalInstancedInstance&>(instance).getInstances(); //NOLINT
+                skeletal = instances.empty() ? nullptr : instances.front().get();
+                break;
+            }
+            default:
+                break;
+        }
+
+        return skeletal ? static_cast<const SkeletalModel&>(skeletal->getAbstractModel()).getBakedAnimations().get() : nullptr; //NOLINT
+    }
+}
+
+void InstanceRenderer::setRenderState(const Instance& instance, const MeshInstance& mesh, const DrawParameters& drawp, uint32_t batch_offset) {
     // sets culling based on two-sideness
     if (mesh.getMaterial()->getTwoSided()) {
         drawp.ctx.disable(Capabilities::CullFace);
@@ -22,11 +48,17 @@ void InstanceRenderer::setRenderState(const Instance& instance, const MeshInstan
     // gets required shader from storage
     auto& shader = drawp.assets.shaders.get(drawp.type, instance.getInstanceType(), mesh.getMaterial()->getShaderIndex());
 
-    instance.getInstanceBuffer()->bindBase(drawp.ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::UniformBuffer, "INSTANCE_BUFFER"));
-
+    // instance data is taken from global instance buffer by slot
     shader
+            .setUniform<uint32_t>(INSTANCE_INDEX, instance.getInstanceSlot())
+            .setUniform<uint32_t>(BATCH_OFFSET, batch_offset)
             .setMaterial(*mesh.getMaterial());
 
+    // baked instances read bone matrices by frame in bone offset
+    if (const auto* baked = findBakedAnimations(instance)) {
+        shader.setUniform(BAKED_ANIMATION, baked->getTexture());
+    }
+
     // sets custom pass-dependent uniforms
     drawp.setter(shader);
 
@@ -59,14 +91,106 @@ bool InstanceRenderer::shouldBeRendered(const Instance &instance, const DrawPara
 void InstanceRenderer::renderScene(const DrawParameters& drawp) {
     // renders common instances except decals
     // because decals rendered projected on everything else
-    for (const auto& instance: frustum_culling.getVisibleInstances()) {
-        renderVisible(*instance, drawp);
-    }
+    renderItems(drawp.blending == ms::Blending::Opaque ? queue.getOpaque() : queue.getTranslucent(), drawp, frustum_culling);
 
     // renders batched effect instances
     effect_renderer.draw(drawp.ctx, drawp.assets, drawp.type, drawp.blending, drawp.setter);
 }
 
+void InstanceRenderer::renderScene(const DrawParameters& drawp, const FrustumCulling& culling) {
+    view_queue.build(culling, camera_position, camera_far);
+
+    renderItems(drawp.blending == ms::Blending::Opaque ? view_queue.getOpaque() : view_queue.getTranslucent(), drawp, culling);
+
+    effect_renderer.draw(drawp.ctx, drawp.assets, drawp.type, drawp.blending, drawp.setter);
+}
+
+void InstanceRenderer::renderTranslucent(const DrawParameters& drawp) {
+    // blending is taken from materials, so order is kept between modes
+    for (const auto& item : queue.getTranslucent()) {
+        if (item.mesh->getMaterial()->getBlending() != ms::Blending::Text && shouldBeRendered(*item.instance, drawp)) {
+            renderItem(item, drawp, frustum_culling);
+        }
+    }
+
+    for (const auto blending : {ms::Blending::Additive, ms::Blending::Modulate, ms::Blending::Translucent}) {
+        effect_renderer.draw(drawp.ctx, drawp.assets, drawp.type, blending, drawp.setter);
+    }
+}
+
+void InstanceRenderer::renderItems(RenderQueue::Range items, const DrawParameters& drawp, const FrustumCulling& culling) {
+    // batching breaks back-to-front order and per instance uniforms
+    const auto batching = drawp.blending == ms::Blending::Opaque && drawp.isetter.empty();
+
+    for (const auto& item : items) {
+        if (item.mesh->getMaterial()->getBlending() != drawp.blending || !shouldBeRendered(*item.instance, drawp)) {
+            continue;
+        }
+
+        if (batching && item.instance->getInstanceType() == InstanceType::Model) {
+            batcher.add(static_cast<ModelInstance&>(*item.instance), *item.mesh); //NOLINT
+            continue;
+        }
+
+        renderItem(item, drawp, culling);
+    }
+
+    renderBatches(drawp);
+}
+
+void InstanceRenderer::renderItem(const RenderQueue::Item& item, const DrawParameters& drawp, const FrustumCulling& culling) {
+    auto& instance = *item.instance;
+    auto& mesh = *item.mesh;
+
+    switch (instance.getInstanceType()) {
+        // bones are taken from global bone buffer by offset of instance data
+        case InstanceType::Model:
+        case InstanceType::Skeletal:
+        case InstanceType::Terrain:
+            setRenderState(instance, mesh, drawp);
+            mesh.getMesh()->draw();
+            break;
+        case InstanceType::Instanced: {
+            auto& instanced = static_cast<InstancedInstance&>(instance); //NOLINT
+
+            // buffer is mapped only if visible subset has changed
+            instanced.setVisible(culling.getVisibleModelInstanced(instanced));
+            instanced.getBuffer()->bindBase(drawp.ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "model_buffer"));
+
+            setRenderState(instance, mesh, drawp);
+            mesh.getMesh()->draw_instanced(instanced.getVisibleInstances().size());
+            break;
+        }
+        case InstanceType::SkeletalInstanced: {
+            auto& instanced = static_cast<SkeletalInstancedInstance&>(instance); //NOLINT
+
+            // bones of visible instances are already in global bone buffer
+            instanced.setVisible(culling.getVisibleSkeletalInstanced(instanced));
+            instanced.getBuffer()->bindBase(drawp.ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "model_buffer"));
+
+            setRenderState(instance, mesh, drawp);
+            mesh.getMesh()->draw_instanced(instanced.getVisibleInstances().size());
+            break;
+        }
+        case InstanceType::Effect:
+        case InstanceType::Decal:
+            break;
+    }
+}
+
+void InstanceRenderer::renderBatches(const DrawParameters& drawp) {
+    batcher.build();
+
+    for (const auto& [instance, mesh, offset, count] : batcher.getBatches()) {
+        // state is set once for the whole batch
+        setRenderState(*instance, *mesh, drawp, offset);
+
+        mesh->getMesh()->draw_instanced(count);
+    }
+
+    batcher.clear();
+}
+
 void InstanceRenderer::renderDecals(const DrawParameters& drawp) {
     for (const auto& instance: frustum_culling.getVisibleInstances()) {
         if (instance->getInstanceType() == InstanceType::Decal) {
@@ -99,8 +223,6 @@ void InstanceRenderer::render(SkeletalInstance& instance, const DrawParameters&
         return;
     }
 
-    instance.getBoneBuffer()->bindBase(drawp.ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "bone_buffer"));
-
     for (const auto& [_, mesh]: instance.getMeshes()) {
         // skip mesh if blending is different
         if (mesh.getMaterial()->getBlending() != drawp.blending) {
@@ -113,8 +235,6 @@ void InstanceRenderer::render(SkeletalInstance& instance, const DrawParameters&
         // draw vertices
         mesh.getMesh()->draw();
     }
-
-    instance.getBoneBuffer()->fence();
 }
 
 void InstanceRenderer::render(DecalInstance& instance, const DrawParameters& drawp) {
@@ -130,12 +250,11 @@ void InstanceRenderer::render(DecalInstance& instance, const DrawParameters& dra
 
     auto& shader = drawp.assets.shaders.get(drawp.type, InstanceType::Decal, instance.getMaterial()->getShaderIndex());
 
-    instance.getInstanceBuffer()->bindBase(drawp.ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::UniformBuffer, "INSTANCE_BUFFER"));
-
     // updates model/material uniforms
     shader
-            .setUniform("decal_VP", glm::inverse(instance.getFinalMatrix()))
-            .setUniform<uint32_t>("projection_mask", instance.getProjectionMask())
+            .setUniform<uint32_t>(INSTANCE_INDEX, instance.getInstanceSlot())
+            .setUniform(DECAL_VP, glm::inverse(instance.getFinalMatrix()))
+            .setUniform<uint32_t>(PROJECTION_MASK, instance.getProjectionMask())
             .setMaterial(*instance.getMaterial());
 
     // sets custom pass-dependent uniforms
@@ -151,34 +270,22 @@ void InstanceRenderer::render(Instance& instance, const DrawParameters& drawp) {
         case InstanceType::Model: render(static_cast<ModelInstance&>(instance), drawp); break; //NOLINT
         case InstanceType::Skeletal: render(static_cast<SkeletalInstance&>(instance), drawp); break;//NOLINT
         case InstanceType::Instanced: render(static_cast<InstancedInstance&>(instance), drawp); break;//NOLINT
-        case InstanceType::SkeletalInstanced: break; //NOLINT
+        case InstanceType::SkeletalInstanced: render(static_cast<SkeletalInstancedInstance&>(instance), drawp); break; //NOLINT
         case InstanceType::Effect: break; //NOLINT
         case InstanceType::Decal: render(static_cast<DecalInstance&>(instance), drawp); break; //NOLINT
         case InstanceType::Terrain: render(static_cast<TerrainInstance&>(instance), drawp); break; //NOLINT
     }
 }
 
-void InstanceRenderer::renderVisibleInstancedInstance(InstancedInstance& instance, const DrawParameters& drawp) {
-    if (!shouldBeRendered(instance, drawp)) {
-        return;
-    }
-
-    // we should take shadow influencers from shadowmap too
-    // if drawp.type != Shadows
-    // set instanced subset (visible for current frame path)
-    instance.setVisible(frustum_culling.getVisibleModelInstanced(instance));
-
-    render(instance, drawp);
-}
-
-void InstanceRenderer::renderVisibleTerrain(TerrainInstance &instance, const DrawParameters &drawp) {
+void InstanceRenderer::render(InstancedInstance &instance, const DrawParameters &drawp) {
     if (!shouldBeRendered(instance, drawp)) {
         return;
     }
 
-    for (const auto& mref: frustum_culling.getVisibleTerrainMeshes(instance)) {
-        auto& mesh = mref.get();
+    // bind buffer for instanced data
+    instance.getBuffer()->bindBase(drawp.ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "model_buffer"));
 
+    for (const auto& [_, mesh]: instance.getInstances()[0]->getMeshes()) {
         // skip mesh if blending is different
         if (mesh.getMaterial()->getBlending() != drawp.blending) {
             return;
@@ -188,12 +295,12 @@ void InstanceRenderer::renderVisibleTerrain(TerrainInstance &instance, const Dra
         setRenderState(instance, mesh, drawp);
 
         // draw vertices
-        mesh.getMesh()->draw();
+        mesh.getMesh()->draw_instanced(instance.getVisibleInstances().size());
     }
 }
 
-void InstanceRenderer::render(InstancedInstance &instance, const DrawParameters &drawp) {
-    if (!shouldBeRendered(instance, drawp)) {
+void InstanceRenderer::render(SkeletalInstancedInstance& instance, const DrawParameters& drawp) {
+    if (!shouldBeRendered(instance, drawp) || instance.getInstances().empty()) {
         return;
     }
 
@@ -233,19 +340,13 @@ void InstanceRenderer::render(TerrainInstance &instance, const DrawParameters &d
     }
 }
 
-void InstanceRenderer::renderVisible(Instance &instance, const DrawParameters &drawp) {
-    switch (instance.getInstanceType()) {
-        case InstanceType::Model: render(static_cast<ModelInstance&>(instance), drawp); break; //NOLINT
-        case InstanceType::Skeletal: render(static_cast<SkeletalInstance&>(instance), drawp); break; //NOLINT
-        case InstanceType::Instanced: renderVisibleInstancedInstance(static_cast<InstancedInstance&>(instance), drawp); break; //NOLINT
-        case InstanceType::SkeletalInstanced: break; //NOLINT
-        case InstanceType::Effect: break; //NOLINT
-        case InstanceType::Decal: break; //NOLINT
-        case InstanceType::Terrain: renderVisibleTerrain(static_cast<TerrainInstance&>(instance), drawp); break; //NOLINT
-    }
-}
-
-void InstanceRenderer::update(Scene& scene, Camera& camera) {
+void InstanceRenderer::update(Scene& scene, Camera& camera, const Assets& assets) {
     frustum_culling.update(scene, camera);
-    effect_renderer.update(frustum_culling.getVisibleInstances());
+    effect_renderer.update(assets, frustum_culling.getVisibleInstances());
+
+    camera_position = camera.getPosition();
+    camera_far = camera.getFar();
+
+    // shared by all passes of the frame
+    queue.build(frustum_culling, camera_position, camera_far);
 }
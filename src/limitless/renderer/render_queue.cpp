@@ -0,0 +1,100 @@
+#include <limitless/renderer/render_queue.hpp>
+
+#include <limitless/instances/instanced_instance.hpp>
+#include <limitless/instances/skeletal_instanced_instance.hpp>
+#include <limitless/instances/terrain_instance.hpp>
+#include <limitless/util/frustum_culling.hpp>
+#include <limitless/util/radix_sort.hpp>
+#include <limitless/ms/material.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+namespace {
+    constexpr uint64_t bits(uint64_t value, uint32_t count, uint32_t shift) noexcept {
+        return (value & ((uint64_t{1} << count) - 1)) << shift;
+    }
+}
+
+uint64_t RenderQueue::makeKey(Instance& instance, const MeshInstance& mesh) const noexcept {
+    const auto& material = *mesh.getMaterial();
+
+    const auto distance = glm::distance(origin, instance.getBoundingBox().center);
+    const auto depth = static_cast<uint64_t>(glm::clamp(distance / max_distance, 0.0f, 1.0f) * static_cast<float>((1 << 24) - 1));
+
+    const auto type = static_cast<uint64_t>(instance.getInstanceType());
+    const auto shader = material.getShaderIndex();
+    // meshes are aligned, low bits are always zero
+    const auto mesh_id = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(mesh.getMesh().get()) >> 4); //NOLINT
+
+    if (material.getBlending() == ms::Blending::Opaque) {
+        return bits(type, 3, 60) | bits(shader, 16, 44) | bits(mesh_id, 20, 24) | bits(depth, 24, 0);
+    }
+
+    return TRANSLUCENT_BUCKET
+           | bits((1 << 24) - 1 - depth, 24, 39)
+           | bits(static_cast<uint64_t>(material.getBlending()), 3, 36)
+           | bits(type, 3, 33)
+           | bits(shader, 16, 17)
+           | bits(mesh_id, 17, 0);
+}
+
+void RenderQueue::add(Instance& instance, MeshInstance& mesh) {
+    items.push_back({makeKey(instance, mesh), &instance, &mesh});
+}
+
+void RenderQueue::build(const FrustumCulling& culling, const glm::vec3& _origin, float _max_distance) {
+    origin = _origin;
+    max_distance = std::max(_max_distance, 1.0f);
+
+    items.clear();
+
+    for (const auto& instance : culling.getVisibleInstances()) {
+        switch (instance->getInstanceType()) {
+            case InstanceType::Model:
+            case InstanceType::Skeletal:
+                for (auto& [_, mesh] : static_cast<ModelInstance&>(*instance).getMeshes()) { //NOLINT
+                    add(*instance, mesh);
+                }
+                break;
+            case InstanceType::Instanced: {
+                auto& instanced = static_cast<InstancedInstance&>(*instance); //NOLINT
+                if (instanced.getInstances().empty()) {
+                    break;
+                }
+
+                // all instanced models share meshes of the first one
+                for (auto& [_, mesh] : instanced.getInstances()[0]->getMeshes()) {
+                    add(*instance, mesh);
+                }
+                break;
+            }
+            case InstanceType::SkeletalInstanced: {
+                auto& instanced = static_cast<SkeletalInstancedInstance&>(*instance); //NOLINT
+                if (instanced.getInstances().empty()) {
+                    break;
+                }
+
+                // all instances share meshes of the same model
+                for (auto& [_, mesh] : instanced.getInstances()[0]->getMeshes()) {
+                    add(*instance, mesh);
+                }
+                break;
+            }
+            case InstanceType::Terrain:
+                for (const auto& mesh : culling.getVisibleTerrainMeshes(static_cast<TerrainInstance&>(*instance))) { //NOLINT
+                    add(*instance, mesh.get());
+                }
+                break;
+            case InstanceType::Effect:
+            case InstanceType::Decal:
+                break;
+        }
+    }
+
+    radixSort(items, scratch, [] (const Item& item) { return item.key; });
+
+    translucent_begin = std::lower_bound(items.begin(), items.end(), TRANSLUCENT_BUCKET, [] (const Item& item, uint64_t key) {
+        return item.key < key;
+    }) - items.begin();
+}
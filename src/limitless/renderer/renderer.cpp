@@ -29,7 +29,7 @@
 using namespace Limitless;
 
 void Renderer::render(Context& context, const Assets& assets, Scene& scene, Camera& camera) {
-    instance_renderer.update(scene, camera);
+    instance_renderer.update(scene, camera, assets);
 
     for (const auto& pass: passes) {
         pass->update(scene, camera);
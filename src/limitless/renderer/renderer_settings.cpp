@@ -90,6 +90,8 @@ RendererSettings RendererSettings::Builder::build() {
     settings.specular_aa_threshold = specular_threshold;
     settings.specular_aa_variance = specular_variance;
 
+    settings.shader_cache_directory = shader_cache;
+
     settings.light_radius = light_radius;
     settings.coordinate_system_axes = coordinate_system_axes;
     settings.bounding_box = bounding_box;
@@ -192,6 +194,11 @@ RendererSettings::Builder &RendererSettings::Builder::specular_aa_variance(float
     return *this;
 }
 
+RendererSettings::Builder &RendererSettings::Builder::shader_cache_directory(fs::path directory) {
+    shader_cache = std::move(directory);
+    return *this;
+}
+
 RendererSettings::Builder &RendererSettings::Builder::debug_light_radius() {
     light_radius = true;
     return *this;
@@ -1,6 +1,9 @@
 #include <limitless/renderer/sceneupdate_pass.hpp>
 
 #include <limitless/scene.hpp>
+#include <limitless/instances/instance_buffer.hpp>
+#include <limitless/instances/bone_buffer.hpp>
+#include <limitless/core/context.hpp>
 
 using namespace Limitless;
 
@@ -12,6 +15,10 @@ SceneUpdatePass::SceneUpdatePass(Renderer& renderer)
 void SceneUpdatePass::update(Scene &scene, const Camera &camera) {
     scene.update(camera);
     scene_data.update(camera);
+
+    // instances have written their changes, uploads them at once
+    InstanceBuffer::get().upload(*Context::getCurrentContext());
+    BoneBuffer::get().upload(*Context::getCurrentContext());
 }
 
 void SceneUpdatePass::onFramebufferChange(glm::uvec2 size) {
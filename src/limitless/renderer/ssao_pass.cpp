@@ -19,6 +19,10 @@
 
 using namespace Limitless;
 
+namespace {
+    const UniformName SSAO_TEXTURE {"_ssao_texture"};
+}
+
 SSAOPass::SSAOPass(Renderer& renderer)
     : RendererPass {renderer}
     , ssao {renderer} {
@@ -40,7 +44,7 @@ void SSAOPass::update(Scene &scene, const Camera &camera) {
 
 void SSAOPass::addUniformSetter(UniformSetter &setter) {
     setter.add([&](ShaderProgram& shader){
-        shader.setUniform("_ssao_texture", getResult());
+        shader.setUniform(SSAO_TEXTURE, getResult());
     });
 }
 
@@ -19,6 +19,11 @@
 
 using namespace Limitless;
 
+namespace {
+    const UniformName SSR_TEXTURE {"_ssr_texture"};
+    const UniformName SSR_STRENGTH {"_ssr_strength"};
+}
+
 SSRPass::SSRPass(Renderer& renderer)
     : RendererPass(renderer)
     , ssr {renderer} {
@@ -40,8 +45,8 @@ void SSRPass::onFramebufferChange(glm::uvec2 size) {
 //
 void SSRPass::addUniformSetter(UniformSetter &setter) {
     setter.add([&](ShaderProgram& shader){
-        shader.setUniform("_ssr_texture", getResult());
-        shader.setUniform("_ssr_strength", 1.0f);
+        shader.setUniform(SSR_TEXTURE, getResult());
+        shader.setUniform(SSR_STRENGTH, 1.0f);
     });
 
     ssr.addSetter(setter);
@@ -0,0 +1,32 @@
+#include <limitless/renderer/texture_streaming_pass.hpp>
+
+#include <limitless/loaders/texture_streamer.hpp>
+#include <limitless/renderer/renderer.hpp>
+#include <limitless/instances/mesh_instance.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/camera.hpp>
+
+using namespace Limitless;
+
+TextureStreamingPass::TextureStreamingPass(Renderer& renderer, TextureStreamer& _streamer)
+    : RendererPass {renderer}
+    , streamer {_streamer} {
+}
+
+void TextureStreamingPass::update([[maybe_unused]] Scene& scene, const Camera& camera) {
+    // pixels per world unit at distance of one
+    const auto scale = static_cast<float>(renderer.getResolution().y) / std::tan(glm::radians(camera.getFov()) * 0.5f);
+
+    for (const auto& item : renderer.getInstanceRenderer().getRenderQueue().getItems()) {
+        const auto& box = item.instance->getBoundingBox();
+        const auto radius = glm::length(box.size) * 0.5f;
+        const auto distance = std::max(glm::distance(box.center, camera.getPosition()) - radius, 0.0f);
+
+        // camera inside of bounding box sees it at full screen
+        const auto screen_size = distance > 0.0f ? scale * radius / distance : scale;
+
+        streamer.request(*item.mesh->getMaterial(), screen_size);
+    }
+
+    streamer.update();
+}
@@ -16,6 +16,10 @@
 
 using namespace Limitless;
 
+namespace {
+    const UniformName REFRACTION_TEXTURE {"_refraction_texture"};
+}
+
 TranslucentPass::TranslucentPass(Renderer& renderer)
     : RendererPass {renderer}
     , framebuffer {Framebuffer::asRGB16FNearestClampToEdgeWithDepth(renderer.getResolution(), renderer.getPass<DeferredFramebufferPass>().getDepth())} {
@@ -29,12 +33,6 @@ void TranslucentPass::render(
         [[maybe_unused]] const Camera &camera,
         UniformSetter &setter) {
 
-    std::array transparent = {
-        ms::Blending::Additive,
-        ms::Blending::Modulate,
-        ms::Blending::Translucent
-    };
-
     auto& background_fb = renderer.getPass<DeferredLightingPass>().getFramebuffer();
 
     framebuffer.blit(background_fb, Texture::Filter::Nearest);
@@ -42,12 +40,11 @@ void TranslucentPass::render(
     framebuffer.bind();
 
     setter.add([&] (ShaderProgram& shader) {
-        shader.setUniform("_refraction_texture", renderer.getPass<DeferredLightingPass>().getResult());
+        shader.setUniform(REFRACTION_TEXTURE, renderer.getPass<DeferredLightingPass>().getResult());
     });
 
-    for (const auto& blending : transparent) {
-        instance_renderer.renderScene({ctx, assets, ShaderType::Forward, blending, setter});
-    }
+    // sorted back to front across all blending modes
+    instance_renderer.renderTranslucent({ctx, assets, ShaderType::Forward, ms::Blending::Translucent, setter});
 }
 
 std::shared_ptr<Texture> TranslucentPass::getResult() {
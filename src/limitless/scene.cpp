@@ -1,6 +1,9 @@
 #include <limitless/scene.hpp>
 #include <limitless/instances/skeletal_instance.hpp>
+#include <limitless/instances/skeletal_instanced_instance.hpp>
 #include <limitless/assets.hpp>
+#include <limitless/util/thread_pool.hpp>
+#include <algorithm>
 
 using namespace Limitless;
 
@@ -8,9 +11,14 @@ Scene::Scene(Context& context)
     : lighting {context} {
 }
 
+Scene::~Scene() {
+    removeAll();
+}
+
 void Scene::removeDeadInstances() noexcept {
     for (auto it = instances.cbegin(); it != instances.cend(); ) {
         if (it->second->isKilled()) {
+            untrack(*it->second);
             it = instances.erase(it);
         } else {
             ++it;
@@ -19,7 +27,10 @@ void Scene::removeDeadInstances() noexcept {
 }
 
 void Scene::add(const std::shared_ptr<Instance>& instance) {
-    instances.emplace(instance->getId(), instance);
+    // indexed right away to be culled before next update
+    if (instances.emplace(instance->getId(), instance).second) {
+        track(instance);
+    }
 }
 
 void Scene::remove(const std::shared_ptr<Instance>& instance) {
@@ -27,11 +38,156 @@ void Scene::remove(const std::shared_ptr<Instance>& instance) {
 }
 
 void Scene::remove(uint64_t id) {
-    instances.erase(id);
+    if (auto found = instances.find(id); found != instances.end()) {
+        untrack(*found->second);
+        instances.erase(found);
+    }
 }
 
 void Scene::removeAll() {
+    for (auto& [_, proxy] : spatial_proxies) {
+        proxy.instance->setObserver(nullptr);
+    }
+
     instances.clear();
+    spatial_index.clear();
+    spatial_proxies.clear();
+    spatial_changes.clear();
+    compound_instances.clear();
+}
+
+void Scene::track(const std::shared_ptr<Instance>& instance) {
+    auto [found, inserted] = spatial_proxies.emplace(instance->getId(), SpatialProxy {instance});
+    if (!inserted) {
+        return;
+    }
+
+    // observer is set after indexing, so box computed here is not reported back
+    index(found->second);
+    instance->setObserver(this);
+
+    for (const auto& [_, attachment] : instance->getAttachments()) {
+        track(attachment);
+    }
+}
+
+void Scene::untrack(Instance& instance) {
+    instance.setObserver(nullptr);
+
+    if (auto found = spatial_proxies.find(instance.getId()); found != spatial_proxies.end()) {
+        auto& proxy = found->second;
+
+        if (proxy.proxy != AABBTree::NULL_NODE) {
+            spatial_index.remove(proxy.proxy);
+        }
+
+        if (proxy.compound) {
+            compound_instances.erase(std::find(compound_instances.begin(), compound_instances.end(), proxy.instance));
+        }
+
+        spatial_proxies.erase(found);
+    }
+
+    for (const auto& [_, attachment] : instance.getAttachments()) {
+        untrack(*attachment);
+    }
+}
+
+void Scene::index(SpatialProxy& proxy) {
+    auto& instance = *proxy.instance;
+    const auto visible = !instance.isHidden() && !instance.isKilled();
+    const auto type = instance.getInstanceType();
+
+    if (type == InstanceType::Instanced || type == InstanceType::SkeletalInstanced || type == InstanceType::Terrain) {
+        if (visible && !proxy.compound) {
+            compound_instances.emplace_back(proxy.instance);
+        } else if (!visible && proxy.compound) {
+            compound_instances.erase(std::find(compound_instances.begin(), compound_instances.end(), proxy.instance));
+        }
+        proxy.compound = visible;
+        return;
+    }
+
+    if (!visible) {
+        if (proxy.proxy != AABBTree::NULL_NODE) {
+            spatial_index.remove(proxy.proxy);
+            proxy.proxy = AABBTree::NULL_NODE;
+        }
+        return;
+    }
+
+    const auto& box = instance.getBoundingBox();
+
+    if (proxy.proxy == AABBTree::NULL_NODE) {
+        proxy.proxy = spatial_index.insert(box, instance.getId());
+    } else {
+        spatial_index.update(proxy.proxy, box);
+    }
+}
+
+void Scene::updateSpatialIndex() {
+    // changed flag is cleared after indexing, so instance reporting itself while indexed is not queued twice
+    for (size_t i = 0; i < spatial_changes.size(); ++i) {
+        if (auto found = spatial_proxies.find(spatial_changes[i]); found != spatial_proxies.end()) {
+            index(found->second);
+            found->second.changed = false;
+        }
+    }
+
+    spatial_changes.clear();
+}
+
+void Scene::onInstanceChanged(Instance& instance) {
+    if (auto found = spatial_proxies.find(instance.getId()); found != spatial_proxies.end() && !found->second.changed) {
+        found->second.changed = true;
+        spatial_changes.emplace_back(instance.getId());
+    }
+}
+
+void Scene::onInstanceAttached(const std::shared_ptr<Instance>& instance) {
+    track(instance);
+}
+
+void Scene::onInstanceDetached(Instance& instance) {
+    untrack(instance);
+}
+
+void Scene::query(const Frustum& frustum, Instances& result) const {
+    spatial_index.query(frustum, [&] (uint64_t id) {
+        result.emplace_back(spatial_proxies.at(id).instance);
+    });
+}
+
+Instances Scene::query(const Box& box) const {
+    Instances result;
+    spatial_index.query(box, [&] (uint64_t id) {
+        result.emplace_back(spatial_proxies.at(id).instance);
+    });
+    return result;
+}
+
+Instances Scene::query(const glm::vec3& center, float radius) const {
+    Instances result;
+    spatial_index.query(center, radius, [&] (uint64_t id) {
+        result.emplace_back(spatial_proxies.at(id).instance);
+    });
+    return result;
+}
+
+Instances Scene::raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance) const {
+    std::vector<std::pair<float, uint64_t>> hits;
+    spatial_index.raycast(origin, glm::normalize(direction), max_distance, [&] (uint64_t id, float distance) {
+        hits.emplace_back(distance, id);
+    });
+
+    std::sort(hits.begin(), hits.end());
+
+    Instances result;
+    result.reserve(hits.size());
+    for (const auto& [_, id] : hits) {
+        result.emplace_back(spatial_proxies.at(id).instance);
+    }
+    return result;
 }
 
 std::shared_ptr<Instance> Scene::getInstance(uint64_t id) {
@@ -109,22 +265,82 @@ void Scene::setSkybox(const std::shared_ptr<Skybox>& skybox_) {
     skybox = skybox_;
 }
 
-void Scene::update(const Camera& camera) {
-    lighting.update();
-
-    removeDeadInstances();
+void Scene::updateEffects(const Camera& camera, const FrameClock& frame_clock) {
+    updated_effects.clear();
+    updated_emitters.clear();
 
     for (auto& [_, instance] : instances) {
         if (instance->getInstanceType() != InstanceType::Effect) {
-            instance->update(camera);
+            continue;
+        }
+
+        auto& effect = static_cast<EffectInstance&>(*instance); //NOLINT
+        effect.beginUpdate(camera);
+
+        for (auto& [_, emitter] : effect.getEmitters()) {
+            // beam emitters need current context which is bound only to calling thread
+            if (emitter->getType() == fx::AbstractEmitter::Type::Beam) {
+                emitter->update(camera, frame_clock);
+            } else {
+                updated_emitters.emplace_back(emitter.get());
+            }
         }
+
+        updated_effects.emplace_back(&effect);
     }
 
+    // emitters are independent, large ones are split further into particle ranges
+    ThreadPool::getShared().parallelFor(updated_emitters.size(), 1, [&] (size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            updated_emitters[i]->update(camera, frame_clock);
+        }
+    });
+
+    for (auto* effect : updated_effects) {
+        effect->finishUpdate();
+    }
+}
+
+void Scene::updateSkeletals(const Camera& camera, const FrameClock& frame_clock) {
+    updated_skeletals.clear();
+
     for (auto& [_, instance] : instances) {
-        if (instance->getInstanceType() == InstanceType::Effect) {
+        if (instance->getInstanceType() == InstanceType::Skeletal) {
+            updated_skeletals.emplace_back(static_cast<SkeletalInstance*>(instance.get())); //NOLINT
+        } else if (instance->getInstanceType() == InstanceType::SkeletalInstanced) {
+            for (const auto& skeletal : static_cast<SkeletalInstancedInstance&>(*instance).getInstances()) { //NOLINT
+                updated_skeletals.emplace_back(skeletal.get());
+            }
+        }
+    }
+
+    pose_cache.update(updated_skeletals, camera, frame_clock);
+}
+
+void Scene::update(const Camera& camera) {
+    clock.tick();
+
+    update(camera, clock);
+}
+
+void Scene::update(const Camera& camera, const FrameClock& frame_clock) {
+    FrameClock::publish(frame_clock);
+
+    lighting.update(camera);
+
+    removeDeadInstances();
+
+    updateSkeletals(camera, frame_clock);
+
+    for (auto& [_, instance] : instances) {
+        if (instance->getInstanceType() != InstanceType::Effect) {
             instance->update(camera);
         }
     }
+
+    updateEffects(camera, frame_clock);
+
+    updateSpatialIndex();
 }
 
 Instances Scene::getInstances() const noexcept {
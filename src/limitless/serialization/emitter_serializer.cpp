@@ -25,7 +25,8 @@ ByteBuffer EmitterSerializer::serialize(const AbstractEmitter& emitter) {
            << emitter.getLocalRotation()
            << emitter.getLocalSpace()
            << emitter.getSpawn()
-           << emitter.getDuration().count();
+           << emitter.getDuration().count()
+           << emitter.getGpuSimulation();
 
     switch (emitter.getType()) {
         case AbstractEmitter::Type::Sprite: {
@@ -60,6 +61,7 @@ void EmitterSerializer::deserialize(Assets& assets, ByteBuffer& buffer, EffectBu
     bool local_space;
     EmitterSpawn spawn;
     float duration;
+    bool gpu_simulation {false};
     std::shared_ptr<ms::Material> material;
 
     buffer >> name;
@@ -68,7 +70,8 @@ void EmitterSerializer::deserialize(Assets& assets, ByteBuffer& buffer, EffectBu
 
     buffer >> version;
 
-    if (version != VERSION) {
+    // emitters of the first version have no GPU simulation flag
+    if (version != VERSION && version != 0x1) {
         throw std::runtime_error("Wrong emitter serializer version! " + std::to_string(VERSION) + " vs " + std::to_string(version));
     }
 
@@ -77,8 +80,13 @@ void EmitterSerializer::deserialize(Assets& assets, ByteBuffer& buffer, EffectBu
            >> local_rotation
            >> local_space
            >> spawn
-           >> duration
-           >> AssetDeserializer<std::shared_ptr<ms::Material>>{assets, material};
+           >> duration;
+
+    if (version != 0x1) {
+        buffer >> gpu_simulation;
+    }
+
+    buffer >> AssetDeserializer<std::shared_ptr<ms::Material>>{assets, material};
 
     switch (type) {
         case AbstractEmitter::Type::Sprite: {
@@ -115,6 +123,7 @@ void EmitterSerializer::deserialize(Assets& assets, ByteBuffer& buffer, EffectBu
     builder .setLocalPosition(local_position)
             .setLocalRotation(local_rotation)
             .setLocalSpace(local_space)
+            .setGpuSimulation(gpu_simulation)
             .setSpawn(std::move(spawn))
             .setDuration(std::chrono::duration<float>{duration})
             .setMaterial(material);
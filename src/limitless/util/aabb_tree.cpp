@@ -0,0 +1,270 @@
+#include <limitless/util/aabb_tree.hpp>
+
+#include <algorithm>
+
+using namespace Limitless;
+
+AABBTree::AABBTree(float _margin) noexcept
+    : margin {_margin} {
+}
+
+int32_t AABBTree::allocateNode() {
+    if (free_list == NULL_NODE) {
+        nodes.emplace_back();
+        return static_cast<int32_t>(nodes.size() - 1);
+    }
+
+    const auto node = free_list;
+    free_list = nodes[node].parent;
+    nodes[node] = Node {};
+    return node;
+}
+
+void AABBTree::freeNode(int32_t node) noexcept {
+    nodes[node].parent = free_list;
+    nodes[node].height = -1;
+    free_list = node;
+}
+
+int32_t AABBTree::insert(const Box& box, uint64_t user) {
+    const auto proxy = allocateNode();
+    const auto half = glm::abs(box.size) * 0.5f;
+
+    auto& node = nodes[proxy];
+    node.min = box.center - half - glm::vec3{margin};
+    node.max = box.center + half + glm::vec3{margin};
+    node.user = user;
+    node.height = 0;
+
+    insertLeaf(proxy);
+    ++leaf_count;
+
+    return proxy;
+}
+
+void AABBTree::remove(int32_t proxy) {
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --leaf_count;
+}
+
+bool AABBTree::update(int32_t proxy, const Box& box) {
+    const auto half = glm::abs(box.size) * 0.5f;
+    const auto min = box.center - half;
+    const auto max = box.center + half;
+
+    auto& node = nodes[proxy];
+
+    // still inside of enlarged box
+    if (glm::all(glm::lessThanEqual(node.min, min)) && glm::all(glm::greaterThanEqual(node.max, max))) {
+        return false;
+    }
+
+    removeLeaf(proxy);
+
+    node.min = min - glm::vec3{margin};
+    node.max = max + glm::vec3{margin};
+
+    insertLeaf(proxy);
+
+    return true;
+}
+
+void AABBTree::clear() noexcept {
+    nodes.clear();
+    root = NULL_NODE;
+    free_list = NULL_NODE;
+    leaf_count = 0;
+}
+
+Box AABBTree::getBox(int32_t proxy) const {
+    const auto& node = nodes.at(proxy);
+    return { (node.min + node.max) * 0.5f, node.max - node.min };
+}
+
+Box AABBTree::getBounds() const noexcept {
+    if (root == NULL_NODE) {
+        return { glm::vec3{0.0f}, glm::vec3{0.0f} };
+    }
+
+    const auto& node = nodes[root];
+    return { (node.min + node.max) * 0.5f, node.max - node.min };
+}
+
+void AABBTree::refit(int32_t index) {
+    // walks up fixing heights and boxes
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        auto& node = nodes[index];
+        const auto& left = nodes[node.left];
+        const auto& right = nodes[node.right];
+
+        node.height = 1 + std::max(left.height, right.height);
+        node.min = glm::min(left.min, right.min);
+        node.max = glm::max(left.max, right.max);
+
+        index = node.parent;
+    }
+}
+
+void AABBTree::insertLeaf(int32_t leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // finds the best sibling by surface area heuristic
+    const auto leaf_min = nodes[leaf].min;
+    const auto leaf_max = nodes[leaf].max;
+
+    auto index = root;
+    while (!nodes[index].isLeaf()) {
+        const auto& node = nodes[index];
+
+        const auto node_area = area(node.min, node.max);
+        const auto combined_area = area(glm::min(node.min, leaf_min), glm::max(node.max, leaf_max));
+
+        // cost of creating new parent for this node and the new leaf
+        const auto cost = 2.0f * combined_area;
+        // minimum cost of pushing the leaf further down the tree
+        const auto inheritance_cost = 2.0f * (combined_area - node_area);
+
+        const auto child_cost = [&] (int32_t child_index) {
+            const auto& child = nodes[child_index];
+            const auto enlarged = area(glm::min(child.min, leaf_min), glm::max(child.max, leaf_max));
+            return child.isLeaf() ? enlarged + inheritance_cost : enlarged - area(child.min, child.max) + inheritance_cost;
+        };
+
+        const auto left_cost = child_cost(node.left);
+        const auto right_cost = child_cost(node.right);
+
+        if (cost < left_cost && cost < right_cost) {
+            break;
+        }
+
+        index = left_cost < right_cost ? node.left : node.right;
+    }
+
+    const auto sibling = index;
+
+    // creates new parent
+    const auto old_parent = nodes[sibling].parent;
+    const auto new_parent = allocateNode();
+
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].min = glm::min(leaf_min, nodes[sibling].min);
+    nodes[new_parent].max = glm::max(leaf_max, nodes[sibling].max);
+    nodes[new_parent].height = nodes[sibling].height + 1;
+    nodes[new_parent].left = sibling;
+    nodes[new_parent].right = leaf;
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    if (old_parent != NULL_NODE) {
+        if (nodes[old_parent].left == sibling) {
+            nodes[old_parent].left = new_parent;
+        } else {
+            nodes[old_parent].right = new_parent;
+        }
+    } else {
+        root = new_parent;
+    }
+
+    refit(nodes[leaf].parent);
+}
+
+void AABBTree::removeLeaf(int32_t leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    const auto parent = nodes[leaf].parent;
+    const auto grand_parent = nodes[parent].parent;
+    const auto sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    if (grand_parent != NULL_NODE) {
+        // replaces parent with sibling
+        if (nodes[grand_parent].left == parent) {
+            nodes[grand_parent].left = sibling;
+        } else {
+            nodes[grand_parent].right = sibling;
+        }
+        nodes[sibling].parent = grand_parent;
+        freeNode(parent);
+
+        refit(grand_parent);
+    } else {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+int32_t AABBTree::balance(int32_t a) {
+    // performs left or right rotation if node a is imbalanced, returns new root of subtree
+    if (nodes[a].isLeaf() || nodes[a].height < 2) {
+        return a;
+    }
+
+    const auto b = nodes[a].left;
+    const auto c = nodes[a].right;
+    const auto difference = nodes[c].height - nodes[b].height;
+
+    const auto rotate = [&] (int32_t up, int32_t other, bool up_is_right) {
+        const auto f = nodes[up].left;
+        const auto g = nodes[up].right;
+
+        // swaps a and up
+        nodes[up].left = a;
+        nodes[up].parent = nodes[a].parent;
+        nodes[a].parent = up;
+
+        if (nodes[up].parent != NULL_NODE) {
+            auto& up_parent = nodes[nodes[up].parent];
+            if (up_parent.left == a) {
+                up_parent.left = up;
+            } else {
+                up_parent.right = up;
+            }
+        } else {
+            root = up;
+        }
+
+        // higher child of up stays with it, lower one goes to a
+        const auto stay = nodes[f].height > nodes[g].height ? f : g;
+        const auto move = stay == f ? g : f;
+
+        nodes[up].right = stay;
+        if (up_is_right) {
+            nodes[a].right = move;
+        } else {
+            nodes[a].left = move;
+        }
+        nodes[move].parent = a;
+
+        nodes[a].min = glm::min(nodes[other].min, nodes[move].min);
+        nodes[a].max = glm::max(nodes[other].max, nodes[move].max);
+        nodes[a].height = 1 + std::max(nodes[other].height, nodes[move].height);
+
+        nodes[up].min = glm::min(nodes[a].min, nodes[stay].min);
+        nodes[up].max = glm::max(nodes[a].max, nodes[stay].max);
+        nodes[up].height = 1 + std::max(nodes[a].height, nodes[stay].height);
+
+        return up;
+    };
+
+    // rotates c up
+    if (difference > 1) {
+        return rotate(c, b, true);
+    }
+
+    // rotates b up
+    if (difference < -1) {
+        return rotate(b, c, false);
+    }
+
+    return a;
+}
@@ -0,0 +1,30 @@
+#include <limitless/util/frame_clock.hpp>
+
+using namespace Limitless;
+
+FrameClock::FrameClock() noexcept
+    : time {clock::now()} {
+}
+
+FrameClock::FrameClock(duration _fixed_step) noexcept
+    : time {clock::now()}
+    , fixed_step {_fixed_step} {
+}
+
+void FrameClock::tick() noexcept {
+    if (fixed_step) {
+        tick(*fixed_step);
+        return;
+    }
+
+    const auto now = clock::now();
+    delta = now - time;
+    time = now;
+    ++frame;
+}
+
+void FrameClock::tick(duration _delta) noexcept {
+    delta = _delta;
+    time += std::chrono::duration_cast<clock::duration>(_delta);
+    ++frame;
+}
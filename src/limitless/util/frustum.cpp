@@ -1,6 +1,15 @@
 #include <limitless/util/frustum.hpp>
 #include <limitless/renderer/shader_type.hpp>
 
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define LIMITLESS_FRUSTUM_AVX
+    #define LIMITLESS_FRUSTUM_SSE
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define LIMITLESS_FRUSTUM_SSE
+#endif
+
 using namespace Limitless;
 
 template<Frustum::Planes i, Frustum::Planes j>
@@ -92,6 +101,114 @@ Frustum Frustum::fromCamera(const Camera& camera) {
     return Frustum {camera.getProjection() * camera.getView()};
 }
 
+Frustum Frustum::fromMatrix(const glm::mat4& matrix) {
+    return Frustum {matrix};
+}
+
 bool Frustum::intersects(Instance& instance) const {
     return intersects(instance.getBoundingBox());
 }
+
+Frustum::Intersection Frustum::classify(const glm::vec3& min, const glm::vec3& max) const noexcept {
+    const auto center = (min + max) * 0.5f;
+    const auto extent = (max - min) * 0.5f;
+
+    auto result = Intersection::Inside;
+    for (const auto& plane : planes) {
+        const auto distance = glm::dot(glm::vec3(plane), center) + plane.w;
+        const auto radius = glm::dot(glm::abs(glm::vec3(plane)), extent);
+
+        if (distance + radius < 0.0f) {
+            return Intersection::Outside;
+        }
+
+        if (distance - radius < 0.0f) {
+            result = Intersection::Intersects;
+        }
+    }
+
+    return result;
+}
+
+void Frustum::intersects(const BoxArray& boxes, size_t begin, size_t end, uint64_t* visibility) const noexcept {
+    const auto* cx = boxes.center_x.data();
+    const auto* cy = boxes.center_y.data();
+    const auto* cz = boxes.center_z.data();
+    const auto* ex = boxes.extent_x.data();
+    const auto* ey = boxes.extent_y.data();
+    const auto* ez = boxes.extent_z.data();
+
+    // box is outside if it is behind any plane even with its projected extent:
+    // dot(n, center) + w + dot(abs(n), extent) < 0
+    std::array<glm::vec4, 6> abs_planes {};
+    for (size_t p = 0; p < planes.size(); ++p) {
+        abs_planes[p] = glm::abs(planes[p]);
+    }
+
+    size_t i = begin;
+
+#if defined(LIMITLESS_FRUSTUM_AVX)
+    for (; i + 8 <= end; i += 8) {
+        const auto x = _mm256_loadu_ps(cx + i);
+        const auto y = _mm256_loadu_ps(cy + i);
+        const auto z = _mm256_loadu_ps(cz + i);
+        const auto hx = _mm256_loadu_ps(ex + i);
+        const auto hy = _mm256_loadu_ps(ey + i);
+        const auto hz = _mm256_loadu_ps(ez + i);
+        const auto zero = _mm256_setzero_ps();
+
+        auto inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+        for (size_t p = 0; p < planes.size(); ++p) {
+            const auto distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(planes[p].x)), _mm256_mul_ps(y, _mm256_set1_ps(planes[p].y))),
+                    _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(planes[p].z)), _mm256_set1_ps(planes[p].w)));
+            const auto radius = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(hx, _mm256_set1_ps(abs_planes[p].x)), _mm256_mul_ps(hy, _mm256_set1_ps(abs_planes[p].y))),
+                    _mm256_mul_ps(hz, _mm256_set1_ps(abs_planes[p].z)));
+
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+        }
+
+        visibility[i / 64] |= static_cast<uint64_t>(_mm256_movemask_ps(inside)) << (i % 64);
+    }
+#endif
+
+#if defined(LIMITLESS_FRUSTUM_SSE)
+    for (; i + 4 <= end; i += 4) {
+        const auto x = _mm_loadu_ps(cx + i);
+        const auto y = _mm_loadu_ps(cy + i);
+        const auto z = _mm_loadu_ps(cz + i);
+        const auto hx = _mm_loadu_ps(ex + i);
+        const auto hy = _mm_loadu_ps(ey + i);
+        const auto hz = _mm_loadu_ps(ez + i);
+        const auto zero = _mm_setzero_ps();
+
+        auto inside = _mm_cmpeq_ps(zero, zero);
+        for (size_t p = 0; p < planes.size(); ++p) {
+            const auto distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(planes[p].x)), _mm_mul_ps(y, _mm_set1_ps(planes[p].y))),
+                    _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(planes[p].z)), _mm_set1_ps(planes[p].w)));
+            const auto radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(hx, _mm_set1_ps(abs_planes[p].x)), _mm_mul_ps(hy, _mm_set1_ps(abs_planes[p].y))),
+                    _mm_mul_ps(hz, _mm_set1_ps(abs_planes[p].z)));
+
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        visibility[i / 64] |= static_cast<uint64_t>(_mm_movemask_ps(inside)) << (i % 64);
+    }
+#endif
+
+    for (; i < end; ++i) {
+        bool inside = true;
+        for (size_t p = 0; p < planes.size(); ++p) {
+            const auto distance = planes[p].x * cx[i] + planes[p].y * cy[i] + planes[p].z * cz[i] + planes[p].w;
+            const auto radius = abs_planes[p].x * ex[i] + abs_planes[p].y * ey[i] + abs_planes[p].z * ez[i];
+            inside &= distance + radius >= 0.0f;
+        }
+
+        if (inside) {
+            visibility[i / 64] |= uint64_t{1} << (i % 64);
+        }
+    }
+}
@@ -0,0 +1,169 @@
+#include <limitless/util/frustum_culling.hpp>
+
+#include <limitless/instances/instanced_instance.hpp>
+#include <limitless/instances/skeletal_instanced_instance.hpp>
+#include <limitless/instances/terrain_instance.hpp>
+#include <limitless/util/thread_pool.hpp>
+
+using namespace Limitless;
+
+void FrustumCulling::gather(const Instances& instances) {
+    boxes.clear();
+    ranges.clear();
+
+    for (const auto& instance : instances) {
+        const auto first = static_cast<uint32_t>(boxes.size());
+
+        switch (instance->getInstanceType()) {
+            case InstanceType::Instanced:
+                for (const auto& i : static_cast<InstancedInstance&>(*instance).getInstances()) { //NOLINT
+                    boxes.add(i->getBoundingBox());
+                }
+                break;
+            case InstanceType::SkeletalInstanced:
+                for (const auto& i : static_cast<SkeletalInstancedInstance&>(*instance).getInstances()) { //NOLINT
+                    boxes.add(i->getBoundingBox());
+                }
+                break;
+            case InstanceType::Terrain:
+                for (const auto& [_, mesh_instance] : static_cast<TerrainInstance&>(*instance).getMeshes()) { //NOLINT
+                    boxes.add(mesh_instance.getMesh()->getBoundingBox());
+                }
+                break;
+            default:
+                boxes.add(instance->getBoundingBox());
+                break;
+        }
+
+        ranges.push_back({instance, first, static_cast<uint32_t>(boxes.size()) - first});
+    }
+}
+
+void FrustumCulling::test(const Frustum& frustum) {
+    const auto words = (boxes.size() + 63) / 64;
+
+    visibility.assign(words, 0);
+
+    // jobs get ranges of whole bitset words, so they never write to the same one
+    ThreadPool::getShared().parallelFor(words, BATCH_SIZE / 64, [&] (size_t begin, size_t end) {
+        frustum.intersects(boxes, begin * 64, std::min(end * 64, boxes.size()), visibility.data());
+    });
+}
+
+void FrustumCulling::collect() {
+    visible.clear();
+    visible_instanced_index.clear();
+    visible_skeletal_instanced_index.clear();
+    visible_terrain_index.clear();
+
+    uint32_t instanced_count = 0;
+    uint32_t skeletal_instanced_count = 0;
+    uint32_t terrain_count = 0;
+
+    for (const auto& [instance, first, count] : ranges) {
+        switch (instance->getInstanceType()) {
+            case InstanceType::Instanced: {
+                if (instanced_count == visible_instanced.size()) {
+                    visible_instanced.emplace_back();
+                }
+
+                auto& visible_children = visible_instanced[instanced_count];
+                visible_children.clear();
+
+                const auto& children = static_cast<InstancedInstance&>(*instance).getInstances(); //NOLINT
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (isVisible(first + i)) {
+                        visible_children.emplace_back(children[i]);
+                    }
+                }
+
+                if (!visible_children.empty()) {
+                    visible_instanced_index.emplace(instance->getId(), instanced_count++);
+                    visible.emplace_back(instance);
+                }
+                break;
+            }
+            case InstanceType::SkeletalInstanced: {
+                if (skeletal_instanced_count == visible_skeletal_instanced.size()) {
+                    visible_skeletal_instanced.emplace_back();
+                }
+
+                auto& visible_children = visible_skeletal_instanced[skeletal_instanced_count];
+                visible_children.clear();
+
+                const auto& children = static_cast<SkeletalInstancedInstance&>(*instance).getInstances(); //NOLINT
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (isVisible(first + i)) {
+                        visible_children.emplace_back(children[i]);
+                    }
+                }
+
+                if (!visible_children.empty()) {
+                    visible_skeletal_instanced_index.emplace(instance->getId(), skeletal_instanced_count++);
+                    visible.emplace_back(instance);
+                }
+                break;
+            }
+            case InstanceType::Terrain: {
+                if (terrain_count == visible_terrain.size()) {
+                    visible_terrain.emplace_back();
+                }
+
+                auto& visible_meshes = visible_terrain[terrain_count];
+                visible_meshes.clear();
+
+                uint32_t i = 0;
+                for (auto& [_, mesh_instance] : static_cast<TerrainInstance&>(*instance).getMeshes()) { //NOLINT
+                    if (isVisible(first + i++)) {
+                        visible_meshes.emplace_back(mesh_instance);
+                    }
+                }
+
+                if (!visible_meshes.empty()) {
+                    visible_terrain_index.emplace(instance->getId(), terrain_count++);
+                    visible.emplace_back(instance);
+                }
+                break;
+            }
+            default:
+                if (isVisible(first)) {
+                    visible.emplace_back(instance);
+                }
+                break;
+        }
+    }
+}
+
+void FrustumCulling::update(Scene& scene, const Frustum& frustum) {
+    // compound instances are tested per part, the rest is found by spatial index
+    gather(scene.getCompoundInstances());
+    test(frustum);
+    collect();
+
+    scene.query(frustum, visible);
+}
+
+void FrustumCulling::update(Scene& scene, Camera& camera) {
+    update(scene, Frustum::fromCamera(camera));
+}
+
+const std::vector<std::shared_ptr<ModelInstance>>& FrustumCulling::getVisibleModelInstanced(const InstancedInstance& instance) const noexcept {
+    static const std::vector<std::shared_ptr<ModelInstance>> empty;
+
+    const auto found = visible_instanced_index.find(instance.getId());
+    return found != visible_instanced_index.end() ? visible_instanced[found->second] : empty;
+}
+
+const std::vector<std::shared_ptr<SkeletalInstance>>& FrustumCulling::getVisibleSkeletalInstanced(const SkeletalInstancedInstance& instance) const noexcept {
+    static const std::vector<std::shared_ptr<SkeletalInstance>> empty;
+
+    const auto found = visible_skeletal_instanced_index.find(instance.getId());
+    return found != visible_skeletal_instanced_index.end() ? visible_skeletal_instanced[found->second] : empty;
+}
+
+const std::vector<std::reference_wrapper<MeshInstance>>& FrustumCulling::getVisibleTerrainMeshes(const TerrainInstance& instance) const noexcept {
+    static const std::vector<std::reference_wrapper<MeshInstance>> empty;
+
+    const auto found = visible_terrain_index.find(instance.getId());
+    return found != visible_terrain_index.end() ? visible_terrain[found->second] : empty;
+}
@@ -0,0 +1,147 @@
+#include <limitless/util/mapped_file.hpp>
+#include <utility>
+
+#ifdef WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace Limitless;
+
+#ifdef WIN32
+
+MappedFile::MappedFile(const fs::path& path) {
+    file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = {};
+        throw mapped_file_error {"Failed to open file " + path.string()};
+    }
+
+    LARGE_INTEGER file_size {};
+    if (!GetFileSizeEx(file, &file_size)) {
+        close();
+        throw mapped_file_error {"Failed to get size of file " + path.string()};
+    }
+
+    size = static_cast<size_t>(file_size.QuadPart);
+
+    // empty file cannot be mapped
+    if (size == 0) {
+        return;
+    }
+
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        throw mapped_file_error {"Failed to map file " + path.string()};
+    }
+
+    data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        close();
+        throw mapped_file_error {"Failed to map file " + path.string()};
+    }
+}
+
+void MappedFile::close() noexcept {
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+
+    if (file) {
+        CloseHandle(file);
+    }
+
+    data = {};
+    size = {};
+    mapping = {};
+    file = {};
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : data {std::exchange(rhs.data, {})}
+    , size {std::exchange(rhs.size, {})}
+    , file {std::exchange(rhs.file, {})}
+    , mapping {std::exchange(rhs.mapping, {})} {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        data = std::exchange(rhs.data, {});
+        size = std::exchange(rhs.size, {});
+        file = std::exchange(rhs.file, {});
+        mapping = std::exchange(rhs.mapping, {});
+    }
+    return *this;
+}
+
+#else
+
+MappedFile::MappedFile(const fs::path& path) {
+    const auto descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor == -1) {
+        throw mapped_file_error {"Failed to open file " + path.string()};
+    }
+
+    struct stat status {};
+    if (fstat(descriptor, &status) == -1) {
+        ::close(descriptor);
+        throw mapped_file_error {"Failed to get size of file " + path.string()};
+    }
+
+    size = static_cast<size_t>(status.st_size);
+
+    // empty file cannot be mapped
+    if (size != 0) {
+        auto* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (view == MAP_FAILED) {
+            ::close(descriptor);
+            throw mapped_file_error {"Failed to map file " + path.string()};
+        }
+
+        data = static_cast<const std::byte*>(view);
+    }
+
+    // mapping keeps file referenced
+    ::close(descriptor);
+}
+
+void MappedFile::close() noexcept {
+    if (data) {
+        munmap(const_cast<std::byte*>(data), size); //NOLINT
+    }
+
+    data = {};
+    size = {};
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : data {std::exchange(rhs.data, {})}
+    , size {std::exchange(rhs.size, {})} {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        data = std::exchange(rhs.data, {});
+        size = std::exchange(rhs.size, {});
+    }
+    return *this;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
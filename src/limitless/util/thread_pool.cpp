@@ -27,6 +27,30 @@ ThreadPool::ThreadPool(uint32_t pool_size) {
     }
 }
 
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+
+    {
+        std::unique_lock lock(mutex);
+
+        if (tasks.empty()) {
+            return false;
+        }
+
+        task = std::move(tasks.front());
+        tasks.pop();
+    }
+
+    task();
+
+    return true;
+}
+
+ThreadPool& ThreadPool::getShared() {
+    static ThreadPool pool {std::max(std::thread::hardware_concurrency(), 2u) - 1};
+    return pool;
+}
+
 void ThreadPool::joinAll() {
     {
         std::unique_lock lock(mutex);
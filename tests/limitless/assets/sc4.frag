@@ -0,0 +1,11 @@
+#version 330 core
+
+layout (std140) uniform test_block {
+    vec4 color;
+};
+
+out vec4 result;
+
+void main() {
+    result = color;
+}
@@ -3,6 +3,9 @@
 
 #include <limitless/core/context.hpp>
 #include <limitless/core/shader/shader_compiler.hpp>
+#include <limitless/core/shader/shader_program.hpp>
+#include <limitless/core/buffer/buffer_builder.hpp>
+#include <limitless/core/context_thread_pool.hpp>
 
 using namespace Limitless;
 using namespace LimitlessTest;
@@ -77,3 +80,38 @@ TEST_CASE("Throw on not existing path") {
 
     check_opengl_state();
 }
+
+TEST_CASE("Shader program compiled on worker context binds buffers of current context") {
+    Context context = {"Title", {512, 512}, nullptr, {{WindowHint::Hint::Visible, false}}};
+
+    {
+        RendererSettings settings;
+        ContextThreadPool pool {context, 1};
+
+        auto program = pool.add([&] {
+            ShaderCompiler shader_compiler = ShaderCompiler(context, settings);
+            return shader_compiler.compile("../../tests/limitless/assets/sc4");
+        }).get();
+
+        auto buffer = Buffer::builder()
+                .target(Buffer::Type::Uniform)
+                .usage(Buffer::Usage::DynamicDraw)
+                .access(Buffer::MutableAccess::WriteOrphaning)
+                .size(sizeof(float) * 4)
+                .build("test_block", context);
+
+        program->use();
+
+        GLint bound_point = -1;
+        glGetActiveUniformBlockiv(program->getId(), 0, GL_UNIFORM_BLOCK_BINDING, &bound_point);
+
+        GLint bound_buffer = 0;
+        glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, bound_point, &bound_buffer);
+
+        REQUIRE(static_cast<GLuint>(bound_buffer) == buffer->getId());
+
+        check_opengl_state();
+    }
+
+    check_opengl_state();
+}
@@ -0,0 +1,75 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/fx/particle_pool.hpp>
+
+#include <array>
+
+using namespace Limitless::fx;
+
+namespace {
+    SpriteParticle makeParticle(float value) {
+        SpriteParticle particle {};
+        particle.position = glm::vec3(value);
+        particle.lifetime = value;
+        particle.size = value * 2.0f;
+        return particle;
+    }
+}
+
+TEST_CASE("ParticlePool stores particles as attribute arrays") {
+    ParticlePool<SpriteParticle> pool;
+
+    REQUIRE(pool.empty());
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        pool.push(makeParticle(static_cast<float>(i)));
+    }
+
+    REQUIRE(pool.count() == 4);
+    REQUIRE(pool.position.size() == 4);
+    REQUIRE(pool.size[3] == 6.0f);
+    REQUIRE(pool.get(2).lifetime == 2.0f);
+
+    SECTION("remove moves last particle in place of removed") {
+        pool.remove(1);
+
+        REQUIRE(pool.count() == 3);
+        REQUIRE(pool.lifetime[1] == 3.0f);
+        REQUIRE(pool.position[1] == glm::vec3(3.0f));
+        REQUIRE(pool.size[1] == 6.0f);
+    }
+
+    SECTION("remove last particle") {
+        pool.remove(3);
+
+        REQUIRE(pool.count() == 3);
+        REQUIRE(pool.lifetime[2] == 2.0f);
+    }
+
+    SECTION("gather appends particles") {
+        std::vector<SpriteParticle> particles {makeParticle(10.0f)};
+        pool.gather(particles);
+
+        REQUIRE(particles.size() == 5);
+        REQUIRE(particles[0].lifetime == 10.0f);
+        for (uint32_t i = 0; i < 4; ++i) {
+            REQUIRE(particles[i + 1].lifetime == static_cast<float>(i));
+            REQUIRE(particles[i + 1].size == static_cast<float>(i) * 2.0f);
+        }
+    }
+
+    SECTION("gather writes at most requested count") {
+        std::array<SpriteParticle, 3> particles {};
+
+        REQUIRE(pool.gather(particles.data(), particles.size()) == 3);
+        REQUIRE(particles[2].lifetime == 2.0f);
+        REQUIRE(particles[2].position == glm::vec3(2.0f));
+    }
+
+    SECTION("clear") {
+        pool.clear();
+
+        REQUIRE(pool.empty());
+        REQUIRE(pool.size.empty());
+    }
+}
@@ -0,0 +1,33 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/instances/animation_lod.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("AnimationLod selects level by distance") {
+    const AnimationLod lod {{
+        {50.0f, 4, 2},
+        {10.0f, 2, AnimationLod::ALL_DEPTHS}
+    }};
+
+    REQUIRE(lod.select(5.0f).interval == 1);
+    REQUIRE(lod.select(10.0f).interval == 2);
+    REQUIRE(lod.select(49.0f).max_depth == AnimationLod::ALL_DEPTHS);
+    REQUIRE(lod.select(100.0f).interval == 4);
+    REQUIRE(lod.select(100.0f).max_depth == 2);
+}
+
+TEST_CASE("AnimationLod staggers instances") {
+    const AnimationLod::Level level {0.0f, 4, AnimationLod::ALL_DEPTHS};
+
+    for (uint64_t id = 0; id < 8; ++id) {
+        uint32_t due = 0;
+        for (uint64_t frame = 0; frame < 8; ++frame) {
+            due += AnimationLod::isDue(level, frame, id) ? 1 : 0;
+        }
+        REQUIRE(due == 2);
+    }
+
+    REQUIRE(AnimationLod::isDue(level, 3, 1));
+    REQUIRE_FALSE(AnimationLod::isDue(level, 3, 2));
+}
@@ -0,0 +1,54 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/loaders/asset_manager.hpp>
+#include <limitless/assets.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("AssetManager resolves failed texture to placeholder") {
+    Context context = {"Title", {512, 512}, nullptr, {{WindowHint::Hint::Visible, false}}};
+    Assets assets {"./"};
+    AssetManager manager {context, assets, 1};
+
+    auto handle = manager.loadTexture("not_existing_texture.png");
+
+    REQUIRE(handle.get() == handle.getPlaceholder());
+    REQUIRE(handle.get() != nullptr);
+
+    manager.wait();
+
+    REQUIRE(manager.isDone());
+    REQUIRE(handle.hasFailed());
+    REQUIRE(handle.getError() != nullptr);
+    REQUIRE(handle.get() == handle.getPlaceholder());
+}
+
+TEST_CASE("AssetManager without workers runs jobs in update") {
+    Context context = {"Title", {512, 512}, nullptr, {{WindowHint::Hint::Visible, false}}};
+    Assets assets {"./"};
+    AssetManager manager {context, assets, 0};
+
+    bool built = false;
+    manager.build([&] { built = true; });
+
+    REQUIRE_FALSE(built);
+    REQUIRE(manager.getPendingCount() == 1);
+
+    while (!manager.isDone()) {
+        manager.update();
+    }
+
+    REQUIRE(built);
+}
+
+TEST_CASE("AssetManager rethrows build exception in update") {
+    Context context = {"Title", {512, 512}, nullptr, {{WindowHint::Hint::Visible, false}}};
+    Assets assets {"./"};
+    AssetManager manager {context, assets, 0};
+
+    manager.build([] { throw std::runtime_error {"failed"}; });
+
+    REQUIRE_THROWS_AS(manager.update(std::chrono::microseconds {0}), std::runtime_error);
+    REQUIRE(manager.isDone());
+}
@@ -0,0 +1,74 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/loaders/dds_loader.hpp>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    void write(std::vector<std::byte>& bytes, std::size_t offset, uint32_t value) {
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+    }
+
+    // header of 8x8 texture with 4 levels, fourcc is at pixel format offset
+    std::vector<std::byte> makeHeader(const char* fourcc) {
+        std::vector<std::byte> bytes(4 + 124);
+        std::memcpy(bytes.data(), "DDS ", 4);
+        write(bytes, 4, 124);
+        write(bytes, 12, 8);
+        write(bytes, 16, 8);
+        write(bytes, 28, 4);
+        std::memcpy(bytes.data() + 84, fourcc, 4);
+        return bytes;
+    }
+}
+
+TEST_CASE("DDSLoader parses all stored levels of legacy file") {
+    auto bytes = makeHeader("DXT1");
+    // 8x8, 4x4, 2x2, 1x1 levels with 8 bytes per block
+    bytes.resize(bytes.size() + 32 + 8 + 8 + 8);
+
+    const auto image = DDSLoader::parse(bytes.data(), bytes.size());
+
+    REQUIRE(image.format == Texture::InternalFormat::RGBA_DXT1);
+    REQUIRE(image.size == glm::uvec2 {8, 8});
+    REQUIRE(image.levels.size() == 4);
+    REQUIRE(image.levels[0].data == bytes.data() + 128);
+    REQUIRE(image.levels[0].byte_count == 32);
+    REQUIRE(image.levels[1].data == bytes.data() + 160);
+    REQUIRE(image.levels[3].byte_count == 8);
+}
+
+TEST_CASE("DDSLoader parses DX10 header") {
+    auto bytes = makeHeader("DX10");
+    bytes.resize(bytes.size() + 20);
+    // BC7_UNORM_SRGB, TEXTURE2D, array of one
+    write(bytes, 128, 99);
+    write(bytes, 132, 3);
+    write(bytes, 140, 1);
+    bytes.resize(bytes.size() + 64 + 16 + 16 + 16);
+
+    const auto image = DDSLoader::parse(bytes.data(), bytes.size());
+
+    REQUIRE(image.format == Texture::InternalFormat::sRGBA_BC7);
+    REQUIRE(image.levels.size() == 4);
+    REQUIRE(image.levels[0].data == bytes.data() + 148);
+    REQUIRE(image.levels[0].byte_count == 64);
+}
+
+TEST_CASE("DDSLoader rejects truncated file") {
+    auto bytes = makeHeader("DXT5");
+    bytes.resize(bytes.size() + 64);
+
+    REQUIRE_THROWS_AS(DDSLoader::parse(bytes.data(), bytes.size()), dds_loader_exception);
+    REQUIRE_THROWS_AS(DDSLoader::parse(bytes.data(), 16), dds_loader_exception);
+}
+
+TEST_CASE("DDSLoader rejects more levels than size allows") {
+    auto bytes = makeHeader("DXT1");
+    // 8x8 has 4 levels, fifth 1x1 one is stored anyway
+    write(bytes, 28, 5);
+    bytes.resize(bytes.size() + 32 + 8 + 8 + 8 + 8);
+
+    REQUIRE_THROWS_AS(DDSLoader::parse(bytes.data(), bytes.size()), dds_loader_exception);
+}
@@ -0,0 +1,55 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/loaders/ktx_loader.hpp>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    template<typename T>
+    void write(std::vector<std::byte>& bytes, std::size_t offset, T value) {
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+    }
+
+    // 8x4 BC4 texture with 2 levels, smaller level is stored first as KTX2 requires
+    std::vector<std::byte> makeFile() {
+        constexpr uint8_t identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+        std::vector<std::byte> bytes(80 + 2 * 24 + 8 + 16);
+        std::memcpy(bytes.data(), identifier, sizeof(identifier));
+        write<uint32_t>(bytes, 12, 139);
+        write<uint32_t>(bytes, 20, 8);
+        write<uint32_t>(bytes, 24, 4);
+        write<uint32_t>(bytes, 36, 1);
+        write<uint32_t>(bytes, 40, 2);
+
+        write<uint64_t>(bytes, 80, 136);
+        write<uint64_t>(bytes, 88, 16);
+        write<uint64_t>(bytes, 104, 128);
+        write<uint64_t>(bytes, 112, 8);
+        return bytes;
+    }
+}
+
+TEST_CASE("KTXLoader parses level index") {
+    const auto bytes = makeFile();
+
+    const auto image = KTXLoader::parse(bytes.data(), bytes.size());
+
+    REQUIRE(image.format == Texture::InternalFormat::R_RGTC);
+    REQUIRE(image.size == glm::uvec2 {8, 4});
+    REQUIRE(image.levels.size() == 2);
+    REQUIRE(image.levels[0].data == bytes.data() + 136);
+    REQUIRE(image.levels[0].byte_count == 16);
+    REQUIRE(image.levels[1].data == bytes.data() + 128);
+    REQUIRE(image.levels[1].byte_count == 8);
+}
+
+TEST_CASE("KTXLoader rejects supercompressed and truncated files") {
+    auto bytes = makeFile();
+
+    REQUIRE_THROWS_AS(KTXLoader::parse(bytes.data(), bytes.size() - 8), ktx_loader_exception);
+
+    write<uint32_t>(bytes, 44, 1);
+    REQUIRE_THROWS_AS(KTXLoader::parse(bytes.data(), bytes.size()), ktx_loader_exception);
+}
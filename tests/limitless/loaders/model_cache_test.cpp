@@ -0,0 +1,169 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/skeletal_stream.hpp>
+#include <limitless/loaders/model_cache.hpp>
+#include <limitless/loaders/gltf_model_loader.hpp>
+#include <limitless/models/skeletal_model.hpp>
+#include <limitless/models/mesh.hpp>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace Limitless;
+
+namespace {
+    std::shared_ptr<Mesh> makeMesh(bool skinned) {
+        std::vector<VertexNormalTangent> vertices {
+            {glm::vec3 {0.0f}, glm::vec3 {0.0f, 1.0f, 0.0f}, glm::vec3 {1.0f, 0.0f, 0.0f}, glm::vec2 {0.0f}},
+            {glm::vec3 {1.0f, 0.0f, 0.0f}, glm::vec3 {0.0f, 1.0f, 0.0f}, glm::vec3 {1.0f, 0.0f, 0.0f}, glm::vec2 {1.0f, 0.0f}},
+            {glm::vec3 {0.0f, 0.0f, 2.0f}, glm::vec3 {0.0f, 1.0f, 0.0f}, glm::vec3 {1.0f, 0.0f, 0.0f}, glm::vec2 {0.0f, 1.0f}}
+        };
+        std::vector<uint32_t> indices {0, 1, 2};
+
+        if (skinned) {
+            std::vector<VertexBoneWeight> weights(vertices.size(), VertexBoneWeight {{1, 0, 0, 0}, {1.0f, 0.0f, 0.0f, 0.0f}});
+            return std::make_shared<Mesh>(
+                std::make_unique<SkinnedVertexStream<VertexNormalTangent>>(std::move(vertices), std::move(indices), std::move(weights), VertexStreamUsage::Static, VertexStreamDraw::Triangles),
+                "skinned"
+            );
+        }
+
+        return std::make_shared<Mesh>(
+            std::make_unique<IndexedVertexStream<VertexNormalTangent>>(std::move(vertices), std::move(indices), VertexStreamUsage::Static, VertexStreamDraw::Triangles),
+            "plain"
+        );
+    }
+
+    const ModelCache::MaterialResolver NO_MATERIALS = [] (const std::string&) -> std::shared_ptr<ms::Material> {
+        return nullptr;
+    };
+}
+
+TEST_CASE("ModelCache round trip of plain model") {
+    Context context = {"Title", {512, 512}, nullptr, {{WindowHint::Hint::Visible, false}}};
+
+    const auto path = fs::temp_directory_path() / "plain_model_cache_test.lmodel";
+    const ModelCache::Source source {42, 100, 0};
+
+    const Model model {{makeMesh(false)}, {nullptr}, "plain_model"};
+    ModelCache::save(model, path, source);
+
+    SECTION("loads same data") {
+        auto loaded = ModelCache::load(path, source, NO_MATERIALS);
+        REQUIRE(loaded);
+        REQUIRE(loaded->getName() == "plain_model");
+        REQUIRE(loaded->getMeshes().size() == 1);
+
+        auto& mesh = static_cast<Mesh&>(*loaded->getMeshes()[0]);
+        const auto& stream = dynamic_cast<const IndexedVertexStream<VertexNormalTangent>&>(mesh.getVertexStream());
+        REQUIRE(mesh.getName() == "plain");
+        REQUIRE(stream.getVertices().size() == 3);
+        REQUIRE(stream.getVertices()[2].position == glm::vec3 {0.0f, 0.0f, 2.0f});
+        REQUIRE(stream.getIndices() == std::vector<uint32_t> {0, 1, 2});
+        REQUIRE(mesh.getBoundingBox().size == static_cast<Mesh&>(*model.getMeshes()[0]).getBoundingBox().size);
+    }
+
+    SECTION("stale cache is not loaded") {
+        REQUIRE_FALSE(ModelCache::load(path, {43, 100, 0}, NO_MATERIALS));
+        REQUIRE_FALSE(ModelCache::load(path, {42, 100, 1}, NO_MATERIALS));
+    }
+
+    SECTION("corrupted mesh count is rejected") {
+        // mesh count follows magic, version, type, options, write time and source size
+        {
+            std::fstream file {path, std::ios::binary | std::ios::in | std::ios::out};
+            const auto mesh_count = std::numeric_limits<uint64_t>::max();
+            file.seekp(32);
+            file.write(reinterpret_cast<const char*>(&mesh_count), sizeof(mesh_count));
+        }
+
+        REQUIRE_THROWS_AS(ModelCache::load(path, source, NO_MATERIALS), ModelLoadError);
+    }
+
+    fs::remove(path);
+}
+
+TEST_CASE("ModelCache round trip of skeletal model") {
+    Context context = {"Title", {512, 512}, nullptr, {{WindowHint::Hint::Visible, false}}};
+
+    const auto path = fs::temp_directory_path() / "skeletal_model_cache_test.lmodel";
+    const ModelCache::Source source {42, 100, 0};
+
+    std::vector<Bone> bones {
+        Bone {0, "root", glm::mat4(1.0f), glm::mat4(1.0f)},
+        Bone {1, "arm", glm::mat4(1.0f), glm::mat4(2.0f)}
+    };
+    bones[1].joint_index = 0;
+
+    std::vector<AnimationNode> nodes;
+    nodes.emplace_back(AnimationNode({{glm::vec3(0.0f), 0.0}, {glm::vec3(1.0f), 1.0}}, {}, {}, bones[1]));
+    std::vector<Animation> animations;
+    animations.emplace_back("wave", 1.0, 24.0, std::move(nodes));
+
+    Tree<uint32_t> tree {0};
+    tree.add(1u);
+
+    const SkeletalModel model {
+        {makeMesh(true)},
+        {nullptr},
+        std::move(bones),
+        {{"root", 0}, {"arm", 1}},
+        {tree},
+        std::move(animations),
+        "skeletal_model"
+    };
+    ModelCache::save(model, path, source);
+
+    SECTION("loads same data") {
+        auto loaded = std::dynamic_pointer_cast<SkeletalModel>(ModelCache::load(path, source, NO_MATERIALS));
+        REQUIRE(loaded);
+        REQUIRE(loaded->getBones().size() == 2);
+        REQUIRE(loaded->getBones()[1].joint_index == 0u);
+        REQUIRE(loaded->getBones()[1].offset_matrix == glm::mat4(2.0f));
+        REQUIRE(loaded->getBoneMap().at("arm") == 1);
+        REQUIRE(loaded->getSkeletonTrees().size() == 1);
+        REQUIRE(loaded->getSkeletonTrees()[0] == tree);
+
+        const auto& animation = loaded->getAnimations().at(0);
+        REQUIRE(animation.name == "wave");
+        REQUIRE(animation.tps == 24.0);
+        REQUIRE(animation.findChannel(1) == &animation.nodes[0]);
+        REQUIRE(animation.nodes[0].positions.size() == 2);
+        REQUIRE(&animation.nodes[0].bone == &loaded->getBones()[1]);
+
+        const auto& stream = dynamic_cast<const SkinnedVertexStream<VertexNormalTangent>&>(static_cast<Mesh&>(*loaded->getMeshes()[0]).getVertexStream());
+        REQUIRE(stream.getBoneWeights().size() == 3);
+        REQUIRE(stream.getBoneWeights()[0].bone_index[0] == 1);
+    }
+
+    SECTION("corrupted bone and animation counts are rejected") {
+        std::string bytes;
+        {
+            std::ifstream file {path, std::ios::binary};
+            bytes.assign(std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {});
+        }
+
+        // counts precede length of name of the first record
+        const auto corrupt = [&] (const std::string& first_name) {
+            const auto offset = bytes.find(first_name) - 2 * sizeof(uint64_t);
+
+            std::fstream file {path, std::ios::binary | std::ios::in | std::ios::out};
+            const auto count = std::numeric_limits<uint64_t>::max();
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        };
+
+        SECTION("bones") {
+            corrupt("root");
+        }
+
+        SECTION("animations") {
+            corrupt("wave");
+        }
+
+        REQUIRE_THROWS_AS(ModelCache::load(path, source, NO_MATERIALS), ModelLoadError);
+    }
+
+    fs::remove(path);
+}
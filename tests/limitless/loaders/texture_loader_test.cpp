@@ -0,0 +1,60 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/loaders/texture_loader.hpp>
+#include <future>
+
+using namespace Limitless;
+
+namespace {
+    // 1x2 binary PPM, top pixel is red, bottom one is blue
+    std::vector<uint8_t> makeImage() {
+        const std::string header = "P6 1 2 255\n";
+        std::vector<uint8_t> bytes {header.begin(), header.end()};
+        bytes.insert(bytes.end(), {255, 0, 0, 0, 0, 255});
+        return bytes;
+    }
+}
+
+TEST_CASE("TextureLoader decodes image from memory") {
+    const auto bytes = makeImage();
+
+    const auto image = TextureLoader::decode("image", bytes.data(), bytes.size(), TextureLoaderFlags::Origin::TopLeft);
+
+    REQUIRE(image.data);
+    REQUIRE(image.width == 1);
+    REQUIRE(image.height == 2);
+    REQUIRE(image.channels == 3);
+    REQUIRE(image.data.get()[0] == 255);
+    REQUIRE(image.path.empty());
+}
+
+TEST_CASE("TextureLoader flip setting is per decoding thread") {
+    const auto bytes = makeImage();
+
+    // decoded concurrently with opposite origins
+    auto flipped = std::async(std::launch::async, [&] {
+        return TextureLoader::decode("flipped", bytes.data(), bytes.size(), TextureLoaderFlags::Origin::BottomLeft);
+    });
+    const auto image = TextureLoader::decode("image", bytes.data(), bytes.size(), TextureLoaderFlags::Origin::TopLeft);
+
+    REQUIRE(image.data.get()[0] == 255);
+    REQUIRE(flipped.get().data.get()[2] == 255);
+}
+
+TEST_CASE("TextureLoader throws on invalid image") {
+    const std::vector<uint8_t> bytes {1, 2, 3, 4};
+
+    REQUIRE_THROWS(TextureLoader::decode("broken", bytes.data(), bytes.size()));
+}
+
+TEST_CASE("TextureLoader resizes decoded image") {
+    const auto bytes = makeImage();
+    const auto image = TextureLoader::decode("image", bytes.data(), bytes.size(), TextureLoaderFlags::Origin::TopLeft);
+
+    const auto resized = TextureLoader::resize(image, {1, 1});
+
+    REQUIRE(resized.width == 1);
+    REQUIRE(resized.height == 1);
+    REQUIRE(resized.channels == 3);
+    REQUIRE(resized.data != image.data);
+}
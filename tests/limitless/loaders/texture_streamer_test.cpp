@@ -0,0 +1,94 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/loaders/texture_streamer.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("TextureStreamer selects mip by screen size") {
+    const glm::uvec2 size {1024, 512};
+
+    REQUIRE(TextureStreamer::getRequiredMip(size, 2048.0f) == 0);
+    REQUIRE(TextureStreamer::getRequiredMip(size, 1024.0f) == 0);
+    REQUIRE(TextureStreamer::getRequiredMip(size, 512.0f) == 1);
+    REQUIRE(TextureStreamer::getRequiredMip(size, 300.0f) == 1);
+    REQUIRE(TextureStreamer::getRequiredMip(size, 64.0f) == 4);
+}
+
+TEST_CASE("TextureStreamer clamps tiny screen size to last mip") {
+    REQUIRE(TextureStreamer::getRequiredMip({1024, 1024}, 0.0f) == 10);
+    REQUIRE(TextureStreamer::getRequiredMip({1024, 1024}, -5.0f) == 10);
+}
+
+TEST_CASE("TextureStreamer memory size of storage from mip") {
+    // 4x4, 2x2 and 1x1 levels of 4 bytes per texel
+    REQUIRE(TextureStreamer::getMemorySize(Texture::InternalFormat::RGBA8, {4, 4}, 0) == 84);
+    REQUIRE(TextureStreamer::getMemorySize(Texture::InternalFormat::RGBA8, {4, 4}, 1) == 20);
+
+    // levels smaller than 4x4 still take whole block
+    REQUIRE(TextureStreamer::getMemorySize(Texture::InternalFormat::RGBA_DXT1, {8, 8}, 0) == 32 + 8 + 8 + 8);
+}
+
+TEST_CASE("TextureStreamer selects highest mip that fits available memory") {
+    TextureStreamer::Residency residency;
+    residency.format = Texture::InternalFormat::RGBA8;
+    residency.size = {1024, 1024};
+    residency.tail_mip = 4;
+    residency.resident_mip = 4;
+
+    const auto resident = TextureStreamer::getMemorySize(residency.format, residency.size, 4);
+    const auto growth = TextureStreamer::getMemorySize(residency.format, residency.size, 2) - resident;
+
+    REQUIRE(TextureStreamer::selectMip(residency, 0, growth) == 2);
+    REQUIRE(TextureStreamer::selectMip(residency, 3, growth) == 3);
+    REQUIRE(TextureStreamer::selectMip(residency, 0, growth - 1) == 3);
+    REQUIRE(TextureStreamer::selectMip(residency, 0, 0) == 4);
+}
+
+TEST_CASE("TextureStreamer evicts least recently used textures first") {
+    constexpr uint64_t frame = 6;
+
+    TextureStreamer::Residency residency;
+    residency.format = Texture::InternalFormat::RGBA8;
+    residency.size = {256, 256};
+    residency.tail_mip = 2;
+
+    std::vector<TextureStreamer::Residency> residencies(3, residency);
+    residencies[0].last_used = 5;
+    residencies[1].last_used = 2;
+    residencies[2].last_used = 3;
+
+    const auto full = TextureStreamer::getMemorySize(residency.format, residency.size, 0);
+    const auto top = full - TextureStreamer::getMemorySize(residency.format, residency.size, 1);
+    const auto second = TextureStreamer::getMemorySize(residency.format, residency.size, 1) - TextureStreamer::getMemorySize(residency.format, residency.size, 2);
+    const auto usage = full * 3;
+
+    SECTION("fitting memory evicts nothing") {
+        const auto evictions = TextureStreamer::selectEvictions(residencies, usage, 0, usage, frame);
+        REQUIRE(evictions);
+        REQUIRE(evictions->empty());
+    }
+
+    SECTION("oldest texture is dropped to its tail before next one") {
+        const auto evictions = TextureStreamer::selectEvictions(residencies, usage, top + second + 1, usage, frame);
+        REQUIRE(evictions);
+        REQUIRE(*evictions == std::vector<size_t> {1, 1, 2});
+    }
+
+    SECTION("textures used at current frame are kept") {
+        residencies[1].last_used = frame;
+        residencies[2].last_used = frame;
+
+        const auto evictions = TextureStreamer::selectEvictions(residencies, usage, top, usage, frame);
+        REQUIRE(evictions);
+        REQUIRE(*evictions == std::vector<size_t> {0});
+    }
+
+    SECTION("budget that can not be reached is refused") {
+        REQUIRE_FALSE(TextureStreamer::selectEvictions(residencies, usage, usage, usage, frame));
+
+        residencies[0].resident_mip = 2;
+        residencies[1].resident_mip = 2;
+        residencies[2].resident_mip = 2;
+        REQUIRE_FALSE(TextureStreamer::selectEvictions(residencies, usage, 1, usage, frame));
+    }
+}
@@ -0,0 +1,78 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/models/skeletal_model.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("QuantizedQuat round trip") {
+    const std::vector<glm::fquat> rotations {
+        glm::fquat {1.0f, 0.0f, 0.0f, 0.0f},
+        glm::normalize(glm::fquat {0.1f, 0.9f, -0.3f, 0.2f}),
+        glm::normalize(glm::fquat {-0.5f, 0.2f, 0.7f, -0.4f}),
+        glm::normalize(glm::fquat {0.3f, -0.2f, 0.1f, -0.95f})
+    };
+
+    for (const auto& rotation : rotations) {
+        const auto unpacked = QuantizedQuat::pack(rotation).unpack();
+
+        // q and -q are the same rotation
+        REQUIRE(std::abs(glm::dot(unpacked, rotation)) == Catch::Approx(1.0f).margin(1e-4f));
+    }
+}
+
+TEST_CASE("CompressedAnimation samples tracks") {
+    Bone bone {0, "root", glm::mat4(1.0f)};
+    Bone still {1, "still", glm::mat4(1.0f)};
+
+    std::vector<AnimationNode> nodes;
+    nodes.emplace_back(AnimationNode({{glm::vec3(0.0f), 0.0}, {glm::vec3(2.0f, 4.0f, -2.0f), 2.0}}, {}, {}, bone));
+    nodes.emplace_back(AnimationNode({{glm::vec3(1.0f), 0.0}, {glm::vec3(1.0f), 2.0}}, {}, {}, still));
+
+    Animation animation {"test", 2.0, 1.0, std::move(nodes)};
+    animation.compress(AnimationCompression {});
+
+    REQUIRE(animation.compressed.has_value());
+    REQUIRE(animation.nodes[0].positions.empty());
+
+    const auto& compressed = *animation.compressed;
+
+    SECTION("interpolates between samples") {
+        const auto position = *compressed.position(0, compressed.locate(0.75));
+        REQUIRE(position.x == Catch::Approx(0.75f).margin(1e-3f));
+        REQUIRE(position.y == Catch::Approx(1.5f).margin(1e-3f));
+        REQUIRE(position.z == Catch::Approx(-0.75f).margin(1e-3f));
+    }
+
+    SECTION("clamps time after the end") {
+        REQUIRE(compressed.position(0, compressed.locate(5.0))->y == Catch::Approx(4.0f).margin(1e-3f));
+    }
+
+    SECTION("keeps constant track") {
+        REQUIRE(compressed.position(1, compressed.locate(1.3))->x == Catch::Approx(1.0f).margin(1e-3f));
+    }
+
+    SECTION("absent track") {
+        REQUIRE_FALSE(compressed.rotation(0, compressed.locate(1.0)).has_value());
+    }
+}
+
+TEST_CASE("reduceKeyframes removes linear keyframes") {
+    Bone bone {0, "root", glm::mat4(1.0f)};
+
+    AnimationNode node {{
+        {glm::vec3(0.0f), 0.0},
+        {glm::vec3(1.0f), 1.0},
+        {glm::vec3(2.0f), 2.0},
+        {glm::vec3(5.0f), 3.0},
+        {glm::vec3(8.0f), 4.0}
+    }, {}, {{glm::vec3(1.0f), 0.0}, {glm::vec3(1.0f), 4.0}}, bone};
+
+    reduceKeyframes(node, AnimationCompression {});
+
+    REQUIRE(node.positions.size() == 3);
+    REQUIRE(node.positions[1].time == 2.0);
+    REQUIRE(node.scales.size() == 1);
+
+    KeyframeCursor cursor;
+    REQUIRE(node.positionLerp(3.5, cursor)->x == Catch::Approx(6.5f));
+}
@@ -0,0 +1,60 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/models/skeletal_model.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("Animation maps bones to channels") {
+    std::vector<Bone> bones {
+        Bone {0, "root", glm::mat4(1.0f)},
+        Bone {1, "arm", glm::mat4(1.0f)},
+        Bone {2, "hand", glm::mat4(1.0f)}
+    };
+
+    std::vector<AnimationNode> nodes;
+    nodes.emplace_back(AnimationNode({}, {}, {}, bones[2]));
+    nodes.emplace_back(AnimationNode({}, {}, {}, bones[0]));
+
+    const Animation animation {"test", 1.0, 1.0, std::move(nodes)};
+
+    REQUIRE(animation.findChannel(0) == &animation.nodes[1]);
+    REQUIRE(animation.findChannel(1) == nullptr);
+    REQUIRE(animation.findChannel(2) == &animation.nodes[0]);
+    REQUIRE(animation.findChannel(3) == nullptr);
+}
+
+TEST_CASE("AnimationNode keyframe cursor") {
+    Bone bone {0, "root", glm::mat4(1.0f)};
+
+    std::vector<KeyFrame<glm::vec3>> positions {
+        {glm::vec3(0.0f), 0.0},
+        {glm::vec3(1.0f), 1.0},
+        {glm::vec3(3.0f), 2.0},
+        {glm::vec3(6.0f), 3.0}
+    };
+
+    const AnimationNode node {std::move(positions), {}, {}, bone};
+    KeyframeCursor cursor;
+
+    SECTION("advances with time") {
+        for (double time = 0.0; time <= 3.0; time += 0.25) {
+            REQUIRE(*node.positionLerp(time, cursor) == *node.positionLerp(time));
+        }
+
+        REQUIRE(cursor.position == 2);
+    }
+
+    SECTION("rewinds when time goes back") {
+        REQUIRE(node.positionLerp(2.5, cursor)->x == 4.5f);
+        REQUIRE(node.positionLerp(0.5, cursor)->x == 0.5f);
+        REQUIRE(cursor.position == 0);
+    }
+
+    SECTION("clamps time after the last keyframe") {
+        REQUIRE(node.positionLerp(4.0, cursor)->x == 6.0f);
+    }
+
+    SECTION("node without keyframes is not animated") {
+        REQUIRE_FALSE(node.rotationLerp(1.0, cursor).has_value());
+    }
+}
@@ -0,0 +1,127 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/util/aabb_tree.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+namespace {
+    bool overlaps(const Box& a, const Box& b) {
+        const auto d = glm::abs(a.center - b.center);
+        const auto e = (a.size + b.size) * 0.5f;
+        return d.x <= e.x && d.y <= e.y && d.z <= e.z;
+    }
+
+    Box makeBox(size_t i) {
+        const auto x = static_cast<float>(i % 16) * 3.0f;
+        const auto y = static_cast<float>((i / 16) % 16) * 3.0f;
+        const auto z = static_cast<float>(i / 256) * 3.0f;
+        return {glm::vec3{x, y, z}, glm::vec3{1.0f}};
+    }
+}
+
+TEST_CASE("AABBTree queries match brute force") {
+    AABBTree tree;
+    std::vector<Box> boxes;
+    std::vector<int32_t> proxies;
+
+    constexpr size_t count = 1000;
+    for (size_t i = 0; i < count; ++i) {
+        boxes.emplace_back(makeBox(i));
+        proxies.emplace_back(tree.insert(boxes.back(), i));
+    }
+
+    REQUIRE(tree.size() == count);
+    // balanced tree
+    REQUIRE(tree.getHeight() < 32);
+
+    const auto check = [&] (const Box& query) {
+        std::vector<uint64_t> found;
+        tree.query(query, [&] (uint64_t user) { found.emplace_back(user); });
+        std::sort(found.begin(), found.end());
+
+        std::vector<uint64_t> expected;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if (proxies[i] != AABBTree::NULL_NODE && overlaps(boxes[i], query)) {
+                expected.emplace_back(i);
+            }
+        }
+
+        // tree boxes are enlarged, so they can report neighbours too
+        REQUIRE(std::includes(found.begin(), found.end(), expected.begin(), expected.end()));
+    };
+
+    SECTION("box query") {
+        check({glm::vec3{10.0f, 10.0f, 5.0f}, glm::vec3{8.0f}});
+        check({glm::vec3{-100.0f}, glm::vec3{1.0f}});
+    }
+
+    SECTION("update and remove") {
+        for (size_t i = 0; i < count; i += 3) {
+            boxes[i].center += glm::vec3{0.05f, 0.0f, 0.0f};
+            // small move stays inside enlarged box
+            REQUIRE_FALSE(tree.update(proxies[i], boxes[i]));
+
+            boxes[i].center += glm::vec3{0.0f, 20.0f, 0.0f};
+            REQUIRE(tree.update(proxies[i], boxes[i]));
+        }
+
+        for (size_t i = 1; i < count; i += 5) {
+            tree.remove(proxies[i]);
+            proxies[i] = AABBTree::NULL_NODE;
+        }
+
+        check({glm::vec3{10.0f, 30.0f, 5.0f}, glm::vec3{12.0f}});
+
+        std::vector<uint64_t> all;
+        tree.query(tree.getBounds(), [&] (uint64_t user) { all.emplace_back(user); });
+        REQUIRE(all.size() == tree.size());
+        REQUIRE(std::none_of(all.begin(), all.end(), [] (uint64_t user) { return user % 5 == 1; }));
+    }
+
+    SECTION("sphere query") {
+        const glm::vec3 center {9.0f, 9.0f, 3.0f};
+        std::vector<uint64_t> found;
+        tree.query(center, 2.0f, [&] (uint64_t user) { found.emplace_back(user); });
+
+        REQUIRE(std::find(found.begin(), found.end(), 3 + 3 * 16 + 256) != found.end());
+        REQUIRE(std::find(found.begin(), found.end(), 0) == found.end());
+    }
+
+    SECTION("raycast") {
+        std::vector<std::pair<float, uint64_t>> hits;
+        tree.raycast(glm::vec3{-10.0f, 0.0f, 0.0f}, glm::vec3{1.0f, 0.0f, 0.0f}, 100.0f, [&] (uint64_t user, float distance) {
+            hits.emplace_back(distance, user);
+        });
+        std::sort(hits.begin(), hits.end());
+
+        // row along x axis at y = 0 and z = 0
+        REQUIRE(hits.size() == 16);
+        REQUIRE(hits.front().second == 0);
+        REQUIRE(hits.back().second == 15);
+    }
+}
+
+TEST_CASE("AABBTree raycast along axis with origin on box plane") {
+    AABBTree tree {0.0f};
+    tree.insert({glm::vec3{5.0f, 0.0f, 0.0f}, glm::vec3{2.0f}}, 1);
+
+    const auto count = [&] (const glm::vec3& origin, const glm::vec3& direction) {
+        size_t hits = 0;
+        tree.raycast(origin, direction, 100.0f, [&] (uint64_t, float) { ++hits; });
+        return hits;
+    };
+
+    // origin lies on max and min y planes of box
+    REQUIRE(count({0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}) == 1);
+    REQUIRE(count({0.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}) == 1);
+    REQUIRE(count({0.0f, 1.0f, 1.0f}, {1.0f, 0.0f, 0.0f}) == 1);
+
+    // parallel rays outside slab
+    REQUIRE(count({0.0f, 1.5f, 0.0f}, {1.0f, 0.0f, 0.0f}) == 0);
+    REQUIRE(count({0.0f, 0.0f, -2.0f}, {1.0f, 0.0f, 0.0f}) == 0);
+
+    // box behind origin
+    REQUIRE(count({10.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}) == 0);
+    REQUIRE(count({10.0f, 1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}) == 1);
+}
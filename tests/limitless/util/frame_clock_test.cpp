@@ -0,0 +1,37 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/util/frame_clock.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("FrameClock fixed step") {
+    FrameClock clock {FrameClock::duration {0.25}};
+    const auto start = clock.getTime();
+
+    for (int i = 0; i < 4; ++i) {
+        clock.tick();
+        REQUIRE(clock.getDelta().count() == 0.25);
+    }
+
+    REQUIRE(clock.getFrame() == 4);
+    REQUIRE(std::chrono::duration_cast<FrameClock::duration>(clock.getTime() - start).count() == Catch::Approx(1.0));
+}
+
+TEST_CASE("FrameClock manual step") {
+    FrameClock clock;
+    const auto start = clock.getTime();
+
+    clock.tick(FrameClock::duration {0.5});
+
+    REQUIRE(clock.getDelta().count() == 0.5);
+    REQUIRE(std::chrono::duration_cast<FrameClock::duration>(clock.getTime() - start).count() == Catch::Approx(0.5));
+}
+
+TEST_CASE("FrameClock publishes time") {
+    FrameClock clock {FrameClock::duration {1.0}};
+    clock.tick();
+
+    FrameClock::publish(clock);
+
+    REQUIRE(FrameClock::getPublishedTime() == clock.getTime());
+}
@@ -0,0 +1,48 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/util/frustum.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("Frustum batch test matches box test") {
+    Camera camera {{800, 600}};
+    const auto frustum = Frustum::fromCamera(camera);
+
+    // count is not multiple of SIMD width to check tails
+    constexpr size_t count = 203;
+
+    std::vector<Box> tested;
+    BoxArray boxes;
+    for (size_t i = 0; i < count; ++i) {
+        const auto distance = 1.0f + static_cast<float>(i % 50);
+        // even boxes in front of camera, odd ones behind
+        const auto direction = i % 2 == 0 ? camera.getFront() : -camera.getFront();
+        const Box box {camera.getPosition() + direction * distance, glm::vec3{0.5f}};
+
+        tested.emplace_back(box);
+        boxes.add(box);
+    }
+
+    SECTION("whole range") {
+        std::vector<uint64_t> visibility((count + 63) / 64, 0);
+        frustum.intersects(boxes, 0, count, visibility.data());
+
+        for (size_t i = 0; i < count; ++i) {
+            const bool visible = (visibility[i / 64] >> (i % 64)) & 1u;
+            REQUIRE(visible == frustum.intersects(tested[i]));
+            REQUIRE(visible == (i % 2 == 0));
+        }
+    }
+
+    SECTION("split ranges") {
+        std::vector<uint64_t> visibility((count + 63) / 64, 0);
+        frustum.intersects(boxes, 0, 64, visibility.data());
+        frustum.intersects(boxes, 64, 192, visibility.data());
+        frustum.intersects(boxes, 192, count, visibility.data());
+
+        for (size_t i = 0; i < count; ++i) {
+            const bool visible = (visibility[i / 64] >> (i % 64)) & 1u;
+            REQUIRE(visible == (i % 2 == 0));
+        }
+    }
+}
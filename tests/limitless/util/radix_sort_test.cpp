@@ -0,0 +1,52 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/util/radix_sort.hpp>
+#include <random>
+
+using namespace Limitless;
+
+namespace {
+    struct Value {
+        uint64_t key;
+        uint32_t order;
+    };
+}
+
+TEST_CASE("Radix sort matches stable sort") {
+    std::mt19937_64 random {42};
+
+    const auto check = [&] (size_t count, uint64_t mask) {
+        std::vector<Value> values;
+        for (uint32_t i = 0; i < count; ++i) {
+            values.push_back({random() & mask, i});
+        }
+
+        auto expected = values;
+        std::stable_sort(expected.begin(), expected.end(), [] (const Value& lhs, const Value& rhs) { return lhs.key < rhs.key; });
+
+        std::vector<Value> scratch;
+        radixSort(values, scratch, [] (const Value& value) { return value.key; });
+
+        REQUIRE(values.size() == expected.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            REQUIRE(values[i].key == expected[i].key);
+            REQUIRE(values[i].order == expected[i].order);
+        }
+    };
+
+    SECTION("empty") {
+        check(0, ~uint64_t{0});
+    }
+
+    SECTION("small array") {
+        check(17, ~uint64_t{0});
+    }
+
+    SECTION("full keys") {
+        check(5000, ~uint64_t{0});
+    }
+
+    SECTION("duplicate keys keep order") {
+        check(5000, 0xF0000000000000F0);
+    }
+}